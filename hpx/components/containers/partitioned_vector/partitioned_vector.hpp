@@ -12,12 +12,14 @@
 #include <hpx/config.hpp>
 #include <hpx/lcos/wait_all.hpp>
 #include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/copy_component.hpp>
 #include <hpx/runtime/components/new.hpp>
 #include <hpx/runtime/components/server/distributed_metadata_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/naming/address.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/traits/is_distribution_policy.hpp>
 #include <hpx/util/assert.hpp>
@@ -271,6 +273,7 @@ namespace hpx
 
             std::uint32_t this_locality = get_locality_id();
             std::vector<future<void> > ptrs;
+            std::vector<hpx::id_type> remote_partitions;
 
             typedef typename partitions_vector_type::const_iterator const_iterator;
 
@@ -290,8 +293,18 @@ namespace hpx
                         )
                     );
                 }
+                else
+                {
+                    remote_partitions.push_back(it->partition_);
+                }
             }
+
+            // resolve all remote partitions at once, this fills the AGAS cache
+            future<std::vector<naming::address> > addrs =
+                agas::resolve(remote_partitions);
+
             wait_all(ptrs);
+            addrs.get();
 
             partition_size_ = get_partition_size();
             this->base_type::reset(std::move(id));
@@ -553,6 +566,7 @@ namespace hpx
             // now initialize our data structures
             std::uint32_t this_locality = get_locality_id();
             std::vector<future<void> > ptrs;
+            std::vector<hpx::id_type> remote_partitions;
 
             std::size_t num_part = 0;
             std::size_t allocated_size = 0;
@@ -579,6 +593,10 @@ namespace hpx
                             )
                         );
                     }
+                    else
+                    {
+                        remote_partitions.push_back(id);
+                    }
                     ++l;
 
                     allocated_size += size;
@@ -602,7 +620,12 @@ namespace hpx
                 }
             }
 
+            // resolve all remote partitions at once, this fills the AGAS cache
+            future<std::vector<naming::address> > addrs =
+                agas::resolve(remote_partitions);
+
             wait_all(ptrs);
+            addrs.get();
 
             // cache our partition size
             partition_size_ = get_partition_size();
@@ -394,6 +394,39 @@
 #  define HPX_BUSY_LOOP_COUNT_MAX 2000
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Number of empty thread manager loop executions during which an idle OS
+// thread keeps spinning, and the number of subsequent ones during which it
+// yields its core before it is put to sleep (for at most the given number of
+// microseconds) until new work arrives
+#if !defined(HPX_IDLE_BACKOFF_SPIN_COUNT)
+#  define HPX_IDLE_BACKOFF_SPIN_COUNT 10000
+#endif
+
+#if !defined(HPX_IDLE_BACKOFF_YIELD_COUNT)
+#  define HPX_IDLE_BACKOFF_YIELD_COUNT 1000
+#endif
+
+#if !defined(HPX_IDLE_BACKOFF_TIME_MAX)
+#  define HPX_IDLE_BACKOFF_TIME_MAX 100000
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Resolution of the timer wheel used for timed thread suspension (in
+// microseconds). Timers never expire early, but may expire up to one tick
+// late.
+#if !defined(HPX_TIMER_WHEEL_RESOLUTION)
+#  define HPX_TIMER_WHEEL_RESOLUTION 100
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Capacity of the per-worker ring buffers holding staged tasks (tasks which
+// have not been converted into threads yet). Tasks are put into an unbounded
+// overflow queue if the ring is full.
+#if !defined(HPX_THREAD_QUEUE_STAGED_RING_SIZE)
+#  define HPX_THREAD_QUEUE_STAGED_RING_SIZE 4096
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 // Count number of terminated threads before forcefully cleaning up all of
 // them. Note: terminated threads are cleaned up either when this number is
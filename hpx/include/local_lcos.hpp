@@ -19,6 +19,7 @@
 #include <hpx/lcos/local/no_mutex.hpp>
 #include <hpx/lcos/local/recursive_mutex.hpp>
 #include <hpx/lcos/local/shared_mutex.hpp>
+#include <hpx/lcos/local/shared_spinlock.hpp>
 #include <hpx/lcos/local/sliding_semaphore.hpp>
 
 #include <hpx/lcos/future.hpp>
@@ -951,6 +951,16 @@ namespace detail
             this->do_run();       // always on this thread
         }
 
+        // run synchronously unless the task was started already (for instance
+        // by somebody waiting for it), returns whether the task was run
+        bool try_run()
+        {
+            if (started_test_and_set())
+                return false;
+            this->do_run();       // always on this thread
+            return true;
+        }
+
         // run in a separate thread
         virtual threads::thread_id_type apply(launch policy,
             threads::thread_priority priority,
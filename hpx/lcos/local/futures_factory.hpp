@@ -363,6 +363,18 @@ namespace hpx { namespace lcos { namespace local
             task_->run();
         }
 
+        // synchronous execution, does nothing if the task was started already
+        bool try_run() const
+        {
+            if (!task_) {
+                HPX_THROW_EXCEPTION(task_moved,
+                    "futures_factory<Result()>::try_run",
+                    "futures_factory invalid (has it been moved?)");
+                return false;
+            }
+            return task_->try_run();
+        }
+
         // asynchronous execution
         threads::thread_id_type apply(
             launch policy = launch::async,
@@ -0,0 +1,156 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_LOCAL_SHARED_SPINLOCK_MAR_12_2017_0215PM)
+#define HPX_LCOS_LOCAL_SHARED_SPINLOCK_MAR_12_2017_0215PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/itt_notify.hpp>
+#include <hpx/util/register_locks.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos { namespace local
+{
+    /// A spinlock which is held either by a single writer (lock/unlock) or by
+    /// any number of readers (lock_shared/unlock_shared) at the same time.
+    /// A waiting writer keeps out new readers. Use boost::shared_lock to hold
+    /// it in shared mode.
+    struct shared_spinlock
+    {
+    private:
+        HPX_NON_COPYABLE(shared_spinlock);
+
+        static const std::int32_t writer_bit = 0x40000000;
+
+    public:
+        shared_spinlock()
+          : state_(0)
+        {
+            HPX_ITT_SYNC_CREATE(this, "hpx::lcos::local::shared_spinlock", "");
+        }
+
+        ~shared_spinlock()
+        {
+            HPX_ITT_SYNC_DESTROY(this);
+        }
+
+        void lock()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            // first keep out new readers, then wait for the others
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                std::int32_t s = state_.load(boost::memory_order_relaxed);
+                if (!(s & writer_bit) &&
+                    state_.compare_exchange_weak(s, s | writer_bit,
+                        boost::memory_order_acquire))
+                {
+                    break;
+                }
+                util::detail::yield_k(k,
+                    "hpx::lcos::local::shared_spinlock::lock");
+            }
+            for (std::size_t k = 0;
+                 state_.load(boost::memory_order_acquire) != writer_bit; ++k)
+            {
+                util::detail::yield_k(k,
+                    "hpx::lcos::local::shared_spinlock::lock");
+            }
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+            util::register_lock(this);
+        }
+
+        bool try_lock()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            std::int32_t s = 0;
+            if (state_.compare_exchange_strong(s, writer_bit,
+                    boost::memory_order_acquire))
+            {
+                HPX_ITT_SYNC_ACQUIRED(this);
+                util::register_lock(this);
+                return true;
+            }
+
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        void unlock()
+        {
+            HPX_ITT_SYNC_RELEASING(this);
+
+            state_.store(0, boost::memory_order_release);
+
+            HPX_ITT_SYNC_RELEASED(this);
+            util::unregister_lock(this);
+        }
+
+        void lock_shared()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                std::int32_t s = state_.load(boost::memory_order_relaxed);
+                if (!(s & writer_bit) &&
+                    state_.compare_exchange_weak(s, s + 1,
+                        boost::memory_order_acquire))
+                {
+                    break;
+                }
+                util::detail::yield_k(k,
+                    "hpx::lcos::local::shared_spinlock::lock_shared");
+            }
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+            util::register_lock(this);
+        }
+
+        bool try_lock_shared()
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            std::int32_t s = state_.load(boost::memory_order_relaxed);
+            while (!(s & writer_bit))
+            {
+                if (state_.compare_exchange_weak(s, s + 1,
+                        boost::memory_order_acquire))
+                {
+                    HPX_ITT_SYNC_ACQUIRED(this);
+                    util::register_lock(this);
+                    return true;
+                }
+            }
+
+            HPX_ITT_SYNC_CANCEL(this);
+            return false;
+        }
+
+        void unlock_shared()
+        {
+            HPX_ITT_SYNC_RELEASING(this);
+
+            state_.fetch_sub(1, boost::memory_order_release);
+
+            HPX_ITT_SYNC_RELEASED(this);
+            util::unregister_lock(this);
+        }
+
+    private:
+        boost::atomic<std::int32_t> state_;
+    };
+}}}
+
+#endif
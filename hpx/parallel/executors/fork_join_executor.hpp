@@ -0,0 +1,233 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/fork_join_executor.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_FORK_JOIN_EXECUTOR_FEB_24_2017_1104AM)
+#define HPX_PARALLEL_EXECUTORS_FORK_JOIN_EXECUTOR_FEB_24_2017_1104AM
+
+#include <hpx/config.hpp>
+#include <hpx/apply.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/futures_factory.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/executors/static_chunk_size.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <boost/range/functions.hpp>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    namespace detail
+    {
+        /// \cond NOINTERNAL
+
+        // Runs the given task unless it was started already by a thread
+        // waiting for its future.
+        template <typename Result>
+        struct run_fork_join_task
+        {
+            explicit run_fork_join_task(
+                    lcos::local::futures_factory<Result()> && task)
+              : task_(std::move(task))
+            {}
+
+            void operator()() const
+            {
+                task_.try_run();
+            }
+
+            lcos::local::futures_factory<Result()> task_;
+        };
+
+        // Makes the given tasks available to the worker threads.
+        struct spawn_fork_join_tasks
+        {
+            spawn_fork_join_tasks(
+                    std::vector<util::unique_function_nonser<void()> > && tasks,
+                    util::thread_description const& desc,
+                    threads::thread_priority priority,
+                    threads::thread_stacksize stacksize)
+              : tasks_(std::move(tasks)), desc_(desc),
+                priority_(priority), stacksize_(stacksize)
+            {}
+
+            void operator()()
+            {
+                threads::register_work_nullary_bulk(std::move(tasks_), desc_,
+                    threads::pending, priority_, stacksize_);
+            }
+
+            std::vector<util::unique_function_nonser<void()> > tasks_;
+            util::thread_description desc_;
+            threads::thread_priority priority_;
+            threads::thread_stacksize stacksize_;
+        };
+
+        /// \endcond
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a fork_join_executor creates groups of parallel execution agents
+    /// which execute on the calling thread and in threads implicitly created
+    /// by the executor. The calling thread always executes the first element
+    /// of a group itself.
+    ///
+    /// The futures returned by this executor refer to tasks which have not
+    /// necessarily been started yet. Waiting for such a future (for instance
+    /// from \a hpx::wait_all) executes the task on the waiting thread if no
+    /// worker thread has picked it up so far, i.e. a parent waiting for its
+    /// children runs them inline instead of being suspended. Nested parallel
+    /// algorithms using this executor therefore do not create a suspended
+    /// thread for each of their chunks.
+    struct fork_join_executor : executor_tag
+    {
+        /// The order in which the elements of a group are made available to
+        /// other worker threads.
+        enum spawn_policy
+        {
+            /// Make all elements but the first available to other worker
+            /// threads before the calling thread executes the first element.
+            help_first,
+
+            /// The calling thread executes the first element right away, the
+            /// remaining elements are made available to other worker threads
+            /// by a separate (stealable) task.
+            work_first
+        };
+
+        /// Associate the static_chunk_size executor parameters type as a
+        /// default with this executor.
+        typedef static_chunk_size executor_parameters_type;
+
+        /// Create a new fork-join executor
+        HPX_CONSTEXPR explicit fork_join_executor(
+                spawn_policy policy = help_first,
+                threads::thread_priority priority =
+                    threads::thread_priority_default,
+                threads::thread_stacksize stacksize =
+                    threads::thread_stacksize_default)
+          : policy_(policy), priority_(priority), stacksize_(stacksize)
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        static void apply_execute(F && f, Ts &&... ts)
+        {
+            hpx::apply(std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type
+        >
+        async_execute(F && f, Ts &&... ts) const
+        {
+            typedef typename hpx::util::detail::deferred_result_of<
+                    F(Ts&&...)
+                >::type result_type;
+
+            util::thread_description desc(f,
+                "fork_join_executor::async_execute");
+
+            lcos::local::futures_factory<result_type()> p(
+                util::deferred_call(std::forward<F>(f), std::forward<Ts>(ts)...));
+            hpx::future<result_type> result = p.get_future();
+
+            threads::register_work_nullary(
+                detail::run_fork_join_task<result_type>(std::move(p)),
+                desc, threads::pending, priority_, std::size_t(-1), stacksize_);
+
+            return result;
+        }
+
+        template <typename F, typename S, typename ... Ts>
+        std::vector<hpx::future<
+            typename detail::bulk_async_execute_result<F, S, Ts...>::type
+        > >
+        bulk_async_execute(F && f, S const& shape, Ts &&... ts) const
+        {
+            typedef typename detail::bulk_async_execute_result<F, S, Ts...>::type
+                result_type;
+            typedef lcos::local::futures_factory<result_type()> task_type;
+
+            std::vector<hpx::future<result_type> > results;
+
+// Before Boost V1.56 boost::size() does not respect the iterator category of
+// its argument.
+#if BOOST_VERSION < 105600
+            std::size_t size = std::distance(boost::begin(shape),
+                boost::end(shape));
+#else
+            std::size_t size = boost::size(shape);
+#endif
+            if (size == 0)
+                return results;
+
+            results.reserve(size);
+
+            auto it = boost::begin(shape);
+
+            // the first element is always executed by the calling thread
+            task_type first(util::deferred_call(f, *it, ts...));
+            results.push_back(first.get_future());
+
+            std::vector<util::unique_function_nonser<void()> > tasks;
+            tasks.reserve(size - 1);
+
+            for (++it; results.size() != size; ++it)
+            {
+                task_type p(util::deferred_call(f, *it, ts...));
+                results.push_back(p.get_future());
+                tasks.push_back(
+                    detail::run_fork_join_task<result_type>(std::move(p)));
+            }
+
+            if (!tasks.empty())
+            {
+                util::thread_description desc(f,
+                    "fork_join_executor::bulk_async_execute");
+
+                if (policy_ == help_first)
+                {
+                    threads::register_work_nullary_bulk(std::move(tasks),
+                        desc, threads::pending, priority_, stacksize_);
+                }
+                else
+                {
+                    threads::register_work_nullary(
+                        detail::spawn_fork_join_tasks(
+                            std::move(tasks), desc, priority_, stacksize_),
+                        desc, threads::pending, priority_, std::size_t(-1),
+                        stacksize_);
+                }
+            }
+
+            first.try_run();
+            return results;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        spawn_policy policy_;
+        threads::thread_priority priority_;
+        threads::thread_stacksize stacksize_;
+        /// \endcond
+    };
+}}}
+
+#endif
@@ -12,6 +12,7 @@
 #include <hpx/apply.hpp>
 #include <hpx/async.hpp>
 #include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/futures_factory.hpp>
 #include <hpx/lcos/when_all.hpp>
 #include <hpx/parallel/algorithms/detail/predicates.hpp>
 #include <hpx/parallel/config/inline_namespace.hpp>
@@ -19,9 +20,12 @@
 #include <hpx/parallel/executors/executor_traits.hpp>
 #include <hpx/runtime/launch_policy.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/traits/is_executor.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/deferred_call.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/util/unique_function.hpp>
 
 #include <algorithm>
 #include <cstddef>
@@ -146,11 +150,32 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
             // spawn all tasks sequentially
             HPX_ASSERT(base + size <= results.size());
 
+            if (l_ != launch::async)
+            {
+                for (std::size_t i = 0; i != size; ++i, ++it)
+                {
+                    results[base + i] = hpx::async(l_, func, *it, ts...);
+                }
+                return hpx::make_ready_future();
+            }
+
+            // hand all tasks to the scheduler at once
+            std::vector<util::unique_function_nonser<void()> > tasks;
+            tasks.reserve(size);
+
             for (std::size_t i = 0; i != size; ++i, ++it)
             {
-                results[base + i] = hpx::async(l_, func, *it, ts...);
+                lcos::local::futures_factory<Result()> p(
+                    util::deferred_call(func, *it, ts...));
+                results[base + i] = p.get_future();
+                tasks.push_back(std::move(p));
             }
 
+            threads::register_work_nullary_bulk(std::move(tasks),
+                util::thread_description(func,
+                    "parallel_executor::bulk_async_execute"),
+                threads::pending, l_.priority());
+
             return hpx::make_ready_future();
         }
         /// \endcond
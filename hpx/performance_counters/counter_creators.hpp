@@ -15,6 +15,7 @@
 
 #include <cstdint>
 #include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace performance_counters
@@ -112,6 +113,14 @@ namespace hpx { namespace performance_counters
         counter_info const&, discover_counter_func const&,
         discover_counters_mode, error_code&);
 
+    HPX_API_EXPORT naming::gid_type inlined_action_invocation_counter_creator(
+        counter_info const&, error_code&);
+
+    // Discoverer function for counters of inlined action invocations.
+    HPX_API_EXPORT bool inlined_action_invocation_counter_discoverer(
+        counter_info const&, discover_counter_func const&,
+        discover_counters_mode, error_code&);
+
 #if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
     ///////////////////////////////////////////////////////////////////////////
     // Creation function for per-action parcel data counters
@@ -126,6 +135,14 @@ namespace hpx { namespace performance_counters
     HPX_API_EXPORT bool per_action_data_counter_discoverer(
         counter_info const& info, discover_counter_func const& f,
         discover_counters_mode mode, error_code& ec);
+
+    // Creation function for per-action parcel data histogram counters
+    HPX_API_EXPORT naming::gid_type per_action_histogram_counter_creator(
+        counter_info const& info,
+        hpx::util::function_nonser<
+            std::vector<std::int64_t>(std::string const&, bool)
+        > const& f,
+        error_code& ec);
 #endif
 }}
 
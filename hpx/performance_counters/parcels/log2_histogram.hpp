@@ -0,0 +1,93 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PERFORMANCE_COUNTERS_PARCELS_LOG2_HISTOGRAM_MAR_06_2017_1112AM)
+#define HPX_PERFORMANCE_COUNTERS_PARCELS_LOG2_HISTOGRAM_MAR_06_2017_1112AM
+
+#include <hpx/config.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace performance_counters { namespace parcels
+{
+    /// \brief Collect values (sizes, durations) into buckets of exponentially
+    ///        growing width. Bucket 0 counts all values smaller than 2,
+    ///        bucket N counts the values in [2^N, 2^(N+1)), and the last
+    ///        bucket counts all values which are even larger.
+    ///
+    /// Adding a value is a couple of compares and an increment. This class
+    /// does not protect itself against concurrent access.
+    class log2_histogram
+    {
+    public:
+        static const std::size_t num_buckets = 40;
+
+        log2_histogram()
+        {
+            clear();
+        }
+
+        void add(std::int64_t value)
+        {
+            std::size_t bucket =
+                value > 1 ? log2(static_cast<std::uint64_t>(value)) : 0;
+            if (bucket >= num_buckets)
+                bucket = num_buckets - 1;
+            ++counts_[bucket];
+        }
+
+        void merge(log2_histogram const& rhs)
+        {
+            for (std::size_t i = 0; i != num_buckets; ++i)
+                counts_[i] += rhs.counts_[i];
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i != num_buckets; ++i)
+                counts_[i] = 0;
+        }
+
+        /// Return the collected data using the layout expected for counters
+        /// of type \a counter_histogram: the lower and upper boundaries and
+        /// the number of buckets, followed by the counts. The boundaries are
+        /// given as exponents of 2, i.e. the first three values are 0, the
+        /// number of buckets, and the number of buckets again.
+        std::vector<std::int64_t> get(bool reset)
+        {
+            std::vector<std::int64_t> result;
+            result.reserve(num_buckets + 3);
+
+            result.push_back(0);
+            result.push_back(static_cast<std::int64_t>(num_buckets));
+            result.push_back(static_cast<std::int64_t>(num_buckets));
+            result.insert(result.end(), &counts_[0], &counts_[0] + num_buckets);
+
+            if (reset)
+                clear();
+
+            return result;
+        }
+
+    private:
+        static std::size_t log2(std::uint64_t value)
+        {
+            std::size_t result = 0;
+            if (value >= (std::uint64_t(1) << 32)) { value >>= 32; result += 32; }
+            if (value >= (std::uint64_t(1) << 16)) { value >>= 16; result += 16; }
+            if (value >= (std::uint64_t(1) << 8)) { value >>= 8; result += 8; }
+            if (value >= (std::uint64_t(1) << 4)) { value >>= 4; result += 4; }
+            if (value >= (std::uint64_t(1) << 2)) { value >>= 2; result += 2; }
+            if (value >= (std::uint64_t(1) << 1)) { result += 1; }
+            return result;
+        }
+
+        std::int64_t counts_[num_buckets];
+    };
+}}}
+
+#endif
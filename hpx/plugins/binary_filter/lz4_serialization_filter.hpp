@@ -0,0 +1,78 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTION_LZ4_SERIALIZATION_FILTER_MAR_09_2017_1025AM)
+#define HPX_ACTION_LZ4_SERIALIZATION_FILTER_MAR_09_2017_1025AM
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter_registration.hpp>
+
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+
+#include <hpx/runtime/serialization/binary_filter.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    // The data is compressed block by block while it is being serialized,
+    // each complete block is written to the archive right away. Messages
+    // smaller than a threshold are not compressed at all. Blocks which do
+    // not compress well are stored as they are, and after a couple of those
+    // the remaining blocks of the message are not even tried.
+    struct HPX_LIBRARY_EXPORT lz4_serialization_filter
+      : public serialization::binary_filter
+    {
+        lz4_serialization_filter(bool compress = false,
+                serialization::binary_filter* next_filter = nullptr)
+          : current_(0), compress_(compress), flushed_(false),
+            output_(nullptr), uncompressed_size_(0), compressed_size_(0),
+            poor_blocks_(0), compression_time_(0)
+        {}
+
+        void load(void* dst, std::size_t dst_count);
+        void save(void const* src, std::size_t src_count);
+        bool flush(void* dst, std::size_t dst_count, std::size_t& written);
+        void set_output(serialization::erased_output_container* output);
+
+        void set_max_length(std::size_t size);
+        std::size_t init_data(char const* buffer,
+            std::size_t size, std::size_t buffer_size);
+
+    private:
+        void compress_block(char const* src, std::size_t raw_size,
+            bool try_compression, bool stream);
+
+        // serialization support
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        HPX_FORCEINLINE void serialize(Archive& ar, const unsigned int) {}
+
+        HPX_SERIALIZATION_POLYMORPHIC(lz4_serialization_filter);
+
+        std::vector<char> buffer_;          // current block or decompressed data
+        std::vector<char> compressed_;      // blocks not written to output_
+        std::size_t current_;
+        bool compress_;
+        bool flushed_;
+
+        serialization::erased_output_container* output_;
+        std::size_t uncompressed_size_;
+        std::size_t compressed_size_;
+        std::size_t poor_blocks_;
+        std::int64_t compression_time_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
@@ -25,6 +25,11 @@
 namespace hpx { namespace plugins { namespace parcel
 {
     ///////////////////////////////////////////////////////////////////////////
+    // A coalescing message handler exists for each destination and action,
+    // all of them register their counter functions here. The counters of an
+    // action combine the values of all of its handlers: the counts are
+    // summed up, while all other values are averaged over the handlers which
+    // reported a value.
     class coalescing_counter_registry
     {
         typedef hpx::lcos::local::spinlock mutex_type;
@@ -43,6 +48,7 @@ namespace hpx { namespace plugins { namespace parcel
                     get_counter_values_type&)
             > get_counter_values_creator_type;
 
+        // the counter functions of one message handler
         struct counter_functions
         {
             get_counter_type num_parcels;
@@ -50,11 +56,22 @@ namespace hpx { namespace plugins { namespace parcel
             get_counter_type num_parcels_per_message;
             get_counter_type average_time_between_parcels;
             get_counter_values_creator_type time_between_parcels_histogram_creator;
+            get_counter_type max_parcels_per_message;
+            get_counter_type flush_interval;
+        };
+
+        struct action_counters
+        {
+            action_counters()
+              : min_boundary(0), max_boundary(0), num_buckets(1)
+            {}
+
+            std::vector<counter_functions> handlers;
             std::int64_t min_boundary, max_boundary, num_buckets;
         };
 
         typedef std::unordered_map<
-                std::string, counter_functions, hpx::util::jenkins_hash
+                std::string, action_counters, hpx::util::jenkins_hash
             > map_type;
 
         static coalescing_counter_registry& instance();
@@ -65,7 +82,9 @@ namespace hpx { namespace plugins { namespace parcel
             get_counter_type num_parcels, get_counter_type num_messages,
             get_counter_type time_between_parcels,
             get_counter_type average_time_between_parcels,
-            get_counter_values_creator_type time_between_parcels_histogram_creator);
+            get_counter_values_creator_type time_between_parcels_histogram_creator,
+            get_counter_type max_parcels_per_message,
+            get_counter_type flush_interval);
 
         get_counter_type get_parcels_counter(std::string const& name) const;
         get_counter_type get_messages_counter(std::string const& name) const;
@@ -73,6 +92,10 @@ namespace hpx { namespace plugins { namespace parcel
             std::string const& name) const;
         get_counter_type get_average_time_between_parcels_counter(
             std::string const& name) const;
+        get_counter_type get_max_parcels_per_message_counter(
+            std::string const& name) const;
+        get_counter_type get_flush_interval_counter(
+            std::string const& name) const;
         get_counter_values_type get_time_between_parcels_histogram_counter(
             std::string const& name, std::int64_t min_boundary,
             std::int64_t max_boundary, std::int64_t num_buckets);
@@ -90,6 +113,22 @@ namespace hpx { namespace plugins { namespace parcel
         }
 
     private:
+        typedef get_counter_type counter_functions::* counter_member;
+
+        get_counter_type get_counter(std::string const& name,
+            counter_member counter, bool sum, char const* func) const;
+
+        std::vector<counter_functions> get_handlers(
+            std::string const& name) const;
+
+        std::int64_t get_combined_value(std::string const& name,
+            counter_member counter, bool sum, bool reset) const;
+
+        std::vector<std::int64_t> get_time_between_parcels_histogram(
+            std::string const& name, std::int64_t min_boundary,
+            std::int64_t max_boundary, std::int64_t num_buckets,
+            bool reset) const;
+
         struct tag {};
 
         friend struct hpx::util::static_<
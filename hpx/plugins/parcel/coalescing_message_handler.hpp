@@ -66,6 +66,8 @@ namespace hpx { namespace plugins { namespace parcel
             std::int64_t min_boundary, std::int64_t max_boundary,
             std::int64_t num_buckets,
             util::function_nonser<std::vector<std::int64_t>(bool)>& result);
+        std::int64_t get_max_parcels_per_message(bool reset);
+        std::int64_t get_flush_interval(bool reset);
 
         // register the given action
         static void register_action(char const* action, error_code& ec);
@@ -79,6 +81,8 @@ namespace hpx { namespace plugins { namespace parcel
         void update_num_messages();
         void update_interval();
 
+        void adapt_locked(std::int64_t time_since_last_parcel);
+
     private:
         mutable mutex_type mtx_;
         parcelset::parcelport* pp_;
@@ -90,6 +94,16 @@ namespace hpx { namespace plugins { namespace parcel
         bool allow_background_flush_;
         std::string action_name_;
 
+        // adaptive coalescing: the number of parcels per message and the
+        // flush interval are derived from the time between parcels and are
+        // kept within the given bounds
+        bool adaptive_;
+        std::size_t min_num_coalesced_parcels_;
+        std::size_t max_num_coalesced_parcels_;
+        std::size_t min_interval_;
+        std::size_t max_interval_;
+        std::int64_t estimated_time_between_parcels_;
+
         // performance counter data
         std::int64_t num_parcels_;
         std::int64_t reset_num_parcels_;
@@ -0,0 +1,99 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_LOCALITY_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/string.hpp>
+
+#include <boost/io/ios_state.hpp>
+
+#include <cstdint>
+#include <string>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        // A shared memory endpoint is identified by the node it lives on and
+        // the id of the process owning the inbound segment.
+        class locality
+        {
+        public:
+            locality()
+              : pid_(-1)
+            {}
+
+            locality(std::string const& node, std::int32_t pid)
+              : node_(node), pid_(pid)
+            {}
+
+            std::string const& node() const
+            {
+                return node_;
+            }
+
+            std::int32_t pid() const
+            {
+                return pid_;
+            }
+
+            static const char *type()
+            {
+                return "shmem";
+            }
+
+            explicit operator bool() const HPX_NOEXCEPT
+            {
+                return pid_ != -1;
+            }
+
+            void save(serialization::output_archive & ar) const
+            {
+                ar << node_;
+                ar << pid_;
+            }
+
+            void load(serialization::input_archive & ar)
+            {
+                ar >> node_;
+                ar >> pid_;
+            }
+
+        private:
+            friend bool operator==(locality const & lhs, locality const & rhs)
+            {
+                return lhs.pid_ == rhs.pid_ && lhs.node_ == rhs.node_;
+            }
+
+            friend bool operator<(locality const & lhs, locality const & rhs)
+            {
+                return lhs.node_ < rhs.node_ ||
+                    (lhs.node_ == rhs.node_ && lhs.pid_ < rhs.pid_);
+            }
+
+            friend std::ostream & operator<<(std::ostream & os, locality const & loc)
+            {
+                boost::io::ios_flags_saver ifs(os);
+                os << loc.node_ << ":" << loc.pid_;
+
+                return os;
+            }
+
+            std::string node_;
+            std::int32_t pid_;
+        };
+    }}
+}}
+
+#endif
+
+#endif
@@ -0,0 +1,271 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_RECEIVER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/decode_parcels.hpp>
+#include <hpx/runtime/parcelset/parcel_buffer.hpp>
+#include <hpx/runtime/parcelset/receive_chunk.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/integer/endian.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Reassembles the messages arriving on one of the inbound channels.
+    template <typename Parcelport>
+    struct receiver_connection
+    {
+    private:
+        enum connection_state
+        {
+            initialized
+          , rcvd_header
+          , rcvd_transmission_chunks
+          , rcvd_data
+        };
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        typedef std::vector<char>
+            data_type;
+        typedef parcel_buffer<data_type, receive_chunk> buffer_type;
+
+        HPX_STATIC_CONSTEXPR std::size_t header_size =
+            sizeof(util::integer::ulittle64_t) * 2 +
+            sizeof(buffer_type::count_chunks_type);
+
+    public:
+        receiver_connection(channel c, Parcelport & pp)
+          : state_(initialized)
+          , channel_(c)
+          , offset_(0)
+          , chunks_idx_(0)
+          , pp_(pp)
+        {
+        }
+
+        // Consume all data available on this channel, returns whether any
+        // data was received.
+        bool receive(std::size_t num_thread = -1)
+        {
+            std::unique_lock<mutex_type> l(mtx_, std::try_to_lock);
+            if (!l || (state_ == initialized && channel_.empty()))
+                return false;
+
+            bool progress = false;
+            for (;;)
+            {
+                switch (state_)
+                {
+                case initialized:
+                    if (!fill(header_, header_size, progress))
+                        return progress;
+                    receive_header();
+                    break;
+
+                case rcvd_header:
+                    if (!fill(buffer_.transmission_chunks_.data(),
+                            buffer_.transmission_chunks_.size() *
+                                sizeof(buffer_type::transmission_chunk_type),
+                            progress))
+                    {
+                        return progress;
+                    }
+                    state_ = rcvd_transmission_chunks;
+                    break;
+
+                case rcvd_transmission_chunks:
+                    if (!fill(buffer_.data_.data(), buffer_.data_.size(),
+                            progress))
+                    {
+                        return progress;
+                    }
+                    receive_data();
+                    break;
+
+                case rcvd_data:
+                    while (chunks_idx_ != buffer_.chunks_.size())
+                    {
+                        receive_chunk& c = buffer_.chunks_[chunks_idx_];
+                        if (!fill(c.data(), c.size(), progress))
+                            return progress;
+                        ++chunks_idx_;
+                    }
+                    done(num_thread);
+                    break;
+
+                default:
+                    HPX_ASSERT(false);
+                    return progress;
+                }
+            }
+        }
+
+    private:
+        // Read from the channel into the given buffer, returns true if the
+        // buffer was filled completely.
+        bool fill(void* data, std::size_t size, bool& progress)
+        {
+            std::size_t count = channel_.read(
+                static_cast<char*>(data) + offset_, size - offset_);
+            if (count != 0)
+                progress = true;
+
+            offset_ += count;
+            if (offset_ != size)
+                return false;
+
+            offset_ = 0;
+            return true;
+        }
+
+        void receive_header()
+        {
+            // the header fields are sent as little endian integers
+            char const* p = header_;
+            buffer_.size_ =
+                util::detail::load_little_endian<std::uint64_t, 8>(p);
+            p += sizeof(std::uint64_t);
+            buffer_.data_size_ =
+                util::detail::load_little_endian<std::uint64_t, 8>(p);
+            p += sizeof(std::uint64_t);
+            buffer_.num_chunks_.first =
+                util::detail::load_little_endian<std::uint32_t, 4>(p);
+            p += sizeof(std::uint32_t);
+            buffer_.num_chunks_.second =
+                util::detail::load_little_endian<std::uint32_t, 4>(p);
+
+            // Store the time of the begin of the read operation
+            performance_counters::parcels::data_point& data =
+                buffer_.data_point_;
+            data.time_ = timer_.elapsed_nanoseconds();
+            data.serialization_time_ = 0;
+            data.bytes_ = static_cast<std::size_t>(buffer_.size_);
+            data.num_parcels_ = 0;
+
+            // determine the size of the chunk buffer
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+            std::size_t num_non_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.second));
+
+            if (num_zero_copy_chunks != 0)
+            {
+                buffer_.transmission_chunks_.resize(
+                    num_zero_copy_chunks + num_non_zero_copy_chunks);
+            }
+            buffer_.data_.resize(static_cast<std::size_t>(buffer_.size_));
+
+            state_ = rcvd_header;
+        }
+
+        void receive_data()
+        {
+            // add appropriately sized chunk buffers for the zero-copy data
+            std::size_t num_zero_copy_chunks =
+                static_cast<std::size_t>(
+                    static_cast<std::uint32_t>(buffer_.num_chunks_.first));
+
+            buffer_.chunks_.resize(num_zero_copy_chunks);
+            for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
+            {
+                buffer_.chunks_[i].resize(static_cast<std::size_t>(
+                    buffer_.transmission_chunks_[i].second));
+            }
+            chunks_idx_ = 0;
+
+            state_ = rcvd_data;
+        }
+
+        void done(std::size_t num_thread)
+        {
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+
+            decode_parcels(pp_, std::move(buffer_), num_thread);
+
+            buffer_ = buffer_type();
+            state_ = initialized;
+        }
+
+        mutex_type mtx_;
+        connection_state state_;
+
+        channel channel_;
+        char header_[header_size];
+        std::size_t offset_;
+        std::size_t chunks_idx_;
+
+        buffer_type buffer_;
+        util::high_resolution_timer timer_;
+
+        Parcelport & pp_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename Parcelport>
+    struct receiver
+    {
+        typedef
+            receiver_connection<Parcelport>
+            connection_type;
+        typedef std::unique_ptr<connection_type> connection_ptr;
+
+        receiver(Parcelport & pp)
+          : pp_(pp)
+        {}
+
+        // Create the inbound segment of this locality
+        void run(std::int32_t self, std::size_t num_channels,
+            std::size_t channel_size)
+        {
+            segment_.reset(new segment(self, num_channels, channel_size));
+
+            connections_.reserve(num_channels);
+            for (std::size_t i = 0; i != num_channels; ++i)
+            {
+                connections_.push_back(connection_ptr(
+                    new connection_type(segment_->get_channel(i), pp_)));
+            }
+        }
+
+        bool background_work(std::size_t num_thread)
+        {
+            bool has_work = false;
+            for (connection_ptr const& c : connections_)
+            {
+                has_work = c->receive(num_thread) || has_work;
+            }
+            return has_work;
+        }
+
+    private:
+        Parcelport & pp_;
+
+        std::unique_ptr<segment> segment_;
+        std::vector<connection_ptr> connections_;
+    };
+}}}}
+
+#endif
+
+#endif
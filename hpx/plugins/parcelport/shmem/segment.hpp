@@ -0,0 +1,189 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SEGMENT_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Every locality owns one shared memory segment holding its inbound
+    // channels. Each of the other localities on the same node claims one of
+    // those channels when it first sends to this locality, which makes every
+    // channel a single-producer/single-consumer byte ring.
+    struct channel_header
+    {
+        // id of the process writing to this channel, zero if unclaimed
+        boost::atomic<std::int32_t> owner_;
+        char padding0_[BOOST_LOCKFREE_CACHELINE_BYTES -
+            sizeof(boost::atomic<std::int32_t>)];
+
+        // number of bytes written to this channel so far
+        boost::atomic<std::uint64_t> head_;
+        char padding1_[BOOST_LOCKFREE_CACHELINE_BYTES -
+            sizeof(boost::atomic<std::uint64_t>)];
+
+        // number of bytes read from this channel so far
+        boost::atomic<std::uint64_t> tail_;
+        char padding2_[BOOST_LOCKFREE_CACHELINE_BYTES -
+            sizeof(boost::atomic<std::uint64_t>)];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A view of one of the channels of a mapped segment.
+    class channel
+    {
+    public:
+        channel()
+          : header_(nullptr), data_(nullptr), size_(0)
+        {}
+
+        channel(channel_header* header, char* data, std::size_t size)
+          : header_(header), data_(data), size_(size)
+        {}
+
+        explicit operator bool() const HPX_NOEXCEPT
+        {
+            return header_ != nullptr;
+        }
+
+        std::int32_t owner() const
+        {
+            return header_->owner_.load(boost::memory_order_acquire);
+        }
+
+        bool claim(std::int32_t owner)
+        {
+            std::int32_t expected = 0;
+            return header_->owner_.compare_exchange_strong(expected, owner);
+        }
+
+        void release()
+        {
+            header_->owner_.store(0, boost::memory_order_release);
+        }
+
+        // Copy as many bytes as fit into the channel, returns the number of
+        // bytes written. Must be called by the owner of the channel only.
+        std::size_t write(void const* data, std::size_t size)
+        {
+            std::uint64_t head = header_->head_.load(boost::memory_order_relaxed);
+            std::uint64_t tail = header_->tail_.load(boost::memory_order_acquire);
+
+            std::size_t count = (std::min)(size,
+                size_ - static_cast<std::size_t>(head - tail));
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = static_cast<std::size_t>(head % size_);
+            std::size_t first = (std::min)(count, size_ - pos);
+
+            char const* src = static_cast<char const*>(data);
+            std::memcpy(data_ + pos, src, first);
+            if (first != count)
+                std::memcpy(data_, src + first, count - first);
+
+            header_->head_.store(head + count, boost::memory_order_release);
+            return count;
+        }
+
+        // Copy as many bytes as are available (up to size) out of the
+        // channel, returns the number of bytes read. Must be called by the
+        // owner of the segment only.
+        std::size_t read(void* data, std::size_t size)
+        {
+            std::uint64_t tail = header_->tail_.load(boost::memory_order_relaxed);
+            std::uint64_t head = header_->head_.load(boost::memory_order_acquire);
+
+            std::size_t count = (std::min)(size,
+                static_cast<std::size_t>(head - tail));
+            if (count == 0)
+                return 0;
+
+            std::size_t pos = static_cast<std::size_t>(tail % size_);
+            std::size_t first = (std::min)(count, size_ - pos);
+
+            char* dest = static_cast<char*>(data);
+            std::memcpy(dest, data_ + pos, first);
+            if (first != count)
+                std::memcpy(dest + first, data_, count - first);
+
+            header_->tail_.store(tail + count, boost::memory_order_release);
+            return count;
+        }
+
+        bool empty() const
+        {
+            return header_->head_.load(boost::memory_order_acquire) ==
+                header_->tail_.load(boost::memory_order_relaxed);
+        }
+
+    private:
+        channel_header* header_;
+        char* data_;
+        std::size_t size_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A POSIX shared memory segment holding a set of channels.
+    class HPX_EXPORT segment
+    {
+    private:
+        HPX_NON_COPYABLE(segment);
+
+    public:
+        // Create the inbound segment of the locality with the given pid,
+        // this removes any stale segment left behind by a process which
+        // happened to have the same id.
+        segment(std::int32_t pid, std::size_t num_channels,
+            std::size_t channel_size);
+
+        // Map the existing inbound segment of the locality with the given
+        // pid.
+        explicit segment(std::int32_t pid);
+
+        ~segment();
+
+        std::size_t num_channels() const;
+
+        channel get_channel(std::size_t i) const;
+
+        // Claim a free channel of this segment for the calling process.
+        channel claim_channel(std::int32_t owner) const;
+
+        static std::string name(std::int32_t pid);
+
+    private:
+        void map(int fd, std::size_t size);
+        std::size_t channel_stride() const;
+
+        std::string name_;
+        void* base_;
+        std::size_t size_;
+        bool owner_;
+    };
+
+    // Return a string uniquely identifying the node this process runs on.
+    HPX_EXPORT std::string node_name();
+}}}}
+
+#endif
+
+#endif
@@ -0,0 +1,127 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/sender_connection.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    struct sender
+    {
+        typedef
+            sender_connection
+            connection_type;
+        typedef std::shared_ptr<connection_type> connection_ptr;
+        typedef std::deque<connection_ptr> connection_list;
+
+        typedef std::map<std::int32_t, std::shared_ptr<outbound_channel> >
+            channel_map;
+
+        typedef hpx::lcos::local::spinlock mutex_type;
+
+        explicit sender(std::int32_t self)
+          : self_(self)
+        {
+        }
+
+        connection_ptr create_connection(locality const& dest,
+            parcelset::parcelport* pp)
+        {
+            return std::make_shared<connection_type>(
+                this, get_channel(dest.pid()), dest, pp);
+        }
+
+        void add(connection_ptr const & ptr)
+        {
+            std::unique_lock<mutex_type> l(connections_mtx_);
+            connections_.push_back(ptr);
+        }
+
+        void send_messages(
+            connection_ptr connection
+        )
+        {
+            // Check if sending has been completed....
+            if (connection->send())
+            {
+                connection->postprocess();
+            }
+            else
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_);
+                connections_.push_back(std::move(connection));
+            }
+        }
+
+        bool background_work()
+        {
+            connection_ptr connection;
+            {
+                std::unique_lock<mutex_type> l(connections_mtx_, std::try_to_lock);
+                if(l && !connections_.empty())
+                {
+                    connection = std::move(connections_.front());
+                    connections_.pop_front();
+                }
+            }
+            if(connection)
+            {
+                send_messages(std::move(connection));
+                return true;
+            }
+            return false;
+        }
+
+        // give the claimed channels back to their segments
+        void clear()
+        {
+            std::unique_lock<mutex_type> l(channels_mtx_);
+            channels_.clear();
+        }
+
+    private:
+        std::shared_ptr<outbound_channel> get_channel(std::int32_t dest)
+        {
+            std::unique_lock<mutex_type> l(channels_mtx_);
+
+            channel_map::iterator it = channels_.find(dest);
+            if (it == channels_.end())
+            {
+                // map the segment of the destination and claim a channel
+                it = channels_.insert(channel_map::value_type(dest,
+                    std::make_shared<outbound_channel>(dest, self_))).first;
+            }
+            return it->second;
+        }
+
+        std::int32_t self_;
+
+        mutex_type connections_mtx_;
+        connection_list connections_;
+
+        mutex_type channels_mtx_;
+        channel_map channels_;
+    };
+}}}}
+
+#endif
+
+#endif
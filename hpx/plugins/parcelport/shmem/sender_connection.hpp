@@ -0,0 +1,288 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+#define HPX_PARCELSET_POLICIES_SHMEM_SENDER_CONNECTION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/error_code.hpp>
+#include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/runtime/parcelset/parcelport.hpp>
+#include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset_fwd.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The channel this locality has claimed in the inbound segment of another
+    // locality on the same node. All connections to that locality share the
+    // channel, a connection holds on to it until it has written its message
+    // completely to prevent messages from being interleaved.
+    class outbound_channel
+    {
+    private:
+        HPX_NON_COPYABLE(outbound_channel);
+
+    public:
+        outbound_channel(std::int32_t dest, std::int32_t self)
+          : segment_(dest), channel_(segment_.claim_channel(self)), busy_(false)
+        {
+            if (!channel_)
+            {
+                HPX_THROW_EXCEPTION(network_error,
+                    "shmem::outbound_channel::outbound_channel",
+                    "no free channel left in the shared memory segment of "
+                    "the destination");
+            }
+        }
+
+        ~outbound_channel()
+        {
+            channel_.release();
+        }
+
+        bool try_lock()
+        {
+            return !busy_.exchange(true, boost::memory_order_acquire);
+        }
+
+        void unlock()
+        {
+            busy_.store(false, boost::memory_order_release);
+        }
+
+        std::size_t write(void const* data, std::size_t size)
+        {
+            return channel_.write(data, size);
+        }
+
+    private:
+        segment segment_;
+        channel channel_;
+        boost::atomic<bool> busy_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct sender;
+    struct sender_connection;
+
+    void add_connection(sender *, std::shared_ptr<sender_connection> const&);
+
+    struct sender_connection
+      : parcelset::parcelport_connection<
+            sender_connection
+          , std::vector<char>
+        >
+    {
+    private:
+        typedef sender sender_type;
+
+        typedef std::vector<char> data_type;
+
+        typedef
+            parcelset::parcelport_connection<sender_connection, data_type>
+            base_type;
+
+        // a contiguous part of the message
+        struct piece
+        {
+            char const* data_;
+            std::size_t size_;
+        };
+
+    public:
+        sender_connection(
+            sender_type * s
+          , std::shared_ptr<outbound_channel> const& c
+          , locality const& there
+          , parcelset::parcelport* pp
+        )
+          : sender_(s)
+          , channel_(c)
+          , locked_(false)
+          , piece_idx_(0)
+          , offset_(0)
+          , pp_(pp)
+          , there_(parcelset::locality(there))
+        {
+        }
+
+        parcelset::locality const& destination() const
+        {
+            return there_;
+        }
+
+        void verify(parcelset::locality const & parcel_locality_id) const
+        {
+        }
+
+        template <typename Handler, typename ParcelPostprocess>
+        void async_write(Handler && handler, ParcelPostprocess && parcel_postprocess)
+        {
+            HPX_ASSERT(!buffer_.data_.empty());
+            HPX_ASSERT(!locked_);
+
+            handler_ = std::forward<Handler>(handler);
+            postprocess_handler_ =
+                std::forward<ParcelPostprocess>(parcel_postprocess);
+
+            /// Increment sends and begin timer.
+            buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
+
+            // The message is laid out exactly like the one sent by the TCP
+            // parcelport: header, transmission chunks, serialized data, and
+            // the zero-copy chunks. The latter are copied directly from the
+            // user's memory into the channel.
+            pieces_.clear();
+            piece_idx_ = 0;
+            offset_ = 0;
+
+            add_piece(&buffer_.size_, sizeof(buffer_.size_));
+            add_piece(&buffer_.data_size_, sizeof(buffer_.data_size_));
+            add_piece(&buffer_.num_chunks_, sizeof(buffer_.num_chunks_));
+
+            std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
+                buffer_.transmission_chunks_;
+            if (!chunks.empty())
+            {
+                add_piece(chunks.data(), chunks.size() *
+                    sizeof(parcel_buffer_type::transmission_chunk_type));
+                add_piece(buffer_.data_.data(), buffer_.data_.size());
+
+                for (serialization::serialization_chunk& c : buffer_.chunks_)
+                {
+                    if (c.type_ == serialization::chunk_type_pointer)
+                        add_piece(c.data_.cpos_, c.size_);
+                }
+            }
+            else
+            {
+                add_piece(buffer_.data_.data(), buffer_.data_.size());
+            }
+
+            if (!send())
+            {
+                // the channel is busy or full, continue in the background
+                add_connection(sender_, shared_from_this());
+            }
+            else
+            {
+                postprocess();
+            }
+        }
+
+        // Write as much of the message as possible, returns true if the
+        // message has been written completely.
+        bool send()
+        {
+            if (!locked_)
+            {
+                if (!channel_->try_lock())
+                    return false;
+                locked_ = true;
+            }
+
+            while (piece_idx_ != pieces_.size())
+            {
+                piece const& p = pieces_[piece_idx_];
+                offset_ += channel_->write(p.data_ + offset_, p.size_ - offset_);
+                if (offset_ != p.size_)
+                    return false;
+
+                ++piece_idx_;
+                offset_ = 0;
+            }
+
+            channel_->unlock();
+            locked_ = false;
+
+            return done();
+        }
+
+        void postprocess()
+        {
+            // the post-processing handler might reuse this connection right
+            // away
+            util::unique_function_nonser<
+                void(
+                    boost::system::error_code const&
+                  , parcelset::locality const&
+                  , std::shared_ptr<sender_connection>
+                )
+            > f = std::move(postprocess_handler_);
+
+            error_code ec;
+            f(ec, there_, shared_from_this());
+        }
+
+    private:
+        void add_piece(void const* data, std::size_t size)
+        {
+            piece p = { static_cast<char const*>(data), size };
+            pieces_.push_back(p);
+        }
+
+        bool done()
+        {
+            error_code ec;
+            handler_(ec);
+
+            buffer_.data_point_.time_ =
+                timer_.elapsed_nanoseconds() - buffer_.data_point_.time_;
+            pp_->add_sent_data(buffer_.data_point_);
+            buffer_.clear();
+
+            return true;
+        }
+
+        sender_type * sender_;
+        std::shared_ptr<outbound_channel> channel_;
+        bool locked_;
+
+        std::vector<piece> pieces_;
+        std::size_t piece_idx_;
+        std::size_t offset_;
+
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+            )
+        > handler_;
+        util::unique_function_nonser<
+            void(
+                boost::system::error_code const&
+              , parcelset::locality const&
+              , std::shared_ptr<sender_connection>
+            )
+        > postprocess_handler_;
+
+        util::high_resolution_timer timer_;
+        parcelset::parcelport* pp_;
+
+        parcelset::locality there_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -16,6 +16,7 @@
 #include <hpx/config/asio.hpp>
 
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/network_emulation.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport_impl.hpp>
 #include <hpx/util_fwd.hpp>
@@ -48,6 +49,7 @@ namespace hpx { namespace parcelset
         typedef std::true_type  send_early_parcel;
         typedef std::false_type do_background_work;
         typedef std::false_type send_immediate_parcels;
+        typedef std::true_type  send_pending_on_connection;
 
         static const char * type()
         {
@@ -124,6 +126,9 @@ namespace hpx { namespace parcelset
             typedef std::set<std::shared_ptr<receiver> > accepted_connections_set;
             accepted_connections_set accepted_connections_;
 
+            /// Emulated network characteristics for outgoing messages
+            network_emulation emulation_;
+
 #if defined(HPX_HOLDON_TO_OUTGOING_CONNECTIONS)
             typedef std::set<boost::weak_ptr<sender> > write_connections_set;
             write_connections_set write_connections_;
@@ -0,0 +1,79 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_POLICIES_TCP_NETWORK_EMULATION_HPP
+#define HPX_PARCELSET_POLICIES_TCP_NETWORK_EMULATION_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/steady_clock.hpp>
+#include <hpx/util_fwd.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp
+{
+    /// Emulates the characteristics of a real network for all messages sent
+    /// by the TCP parcelport (hpx.parcel.tcp.emulate_network). This allows
+    /// to run network bound benchmarks with all localities on one host.
+    ///
+    /// Each message is held back until it could have been transmitted over
+    /// a link of the given bandwidth (shared by all messages sent from this
+    /// locality) and has then travelled for the given latency, plus a random
+    /// jitter. Some messages can be held back for another latency, which
+    /// lets later messages sent over other connections overtake them.
+    class HPX_EXPORT network_emulation
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        typedef util::steady_clock::time_point time_point;
+
+        explicit network_emulation(util::runtime_configuration const& ini);
+
+        /// Emulate a network with the given characteristics, the bandwidth
+        /// is given in bytes per microsecond (0 disables the limit) and the
+        /// reordering in percent.
+        network_emulation(std::chrono::nanoseconds latency,
+            std::chrono::nanoseconds jitter, double bandwidth,
+            std::int64_t reordering, std::uint32_t seed);
+
+        bool enabled() const
+        {
+            return enabled_;
+        }
+
+        /// Return the point in time when a message of the given size sent
+        /// now would arrive at its destination.
+        time_point release_time(std::size_t bytes)
+        {
+            return release_time(bytes, util::steady_clock::now());
+        }
+
+        /// Return the point in time when a message of the given size sent
+        /// at the given point in time would arrive at its destination.
+        time_point release_time(std::size_t bytes, time_point now);
+
+    private:
+        bool enabled_;
+        std::chrono::nanoseconds latency_;
+        std::chrono::nanoseconds jitter_;
+        double bandwidth_;              // in bytes per nanosecond
+        std::int64_t reordering_;       // in percent
+
+        mutex_type mtx_;
+        time_point link_available_;
+        std::mt19937 random_;
+    };
+}}}}
+
+#endif
+
+#endif
@@ -21,6 +21,7 @@
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/parcelset/decode_parcels.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
+#include <hpx/runtime/parcelset/receive_chunk.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/protect.hpp>
@@ -45,8 +46,10 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 {
     class connection_handler;
 
+    // The zero-copy chunks are received into memory which can be taken over
+    // during de-serialization (see parcelset::receive_chunk).
     class receiver
-      : public parcelport_connection<receiver, std::vector<char>, std::vector<char> >
+      : public parcelport_connection<receiver, std::vector<char>, receive_chunk>
     {
         typedef hpx::lcos::local::spinlock mutex_type;
     public:
@@ -17,15 +17,19 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/plugins/parcelport/tcp/locality.hpp>
+#include <hpx/plugins/parcelport/tcp/network_emulation.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcelport.hpp>
 #include <hpx/runtime/parcelset/parcelport_connection.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/chrono_traits.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
+#include <hpx/util/steady_clock.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/asio_util.hpp>
 
 #include <boost/asio/buffer.hpp>
+#include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
 #include <boost/asio/placeholders.hpp>
@@ -34,6 +38,7 @@
 #include <boost/atomic.hpp>
 
 #include <cstddef>
+#include <cstring>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -47,12 +52,15 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         /// Construct a sending parcelport_connection with the given io_service.
         sender(boost::asio::io_service& io_service,
                 parcelset::locality const& locality_id,
-                parcelset::parcelport* pp)
+                parcelset::parcelport* pp,
+                network_emulation* emulation = nullptr)
           : socket_(io_service)
           , ack_(0)
           , there_(locality_id)
           , timer_()
           , pp_(pp)
+          , emulation_(emulation)
+          , delay_timer_(io_service)
         {
         }
 
@@ -111,20 +119,28 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             buffer_.data_point_.time_ = timer_.elapsed_nanoseconds();
 
             // Write the serialized data to the socket. We use "gather-write"
-            // to send both the header and the data in a single write operation.
-            std::vector<boost::asio::const_buffer> buffers;
-            buffers.push_back(boost::asio::buffer(&buffer_.size_,
-                sizeof(buffer_.size_)));
-            buffers.push_back(boost::asio::buffer(&buffer_.data_size_,
-                sizeof(buffer_.data_size_)));
+            // to send the header, the data and all zero-copy chunks in a
+            // single write operation. The list of buffers is reused by
+            // subsequent writes on this connection.
+            std::vector<boost::asio::const_buffer>& buffers = buffers_;
+            buffers.clear();
+
+            // the three header fields are sent using one buffer
+            char* header = header_;
+            std::memcpy(header, &buffer_.size_, sizeof(buffer_.size_));
+            header += sizeof(buffer_.size_);
+            std::memcpy(header, &buffer_.data_size_, sizeof(buffer_.data_size_));
+            header += sizeof(buffer_.data_size_);
 
             // add chunk description
-            buffers.push_back(boost::asio::buffer(&buffer_.num_chunks_,
-                sizeof(buffer_.num_chunks_)));
+            std::memcpy(header, &buffer_.num_chunks_,
+                sizeof(buffer_.num_chunks_));
+            buffers.push_back(boost::asio::buffer(header_, sizeof(header_)));
 
             std::vector<parcel_buffer_type::transmission_chunk_type>& chunks =
                 buffer_.transmission_chunks_;
             if (!chunks.empty()) {
+                buffers.reserve(buffer_.chunks_.size() + 3);
                 buffers.push_back(
                     boost::asio::buffer(chunks.data(), chunks.size() *
                         sizeof(parcel_buffer_type::transmission_chunk_type)));
@@ -144,6 +160,28 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
                 buffers.push_back(boost::asio::buffer(buffer_.data_));
             }
 
+            // hold back the message for as long as it would take to be
+            // transmitted over the emulated network. Note that the connection
+            // stays busy until the message has been released, i.e. each
+            // connection carries at most one message per emulated latency.
+            if (emulation_ != nullptr)
+            {
+                void (sender::*f)(boost::system::error_code const&)
+                    = &sender::handle_delay;
+
+                using util::placeholders::_1;
+                delay_timer_.expires_at(emulation_->release_time(
+                    boost::asio::buffer_size(buffers)));
+                delay_timer_.async_wait(util::bind(f, shared_from_this(), _1));
+                return;
+            }
+
+            start_write();
+        }
+
+    private:
+        void start_write()
+        {
             // this additional wrapping of the handler into a bind object is
             // needed to keep  this parcelport_connection object alive for the whole
             // write operation
@@ -152,11 +190,21 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
             using util::placeholders::_1;
             using util::placeholders::_2;
-            boost::asio::async_write(socket_, buffers,
+            boost::asio::async_write(socket_, buffers_,
                 util::bind(f, shared_from_this(), _1, _2));
         }
 
-    private:
+        /// the emulated network has delivered the message
+        void handle_delay(boost::system::error_code const& e)
+        {
+            if (e)
+            {
+                handle_write(e, 0);
+                return;
+            }
+            start_write();
+        }
+
         /// handle completed write operation
         void handle_write(boost::system::error_code const& e, std::size_t bytes)
         {
@@ -210,6 +258,13 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         bool ack_;
 
+        /// The header of the message being sent and the list of buffers
+        /// handed to the gather-write operation.
+        char header_[
+            sizeof(parcel_buffer_type::count_chunks_type) +
+            2 * sizeof(util::integer::ulittle64_t)];
+        std::vector<boost::asio::const_buffer> buffers_;
+
         /// the other (receiving) end of this connection
         parcelset::locality there_;
 
@@ -217,6 +272,15 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
         util::high_resolution_timer timer_;
         parcelset::parcelport* pp_;
 
+        /// Network emulation, if enabled for this parcelport
+        typedef boost::asio::basic_deadline_timer<
+            util::steady_clock,
+            util::chrono_traits<util::steady_clock>
+        > deadline_timer;
+
+        network_emulation* emulation_;
+        deadline_timer delay_timer_;
+
         util::unique_function_nonser<
             void(
                 boost::system::error_code const&
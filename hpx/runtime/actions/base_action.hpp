@@ -57,6 +57,10 @@ namespace hpx { namespace actions
         /// (mainly used for debugging and logging purposes).
         virtual char const* get_action_name() const = 0;
 
+        /// The function \a get_action_id returns the id this action is
+        /// serialized with.
+        virtual std::uint32_t get_action_id() const = 0;
+
         /// The function \a get_action_type returns whether this action needs
         /// to be executed in a new thread or directly.
         virtual action_type get_action_type() const = 0;
@@ -94,6 +98,10 @@ namespace hpx { namespace actions
         /// Return whether the embedded action is part of termination detection
         virtual bool does_termination_detection() const = 0;
 
+        /// Return whether the embedded action will be run directly on the
+        /// thread decoding its parcel
+        virtual bool does_execute_inline() const = 0;
+
         /// Perform thread initialization
         virtual void schedule_thread(naming::gid_type const& target,
             naming::address_type lva,
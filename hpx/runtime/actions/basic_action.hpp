@@ -672,13 +672,16 @@ namespace hpx { namespace actions
         primary_namespace_allocate_action_id,
         primary_namespace_begin_migration_action_id,
         primary_namespace_bind_gid_action_id,
+        primary_namespace_bind_gids_action_id,
         primary_namespace_colocate_action_id,
         primary_namespace_decrement_credit_action_id,
         primary_namespace_end_migration_action_id,
         primary_namespace_increment_credit_action_id,
         primary_namespace_resolve_gid_action_id,
+        primary_namespace_resolve_gids_action_id,
         primary_namespace_route_action_id,
         primary_namespace_unbind_gid_action_id,
+        primary_namespace_update_credits_action_id,
         primary_namespace_statistics_counter_action_id,
         remove_from_connection_cache_action_id,
         set_value_action_agas_bool_response_type_id,
@@ -756,6 +759,8 @@ namespace hpx { namespace actions
         base_lco_with_value_naming_address_set,
         base_lco_with_value_gva_tuple_get,
         base_lco_with_value_gva_tuple_set,
+        base_lco_with_value_vector_gva_tuple_get,
+        base_lco_with_value_vector_gva_tuple_set,
         base_lco_with_value_std_pair_address_id_type_get,
         base_lco_with_value_std_pair_address_id_type_set,
         base_lco_with_value_std_pair_gid_type_get,
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace actions { namespace detail
@@ -24,26 +25,36 @@ namespace hpx { namespace actions { namespace detail
 
     public:
         typedef base_action* (*ctor_t)(bool);
-        typedef std::unordered_map<std::string, ctor_t> typename_to_ctor_t;
+
+        // the constructor of an action type and the location its id is
+        // cached in, once assigned
+        typedef std::pair<ctor_t, std::uint32_t*> factory_t;
+
+        typedef std::unordered_map<std::string, factory_t> typename_to_ctor_t;
         typedef std::unordered_map<std::string, std::uint32_t> typename_to_id_t;
         typedef std::vector<ctor_t> cache_t;
 
         HPX_STATIC_CONSTEXPR std::uint32_t invalid_id = ~0;
 
         HPX_EXPORT action_registry();
-        HPX_EXPORT void register_factory(std::string const& type_name, ctor_t ctor);
+        HPX_EXPORT void register_factory(std::string const& type_name,
+            ctor_t ctor, std::uint32_t* id = nullptr);
         HPX_EXPORT void register_typename(std::string const& type_name, std::uint32_t id);
         HPX_EXPORT void fill_missing_typenames();
         HPX_EXPORT std::uint32_t try_get_id(std::string const& type_name) const;
         HPX_EXPORT std::vector<std::string> get_unassigned_typenames() const;
 
+        // Return a checksum of all assigned ids and their typenames, this is
+        // equal on all localities which agree on the ids
+        HPX_EXPORT std::uint64_t get_checksum() const;
+
         HPX_EXPORT static std::uint32_t get_id(std::string const& type_name);
         HPX_EXPORT static base_action* create(
             std::uint32_t id, bool, std::string const* name = nullptr);
 
         HPX_EXPORT static action_registry& instance();
 
-        void cache_id(std::uint32_t id, ctor_t ctor);
+        void cache_id(std::uint32_t id, factory_t const& factory);
         std::string collect_registered_typenames();
 
         std::uint32_t max_id_;
@@ -62,7 +73,14 @@ namespace hpx { namespace actions { namespace detail
         static base_action* create(bool);
         register_action& instantiate();
 
+        // Return the id assigned to this action type, this avoids looking up
+        // the typename for every parcel once the id has been assigned.
+        std::uint32_t get_id() const;
+
         static register_action instance;
+
+    private:
+        std::uint32_t id_;
     };
 
     template <typename Action>
@@ -70,10 +88,23 @@ namespace hpx { namespace actions { namespace detail
 
     template <typename Action>
     register_action<Action>::register_action()
+      : id_(action_registry::invalid_id)
     {
         action_registry::instance().register_factory(
             hpx::actions::detail::get_action_name<Action>(),
-            &create);
+            &create, &id_);
+    }
+
+    template <typename Action>
+    std::uint32_t register_action<Action>::get_id() const
+    {
+        std::uint32_t id = id_;
+        if (HPX_UNLIKELY(id == action_registry::invalid_id))
+        {
+            id = action_registry::get_id(
+                hpx::actions::detail::get_action_name<Action>());
+        }
+        return id;
     }
 
     template <typename Action>
@@ -0,0 +1,141 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_ACTIONS_INLINE_EXECUTION_MAR_02_2017_0214PM)
+#define HPX_ACTIONS_INLINE_EXECUTION_MAR_02_2017_0214PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/coroutines/coroutine.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstdint>
+#include <utility>
+
+namespace hpx { namespace actions { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Remote invocations of (non-direct) actions can be executed directly on
+    // the thread which has de-serialized the parcel instead of spawning a new
+    // thread (hpx.parcel.inline_actions). An action is executed inline once
+    // its last hpx.parcel.inline_actions_samples invocations have finished
+    // within hpx.parcel.inline_actions_threshold nanoseconds without being
+    // suspended.
+    HPX_EXPORT void configure_inline_execution(bool enable,
+        std::int64_t threshold, std::int64_t samples);
+
+    HPX_EXPORT bool inline_execution_enabled();
+    HPX_EXPORT std::int64_t inline_execution_threshold();
+    HPX_EXPORT std::int64_t inline_execution_samples();
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The statistics collected for one action type
+    struct inline_execution_data
+    {
+        inline_execution_data()
+          : samples_(0), disabled_(false), inlined_(0)
+        {}
+
+        // Returns whether the next invocation can be run inline
+        bool is_inline_safe() const
+        {
+            return !disabled_.load(boost::memory_order_relaxed) &&
+                samples_.load(boost::memory_order_relaxed) >=
+                    inline_execution_samples();
+        }
+
+        // Take into account a finished invocation of the action. Actions
+        // which were suspended are never executed inline again, slow ones
+        // have to qualify anew.
+        void add_sample(bool suspended, std::int64_t elapsed)
+        {
+            if (suspended)
+                disabled_.store(true, boost::memory_order_relaxed);
+            else if (elapsed > inline_execution_threshold())
+                samples_.store(0, boost::memory_order_relaxed);
+            else
+                ++samples_;
+        }
+
+        boost::atomic<std::int64_t> samples_;
+        boost::atomic<bool> disabled_;
+        boost::atomic<std::int64_t> inlined_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Detect whether the current HPX thread is suspended while this object
+    // is alive. This installs a yield decorator which forwards to the
+    // previously installed one.
+    class suspension_detector
+    {
+        HPX_NON_COPYABLE(suspension_detector);
+
+        typedef threads::thread_self::yield_decorator_type yield_decorator_type;
+
+    public:
+        suspension_detector()
+          : suspended_(false)
+          , prev_(threads::get_self().decorate_yield(
+                util::bind(&suspension_detector::yield, this,
+                    util::placeholders::_1)))
+        {}
+
+        ~suspension_detector()
+        {
+            threads::get_self().decorate_yield(std::move(prev_));
+        }
+
+        bool suspended() const
+        {
+            return suspended_;
+        }
+
+    private:
+        threads::thread_arg_type yield(threads::thread_result_type state)
+        {
+            suspended_ = true;
+
+            // Suspend using the previous decorator, ours is kept alive and
+            // re-installed once the thread was resumed.
+            yield_decorator_type self =
+                threads::get_self().decorate_yield(std::move(prev_));
+            threads::thread_arg_type result =
+                threads::get_self().yield(std::move(state));
+            prev_ = threads::get_self().decorate_yield(std::move(self));
+
+            return result;
+        }
+
+        bool suspended_;
+        yield_decorator_type prev_;
+    };
+
+    // Invoke the given function, collecting statistics for the action it
+    // executes. This has to be called on an HPX thread.
+    template <typename F>
+    void measure_execution(inline_execution_data& data, F && f)
+    {
+        bool suspended = false;
+        std::uint64_t start = util::high_resolution_clock::now();
+        {
+            suspension_detector detector;
+            f();
+            suspended = detector.suspended();
+        }
+        data.add_sample(suspended, static_cast<std::int64_t>(
+            util::high_resolution_clock::now() - start));
+    }
+
+    // Wrap the given thread function such that it collects the statistics
+    // for the action it executes.
+    HPX_EXPORT threads::thread_function_type measured_thread_function(
+        inline_execution_data& data, threads::thread_function_type && f);
+}}}
+
+#endif
@@ -37,6 +37,7 @@ namespace hpx { namespace actions { namespace detail
 
         static invocation_count_registry& local_instance();
         static invocation_count_registry& remote_instance();
+        static invocation_count_registry& inlined_instance();
 
         void register_class(std::string const& name, get_invocation_count_type fun);
 
@@ -52,9 +53,11 @@ namespace hpx { namespace actions { namespace detail
     private:
         struct local_tag {};
         struct remote_tag {};
+        struct inlined_tag {};
 
         friend struct hpx::util::static_<invocation_count_registry, local_tag>;
         friend struct hpx::util::static_<invocation_count_registry, remote_tag>;
+        friend struct hpx::util::static_<invocation_count_registry, inlined_tag>;
 
         map_type map_;
     };
@@ -67,6 +70,10 @@ namespace hpx { namespace actions { namespace detail
     void register_remote_action_invocation_count(
         invocation_count_registry& registry);
 
+    template <typename Action>
+    void register_inlined_action_invocation_count(
+        invocation_count_registry& registry);
+
     template <typename Action>
     struct register_action_invocation_count
     {
@@ -77,6 +84,9 @@ namespace hpx { namespace actions { namespace detail
 
             register_remote_action_invocation_count<Action>(
                 invocation_count_registry::remote_instance());
+
+            register_inlined_action_invocation_count<Action>(
+                invocation_count_registry::inlined_instance());
         }
 
         static register_action_invocation_count instance;
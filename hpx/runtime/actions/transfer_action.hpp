@@ -17,6 +17,8 @@
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/traits/action_continuation.hpp>
+#include <hpx/traits/action_decorate_continuation.hpp>
 #include <hpx/util/detail/pack.hpp>
 
 #include <cstddef>
@@ -168,6 +170,29 @@ namespace hpx { namespace actions
             reinterpret_cast<threads::thread_id_repr_type>(this->parent_id_);
         data.parent_locality_id = this->parent_locality_;
 #endif
+        if (this->may_execute_inline())
+        {
+            typedef typename base_type::derived_type derived_type;
+            typedef typename traits::action_continuation<derived_type>::type
+                continuation_type;
+
+            threads::thread_function_type f;
+            continuation_type cont;
+            if (traits::action_decorate_continuation<derived_type>::call(cont)) //-V614
+            {
+                f = derived_type::construct_thread_function(target,
+                    std::move(cont), lva,
+                    std::move(util::get<Is>(this->arguments_))...);
+            }
+            else
+            {
+                f = derived_type::construct_thread_function(target, lva,
+                    std::move(util::get<Is>(this->arguments_))...);
+            }
+            this->schedule_inline(std::move(data), lva, std::move(f));
+            return;
+        }
+
         applier::detail::apply_helper<typename base_type::derived_type>::call(
             std::move(data), target, lva, this->priority_,
             std::move(util::get<Is>(this->arguments_))...);
@@ -211,6 +236,16 @@ namespace hpx { namespace actions
         // First, serialize, then schedule
         load(ar);
 
+        // Actions which will be executed inline are always deferred, even if
+        // this is the last parcel. This makes sure that all other parcels of
+        // the message are scheduled before the decoding thread runs the
+        // action (which might suspend it).
+        if (base_type::is_executed_inline())
+        {
+            deferred_schedule = true;
+            return;
+        }
+
         if (deferred_schedule)
         {
             // If this is a direct action and deferred schedule was requested, that
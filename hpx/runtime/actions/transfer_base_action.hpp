@@ -13,12 +13,17 @@
 #include <hpx/runtime/actions_fwd.hpp>
 #include <hpx/runtime/actions/action_support.hpp>
 #include <hpx/runtime/actions/base_action.hpp>
+#include <hpx/runtime/actions/detail/inline_execution.hpp>
 #include <hpx/runtime/actions/detail/invocation_count_registry.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/report_error.hpp>
 #include <hpx/runtime/serialization/base_object.hpp>
 #include <hpx/runtime/serialization/input_archive.hpp>
 #include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/traits/action_does_termination_detection.hpp>
 #include <hpx/traits/action_message_handler.hpp>
 #include <hpx/traits/action_was_object_migrated.hpp>
@@ -30,6 +35,7 @@
 #include <hpx/util/serialize_exception.hpp>
 
 #include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -136,6 +142,13 @@ namespace hpx { namespace actions
             return detail::get_action_name<derived_type>();
         }
 
+        /// The function \a get_action_id returns the id this action is
+        /// serialized with.
+        std::uint32_t get_action_id() const
+        {
+            return detail::register_action<derived_type>::instance.get_id();
+        }
+
 #if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
         /// The function \a get_action_name_itt returns the name of this action
         /// as a ITT string_handle
@@ -208,6 +221,13 @@ namespace hpx { namespace actions
             return traits::action_does_termination_detection<derived_type>::call();
         }
 
+        /// Return whether the embedded action will be run directly on the
+        /// thread decoding its parcel
+        bool does_execute_inline() const
+        {
+            return is_executed_inline();
+        }
+
         /// Return whether the given object was migrated
         std::pair<bool, components::pinned_ptr>
             was_object_migrated(hpx::naming::gid_type const& id,
@@ -248,6 +268,13 @@ namespace hpx { namespace actions
             return util::get_and_reset_value(invocation_count_, reset);
         }
 
+        /// Extract the number of invocations of this action which were run
+        /// directly on the thread de-serializing the parcel
+        static std::int64_t get_inlined_count(bool reset)
+        {
+            return util::get_and_reset_value(inline_data_.inlined_, reset);
+        }
+
         // serialization support
         // loading ...
         void load_base(hpx::serialization::input_archive & ar)
@@ -313,6 +340,35 @@ namespace hpx { namespace actions
         {
             ++invocation_count_;
         }
+
+        // Returns whether this invocation may be run directly on the current
+        // thread instead of being scheduled as a new thread, see
+        // hpx.parcel.inline_actions.
+        static bool may_execute_inline()
+        {
+            return !direct_execution::value &&
+                detail::inline_execution_enabled() &&
+                threads::get_self_ptr() != nullptr &&
+                this_thread::has_sufficient_stack_space();
+        }
+
+        // Returns whether this invocation will be run directly on the current
+        // thread.
+        static bool is_executed_inline()
+        {
+            return may_execute_inline() && inline_data_.is_inline_safe();
+        }
+
+        // Run the given thread function right away if this action is known
+        // to finish quickly without suspending, otherwise schedule it as a new
+        // thread which collects the statistics needed to decide on this.
+        void schedule_inline(threads::thread_init_data&& data,
+            naming::address::address_type lva,
+            threads::thread_function_type && f);
+
+    private:
+        // statistics used to decide whether this action is run inline
+        static detail::inline_execution_data inline_data_;
     };
 
 #if defined(HPX_MSVC) && HPX_MSVC < 1900
@@ -323,6 +379,52 @@ namespace hpx { namespace actions
     boost::atomic<std::int64_t>
         transfer_base_action<Action>::invocation_count_(0);
 
+    template <typename Action>
+    detail::inline_execution_data transfer_base_action<Action>::inline_data_;
+
+    template <typename Action>
+    void transfer_base_action<Action>::schedule_inline(
+        threads::thread_init_data&& data, naming::address::address_type lva,
+        threads::thread_function_type && f)
+    {
+        if (inline_data_.is_inline_safe())
+        {
+            ++inline_data_.inlined_;
+
+            // Exceptions thrown by the action itself are handled by the
+            // thread function (they are forwarded to the continuation, if
+            // any). Anything else must not escape into the decoding of the
+            // remaining parcels, report it as for any other HPX thread.
+            try {
+                detail::measure_execution(inline_data_,
+                    [&]() { f(threads::wait_signaled); });
+            }
+            catch (...) {
+                hpx::report_error(boost::current_exception());
+            }
+            return;
+        }
+
+        data.func = detail::measured_thread_function(inline_data_, std::move(f));
+#if defined(HPX_HAVE_THREAD_TARGET_ADDRESS)
+        data.lva = lva;
+#endif
+#if defined(HPX_HAVE_THREAD_DESCRIPTION)
+#if HPX_HAVE_ITTNOTIFY != 0 && !defined(HPX_HAVE_APEX)
+        data.description = util::thread_description(
+            detail::get_action_name<derived_type>(),
+            detail::get_action_name_itt<derived_type>());
+#else
+        data.description = detail::get_action_name<derived_type>();
+#endif
+#endif
+        data.priority = priority_;
+        data.stacksize = threads::get_stack_size(stacksize_);
+
+        traits::action_schedule_thread<derived_type>::call(
+            lva, data, threads::pending);
+    }
+
     namespace detail
     {
         template <typename Action>
@@ -334,6 +436,16 @@ namespace hpx { namespace actions
                 &transfer_base_action<Action>::get_invocation_count
             );
         }
+
+        template <typename Action>
+        void register_inlined_action_invocation_count(
+            invocation_count_registry& registry)
+        {
+            registry.register_class(
+                hpx::actions::detail::get_action_name<Action>(),
+                &transfer_base_action<Action>::get_inlined_count
+            );
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -18,6 +18,7 @@
 #include <hpx/runtime/serialization/serialization_fwd.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
+#include <hpx/traits/action_decorate_continuation.hpp>
 #include <hpx/util/detail/pack.hpp>
 
 #include <cstddef>
@@ -168,6 +169,18 @@ namespace hpx { namespace actions
             reinterpret_cast<threads::thread_id_repr_type>(this->parent_id_);
         data.parent_locality_id = this->parent_locality_;
 #endif
+        if (this->may_execute_inline())
+        {
+            typedef typename base_type::derived_type derived_type;
+
+            traits::action_decorate_continuation<derived_type>::call(cont_);
+            this->schedule_inline(std::move(data), lva,
+                derived_type::construct_thread_function(target,
+                    std::move(cont_), lva,
+                    std::move(util::get<Is>(this->arguments_))...));
+            return;
+        }
+
         applier::detail::apply_helper<typename base_type::derived_type>::call(
             std::move(data), std::move(cont_), target, lva, this->priority_,
             std::move(util::get<Is>(this->arguments_))...);
@@ -212,6 +225,16 @@ namespace hpx { namespace actions
         // First, serialize, then schedule
         load(ar);
 
+        // Actions which will be executed inline are always deferred, even if
+        // this is the last parcel. This makes sure that all other parcels of
+        // the message are scheduled before the decoding thread runs the
+        // action (which might suspend it).
+        if (base_type::is_executed_inline())
+        {
+            deferred_schedule = true;
+            return;
+        }
+
         if (deferred_schedule)
         {
             // If this is a direct action and deferred schedule was requested, that
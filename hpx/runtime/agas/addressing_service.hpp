@@ -17,6 +17,7 @@
 #include <hpx/runtime/runtime_mode.hpp>
 #include <hpx/runtime/agas_fwd.hpp>
 #include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
 #include <hpx/runtime/agas/component_namespace.hpp>
 #include <hpx/runtime/agas/locality_namespace.hpp>
 #include <hpx/runtime/agas/symbol_namespace.hpp>
@@ -26,8 +27,6 @@
 #include <hpx/runtime/naming/name.hpp>
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/state.hpp>
-#include <hpx/util/cache/lru_cache.hpp>
-#include <hpx/util/cache/statistics/local_full_statistics.hpp>
 #include <hpx/util_fwd.hpp>
 #include <hpx/util/function.hpp>
 
@@ -73,19 +72,13 @@ public:
     // }}}
 
     // {{{ gva cache
-    struct gva_cache_key;
-
-    typedef hpx::util::cache::lru_cache<
-        gva_cache_key
-      , gva
-      , hpx::util::cache::statistics::local_full_statistics
-    > gva_cache_type;
+    typedef agas::gva_cache_key gva_cache_key;
+    typedef agas::gva_cache gva_cache_type;
     // }}}
 
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, std::int64_t> refcnt_requests_type;
 
-    mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
     mutable mutex_type migrated_objects_mtx_;
@@ -102,6 +95,17 @@ public:
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // Increments of remote credits are not sent immediately but are collected
+    // per primary namespace instance until the thread sending them runs
+    // (or until the next flush of the pending decrements). This is protected
+    // by refcnt_requests_mtx_ as well.
+    struct credit_request_batch;
+    typedef std::map<
+            naming::gid_type, std::shared_ptr<credit_request_batch>
+        > credit_request_batches_type;
+
+    credit_request_batches_type incref_requests_;
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
@@ -206,6 +210,12 @@ public:
       , std::int64_t compensated_credit
         );
 
+    std::int64_t synchronize_with_incref_batch(
+        hpx::shared_future<void> fut
+      , naming::id_type const& id
+      , std::int64_t compensated_credit
+        );
+
     naming::address::address_type get_primary_ns_lva() const
     {
         return primary_ns_.ptr();
@@ -235,6 +245,20 @@ protected:
       , gva const& g
         );
 
+    std::vector<naming::address> resolve_bulk_postproc(
+        future<std::vector<
+            future<std::vector<primary_namespace::resolved_type> >
+        > > f
+      , std::vector<naming::gid_type> const& gids
+      , std::vector<std::vector<std::size_t> > const& indices
+      , std::vector<naming::address> addrs
+        );
+    void bind_bulk_postproc(
+        future<std::vector<future<void> > > f
+      , std::vector<naming::gid_type> const& ids
+      , std::vector<gva> const& gvas
+        );
+
     /// Maintain list of migrated objects
     bool was_object_migrated_locked(
         naming::gid_type const& id
@@ -254,11 +278,33 @@ private:
         );
 
     /// Assumes that \a refcnt_requests_mtx_ is locked.
-    std::vector<hpx::future<std::vector<std::int64_t> > >
+    std::vector<hpx::future<void> >
     send_refcnt_requests_async(
         std::unique_lock<mutex_type>& l
         );
 
+    /// Merges all pending decrements into the collected increments.
+    /// Assumes that \a refcnt_requests_mtx_ is locked.
+    void collect_credit_requests(
+        std::unique_lock<mutex_type>& l
+      , credit_request_batches_type& batches
+        );
+
+    /// Sends the combined credit requests for one primary namespace
+    /// instance. The returned future is valid only if \a acknowledge is
+    /// true or if some incref is waiting for the requests to be acknowledged.
+    hpx::future<void> send_credit_requests(
+        naming::gid_type const& target
+      , std::shared_ptr<credit_request_batch> const& batch
+      , bool acknowledge
+        );
+
+    /// Sends the collected increments for the given primary namespace
+    /// instance, if they have not been sent yet.
+    void send_incref_requests(
+        naming::gid_type const& target
+        );
+
     /// Assumes that \a refcnt_requests_mtx_ is locked.
     void send_refcnt_requests_sync(
         std::unique_lock<mutex_type>& l
@@ -666,6 +712,28 @@ public:
             naming::get_gid_from_locality_id(locality_id));
     }
 
+    /// \brief Bind a set of global ids to their local addresses at once
+    ///
+    /// The ids are grouped by the primary namespace instance managing them,
+    /// each of those instances receives a single request. All bindings are
+    /// put into the local cache once the requests have been acknowledged.
+    ///
+    /// \param ids        [in] The global ids to bind.
+    /// \param addrs      [in] The local addresses to bind to the
+    ///                   corresponding global ids.
+    /// \param locality   [in] The locality the objects live on.
+    ///
+    /// \returns          A future which becomes ready once all ids have
+    ///                   been bound.
+    ///
+    /// \note             Binding a gid to a local address sets its global
+    ///                   reference count to one.
+    hpx::future<void> bind_bulk(
+        std::vector<naming::gid_type> const& ids
+      , std::vector<naming::address> const& addrs
+      , naming::gid_type const& locality
+        );
+
     /// \brief Unbind a global address
     ///
     /// Remove the association of the given global address with any local
@@ -1100,6 +1168,25 @@ public:
       , error_code& ec = throws
         );
 
+    /// \brief Resolve a set of global addresses at once
+    ///
+    /// All ids which can't be resolved from the local cache are grouped by
+    /// the primary namespace instance managing them, each of those instances
+    /// receives a single request. All resolved addresses are put into the
+    /// local cache.
+    ///
+    /// \param gids       [in] The global addresses to resolve.
+    ///
+    /// \returns          A future referring to the local addresses, in the
+    ///                   order of the given ids.
+    hpx::future<std::vector<naming::address> > resolve_bulk(
+        std::vector<naming::gid_type> const& gids
+        );
+
+    hpx::future<std::vector<naming::address> > resolve_bulk(
+        std::vector<naming::id_type> const& ids
+        );
+
     /// \brief Route the given parcel to the appropriate AGAS service instance
     ///
     /// This function sends the given parcel to the AGAS service instance which
@@ -1152,6 +1239,24 @@ public:
         return incref_async(gid, credits).get(ec);
     }
 
+    /// \brief Increment the global reference counts of a set of ids at once
+    ///
+    /// Pending decrements are compensated as for \a incref_async. The
+    /// remaining increments are grouped by the primary namespace instance
+    /// managing the ids, each of those instances receives a single request.
+    ///
+    /// \param requests   [in] The global ids and the number of reference
+    ///                   counts to add for each of them.
+    ///
+    /// \returns          A future which becomes ready once all increments
+    ///                   have been acknowledged.
+    ///
+    /// \note             The caller has to keep the ids alive until the
+    ///                   returned future has become ready.
+    hpx::future<void> incref_bulk(
+        std::vector<std::pair<naming::gid_type, std::int64_t> > const& requests
+        );
+
     /// \brief Decrement the global reference count for the given id
     ///
     /// \param id         [in] The global address (id) for which the
@@ -0,0 +1,98 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_AGAS_CREDIT_REQUESTS_MAR_08_2017_0915AM)
+#define HPX_AGAS_CREDIT_REQUESTS_MAR_08_2017_0915AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/serialization_fwd.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace agas
+{
+    /// \brief A set of credit changes for global ids which are all managed by
+    ///        the same primary namespace instance.
+    ///
+    /// Positive credits are increments, negative credits are decrements. All
+    /// increments are applied before any of the decrements. On the wire the
+    /// requests are sorted by id and the ids are delta-encoded, which makes
+    /// ids allocated close to each other (the common case) cost only a
+    /// couple of bytes each.
+    class HPX_EXPORT credit_requests
+    {
+    public:
+        typedef std::pair<naming::gid_type, std::int64_t> value_type;
+        typedef std::vector<value_type>::const_iterator const_iterator;
+
+        credit_requests() {}
+
+        void add(naming::gid_type const& gid, std::int64_t credits)
+        {
+            HPX_ASSERT(credits != 0);
+            requests_.push_back(value_type(gid, credits));
+        }
+
+        void clear()
+        {
+            requests_.clear();
+        }
+
+        std::size_t size() const
+        {
+            return requests_.size();
+        }
+
+        bool empty() const
+        {
+            return requests_.empty();
+        }
+
+        const_iterator begin() const
+        {
+            return requests_.begin();
+        }
+
+        const_iterator end() const
+        {
+            return requests_.end();
+        }
+
+    private:
+        std::vector<std::uint8_t> encode() const;
+        void decode(std::vector<std::uint8_t> const& data);
+
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void save(Archive& ar, const unsigned int version) const
+        {
+            std::vector<std::uint8_t> data = encode();
+            ar << data;
+        }
+
+        template <typename Archive>
+        void load(Archive& ar, const unsigned int version)
+        {
+            std::vector<std::uint8_t> data;
+            ar >> data;
+            decode(data);
+        }
+
+        HPX_SERIALIZATION_SPLIT_MEMBER()
+
+        std::vector<value_type> requests_;
+    };
+}}
+
+#endif
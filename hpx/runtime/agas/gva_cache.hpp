@@ -0,0 +1,199 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2011 Bryce Adelstein-Lelbach
+//  Copyright (c) 2011-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_AGAS_GVA_CACHE_MAR_10_2017_1140AM)
+#define HPX_AGAS_GVA_CACHE_MAR_10_2017_1140AM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/icl/closed_interval.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <utility>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace agas
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A range of global ids. A key for a single id compares equal to any
+    /// range containing that id.
+    struct gva_cache_key
+    { // {{{ gva_cache_key implementation
+      private:
+        typedef boost::icl::closed_interval<naming::gid_type, std::less>
+            key_type;
+
+        key_type key_;
+
+      public:
+        gva_cache_key()
+          : key_()
+        {}
+
+        explicit gva_cache_key(
+            naming::gid_type const& id_
+          , std::uint64_t count_ = 1
+            )
+          : key_(naming::detail::get_stripped_gid(id_)
+               , naming::detail::get_stripped_gid(id_) + (count_ - 1))
+        {
+            HPX_ASSERT(count_);
+        }
+
+        naming::gid_type get_gid() const
+        {
+            return boost::icl::lower(key_);
+        }
+
+        std::uint64_t get_count() const
+        {
+            naming::gid_type const size = boost::icl::length(key_);
+            HPX_ASSERT(size.get_msb() == 0);
+            return size.get_lsb();
+        }
+
+        friend bool operator<(
+            gva_cache_key const& lhs
+          , gva_cache_key const& rhs
+            )
+        {
+            return boost::icl::exclusive_less(lhs.key_, rhs.key_);
+        }
+
+        friend bool operator==(
+            gva_cache_key const& lhs
+          , gva_cache_key const& rhs
+            )
+        {
+            // Direct hit
+            if(lhs.key_ == rhs.key_)
+                return true;
+
+            // Is lhs in rhs?
+            if (1 == lhs.get_count() && 1 != rhs.get_count())
+                return boost::icl::contains(rhs.key_, lhs.key_);
+
+            // Is rhs in lhs?
+            else if (1 != lhs.get_count() && 1 == rhs.get_count())
+                return boost::icl::contains(lhs.key_, rhs.key_);
+
+            return false;
+        }
+    }; // }}}
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief The cache of resolved addresses kept by the addressing service.
+    ///
+    /// The cache is split into a fixed number of shards, each protected by
+    /// its own readers/writer lock. Consecutive ids are spread over the
+    /// shards in small groups. Every range of ids is stored exactly once: in
+    /// the shard of its group if it does not extend beyond it, otherwise in
+    /// one additional shard holding all ranges which span several groups.
+    /// Lookups take the locks of at most these two shards in shared mode
+    /// only, so concurrent hits never block each other. Every shard evicts
+    /// its entries using the CLOCK algorithm, which approximates LRU without
+    /// having to reorder anything on a hit.
+    ///
+    /// The maximum size applies to all shards together. An insertion evicts
+    /// entries from the shard it changes only, which never evicts the last
+    /// entry of a shard. The cache may therefore exceed its maximum size by
+    /// at most the number of shards.
+    class HPX_EXPORT gva_cache
+    {
+        HPX_NON_COPYABLE(gva_cache);
+
+    public:
+        typedef gva_cache_key key_type;
+        typedef gva entry_type;
+        typedef std::pair<key_type, entry_type> entry_pair;
+        typedef std::size_t size_type;
+
+        /// Return true if the new key must not replace the existing one
+        typedef util::function_nonser<
+                bool(key_type const&, key_type const&)
+            > collision_function_type;
+        typedef util::function_nonser<
+                bool(entry_pair const&)
+            > erase_function_type;
+
+        /// \param max_size   The number of entries this cache is allowed to
+        ///                   hold (see above), zero means no size limitation.
+        explicit gva_cache(size_type max_size = 0);
+        ~gva_cache();
+
+        /// Return the number of entries held by all shards.
+        size_type size() const;
+        size_type capacity() const;
+
+        /// Change the maximum size this cache can grow to
+        void reserve(size_type max_size);
+
+        /// Retrieve the entry for the range containing the given key.
+        bool get_entry(key_type const& key, key_type& realkey,
+            entry_type& entry);
+        bool get_entry(key_type const& key, entry_type& entry)
+        {
+            key_type tmp;
+            return get_entry(key, tmp, entry);
+        }
+
+        /// Insert or replace the entry for the given key, unless \a f
+        /// returns true for the given key and any overlapping key already
+        /// held by the cache.
+        bool update_if(key_type const& key, entry_type const& entry,
+            collision_function_type const& f);
+
+        /// Remove all entries for which \a ep returns true.
+        size_type erase(erase_function_type const& ep);
+
+        /// Remove all entries.
+        size_type clear();
+
+        // statistics
+        std::int64_t hits(bool reset);
+        std::int64_t misses(bool reset);
+        std::int64_t evictions(bool reset);
+        std::int64_t insertions(bool reset);
+
+        std::int64_t get_get_entry_count(bool reset);
+        std::int64_t get_insert_entry_count(bool reset);
+        std::int64_t get_update_entry_count(bool reset);
+        std::int64_t get_erase_entry_count(bool reset);
+
+        std::int64_t get_get_entry_time(bool reset);
+        std::int64_t get_insert_entry_time(bool reset);
+        std::int64_t get_update_entry_time(bool reset);
+        std::int64_t get_erase_entry_time(bool reset);
+
+    private:
+        struct shard;
+
+        std::size_t shard_for(key_type const& key) const;
+        std::uint64_t shards_for(key_type const& key) const;
+
+        bool find_entry(shard& s, key_type const& key, key_type& realkey,
+            entry_type& entry);
+
+        boost::atomic<size_type> max_size_;
+        boost::atomic<size_type> size_;
+        std::unique_ptr<shard[]> shards_;
+    };
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
@@ -297,6 +297,12 @@ HPX_API_EXPORT naming::address resolve(
   , error_code& ec = throws
     );
 
+// Resolve all given ids, sending a single request to each of the AGAS
+// instances managing them
+HPX_API_EXPORT hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    );
+
 #if defined(HPX_HAVE_ASYNC_FUNCTION_COMPATIBILITY)
 HPX_DEPRECATED(HPX_DEPRECATED_MSG)
 inline naming::address resolve_sync(
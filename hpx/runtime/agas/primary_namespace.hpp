@@ -62,6 +62,10 @@ struct HPX_EXPORT primary_namespace
     bool bind_gid(gva g, naming::gid_type id, naming::gid_type locality);
     future<bool> bind_gid_async(gva g, naming::gid_type id, naming::gid_type locality);
 
+    // All ids have to be managed by the same primary namespace instance
+    future<void> bind_gid_async(std::vector<gva> gvas,
+        std::vector<naming::gid_type> ids, naming::gid_type locality);
+
     void route(parcelset::parcel && p,
         util::function_nonser<void(boost::system::error_code const&,
         parcelset::parcel const&)> && f);
@@ -69,6 +73,10 @@ struct HPX_EXPORT primary_namespace
     resolved_type resolve_gid(naming::gid_type id);
     future<resolved_type> resolve_full(naming::gid_type id);
 
+    // All ids have to be managed by the same primary namespace instance
+    future<std::vector<resolved_type> >
+    resolve_full(std::vector<naming::gid_type> ids);
+
     future<id_type> colocate(naming::gid_type id);
 
     naming::address unbind_gid(std::uint64_t count, naming::gid_type id);
@@ -13,7 +13,10 @@
 #include <hpx/config.hpp>
 #include <hpx/lcos/base_lco_with_value.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
+#include <hpx/lcos/local/shared_spinlock.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/runtime/agas_fwd.hpp>
+#include <hpx/runtime/agas/credit_requests.hpp>
 #include <hpx/runtime/agas/gva.hpp>
 #include <hpx/runtime/actions/component_action.hpp>
 #include <hpx/runtime/components/server/fixed_component_base.hpp>
@@ -120,6 +123,7 @@ struct HPX_EXPORT primary_namespace
 {
     // {{{ nested types
     typedef lcos::local::spinlock mutex_type;
+    typedef lcos::local::shared_spinlock gva_table_mutex_type;
     typedef components::fixed_component_base<primary_namespace> base_type;
 
     typedef std::int32_t component_type;
@@ -130,15 +134,38 @@ struct HPX_EXPORT primary_namespace
 
     typedef hpx::util::tuple<naming::gid_type, gva, naming::gid_type>
         resolved_type;
+
+    // number of independently locked parts of the GVA and the reference
+    // count tables, has to be a power of two smaller than 64
+    static const std::size_t num_gva_stripes = 32;
+    static const std::size_t num_refcnt_stripes = 32;
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
+    // The GVA table is split into stripes, groups of consecutive ids are
+    // stored in the same stripe. A range of ids is stored in every stripe
+    // one of its ids maps to. Resolving an id takes the lock of a single
+    // stripe in shared mode only.
+    struct gva_table_stripe
+    {
+        gva_table_mutex_type mtx_;
+        gva_table_type gvas_;
+    };
+
+    // The reference count table is split into stripes as well, every id
+    // is stored in exactly one of them.
+    struct refcnt_table_stripe
+    {
+        mutex_type mtx_;
+        refcnt_table_type refcnts_;
+    };
+
+    // protects the migration table only
     mutex_type mutex_;
 
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
+    gva_table_stripe gva_stripes_[num_gva_stripes];
+    refcnt_table_stripe refcnt_stripes_[num_refcnt_stripes];
+
     typedef std::map<
             naming::gid_type,
             hpx::util::tuple<bool, std::size_t, lcos::local::condition_variable_any>
@@ -149,6 +176,9 @@ struct HPX_EXPORT primary_namespace
     naming::gid_type locality_;     // our locality id
     migration_table_type migrating_objects_;
 
+    // number of objects currently flagged as being migrated
+    boost::atomic<std::int64_t> migrating_count_;
+
     struct update_time_on_exit;
 
     // data structure holding all counters for the omponent_namespace component
@@ -223,24 +253,26 @@ struct HPX_EXPORT primary_namespace
     counter_data counter_data_;
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all ids in the given range.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
 
-    // helper function
+    // helper functions
     void wait_for_migration_locked(
         std::unique_lock<mutex_type>& l
       , naming::gid_type id
       , error_code& ec);
 
+    // wait for any migration of the given object to be completed and
+    // resolve it afterwards
+    resolved_type resolve_gid_after_migration(
+        naming::gid_type id
+      , error_code& ec);
+
   public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
@@ -248,6 +280,7 @@ struct HPX_EXPORT primary_namespace
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
+      , migrating_count_(0)
     {}
 
     void finalize();
@@ -284,12 +317,26 @@ struct HPX_EXPORT primary_namespace
       , naming::gid_type locality
         );
 
+    /// Bind all of the given ids to the corresponding GVAs. All ids have to
+    /// be managed by this instance.
+    void bind_gids(
+        std::vector<gva> gvas
+      , std::vector<naming::gid_type> ids
+      , naming::gid_type locality
+        );
+
     // API
     std::pair<naming::id_type, naming::address> begin_migration(naming::gid_type id);
     bool end_migration(naming::gid_type id);
 
     resolved_type resolve_gid(naming::gid_type id);
 
+    /// Resolve all of the given ids, which have to be managed by this
+    /// instance.
+    std::vector<resolved_type> resolve_gids(
+        std::vector<naming::gid_type> ids
+        );
+
     naming::id_type colocate(naming::gid_type id);
 
     naming::address unbind_gid(
@@ -309,17 +356,28 @@ struct HPX_EXPORT primary_namespace
         > requests
         );
 
+    /// Apply all credit increments and then all credit decrements of the
+    /// given (combined) request message.
+    void update_credits(
+        credit_requests requests
+        );
+
     std::pair<naming::gid_type, naming::gid_type> allocate(std::uint64_t count);
 
     naming::gid_type statistics_counter(std::string const& name);
 
   private:
-    resolved_type resolve_gid_locked(
-        std::unique_lock<mutex_type>& l
-      , naming::gid_type const& gid
+    resolved_type resolve_gid_impl(
+        naming::gid_type const& gid
       , error_code& ec
         );
 
+    // Return the set of GVA table stripes a range of ids is stored in
+    static std::uint64_t gva_stripes_for(
+        naming::gid_type const& id
+      , std::uint64_t count
+        );
+
     void increment(
         naming::gid_type const& lower
       , naming::gid_type const& upper
@@ -341,8 +399,7 @@ struct HPX_EXPORT primary_namespace
     };
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+        std::list<naming::gid_type> const& free_list
       , std::list<free_entry>& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
@@ -367,13 +424,16 @@ struct HPX_EXPORT primary_namespace
   public:
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, allocate);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, bind_gid);
+    HPX_DEFINE_COMPONENT_ACTION(primary_namespace, bind_gids);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, begin_migration);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, colocate);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, end_migration);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, decrement_credit);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, increment_credit);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gid);
+    HPX_DEFINE_COMPONENT_ACTION(primary_namespace, resolve_gids);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, unbind_gid);
+    HPX_DEFINE_COMPONENT_ACTION(primary_namespace, update_credits);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, route);
     HPX_DEFINE_COMPONENT_ACTION(primary_namespace, statistics_counter);
 
@@ -404,6 +464,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::bind_gid_action,
     primary_namespace_bind_gid_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::primary_namespace::bind_gids_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::bind_gids_action,
+    primary_namespace_bind_gids_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::primary_namespace::begin_migration_action)
 
@@ -439,6 +506,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::resolve_gid_action,
     primary_namespace_resolve_gid_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::primary_namespace::resolve_gids_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::resolve_gids_action,
+    primary_namespace_resolve_gids_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::primary_namespace::colocate_action)
 
@@ -453,6 +527,13 @@ HPX_REGISTER_ACTION_DECLARATION(
     hpx::agas::server::primary_namespace::unbind_gid_action,
     primary_namespace_unbind_gid_action)
 
+HPX_ACTION_USES_MEDIUM_STACK(
+    hpx::agas::server::primary_namespace::update_credits_action)
+
+HPX_REGISTER_ACTION_DECLARATION(
+    hpx::agas::server::primary_namespace::update_credits_action,
+    primary_namespace_update_credits_action)
+
 HPX_ACTION_USES_MEDIUM_STACK(
     hpx::agas::server::primary_namespace::route_action)
 
@@ -474,6 +555,9 @@ typedef hpx::util::tuple<
     > gva_tuple_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
     gva_tuple_type, gva_tuple)
+typedef std::vector<gva_tuple_type> vector_gva_tuple_type;
+HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
+    vector_gva_tuple_type, vector_gva_tuple)
 typedef std::pair<hpx::naming::id_type, hpx::naming::address>
     std_pair_address_id_type;
 HPX_REGISTER_BASE_LCO_WITH_VALUE_DECLARATION(
@@ -14,22 +14,29 @@
 #include <hpx/runtime/naming/resolver_client.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
 #include <hpx/runtime/parcelset/detail/parcel_route_handler.hpp>
+#include <hpx/runtime/parcelset/receive_chunk.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/runtime_fwd.hpp>
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/util/logging.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <sstream>
 #include <utility>
 #include <vector>
 
 namespace hpx { namespace parcelset
 {
+    // The chunk owners are filled (if given) for the zero-copy chunks whose
+    // memory can be taken over by the de-serialized objects.
     template <typename Buffer>
-    std::vector<serialization::serialization_chunk> decode_chunks(Buffer & buffer)
+    std::vector<serialization::serialization_chunk> decode_chunks(
+        Buffer & buffer,
+        std::vector<std::shared_ptr<char> >* chunk_owners = nullptr)
     {
         typedef typename Buffer::transmission_chunk_type transmission_chunk_type;
 
@@ -47,6 +54,8 @@ namespace hpx { namespace parcelset
                     static_cast<std::uint32_t>(buffer.num_chunks_.second));
 
             chunks.resize(num_zero_copy_chunks + num_non_zero_copy_chunks);
+            if (chunk_owners != nullptr)
+                chunk_owners->resize(chunks.size());
 
             // place the zero-copy chunks at their spots first
             for (std::size_t i = 0; i != num_zero_copy_chunks; ++i)
@@ -58,6 +67,11 @@ namespace hpx { namespace parcelset
 
                 chunks[first] = serialization::create_pointer_chunk(
                         buffer.chunks_[i].data(), second);
+                if (chunk_owners != nullptr)
+                {
+                    (*chunk_owners)[first] =
+                        detail::get_chunk_owner(buffer.chunks_[i]);
+                }
             }
 
             std::size_t index = 0;
@@ -98,6 +112,7 @@ namespace hpx { namespace parcelset
       , std::size_t parcel_count
       , std::vector<serialization::serialization_chunk> &chunks
       , std::size_t num_thread = -1
+      , std::vector<std::shared_ptr<char> > const* chunk_owners = nullptr
     )
     {
         std::uint64_t inbound_data_size = buffer.data_size_;
@@ -115,7 +130,7 @@ namespace hpx { namespace parcelset
                     std::vector<parcel> deferred_parcels;
                     // De-serialize the parcel data
                     serialization::input_archive archive(buffer.data_,
-                        inbound_data_size, &chunks);
+                        inbound_data_size, &chunks, chunk_owners);
 
                     if(parcel_count == 0)
                     {
@@ -189,7 +204,18 @@ namespace hpx { namespace parcelset
                     data.num_parcels_ = parcel_count;
                     data.raw_bytes_ = archive.bytes_read();
 
-                    for (std::size_t i = 0; i != deferred_parcels.size(); ++i)
+                    // Actions which are run inline are invoked directly on
+                    // this thread after all other parcels have been
+                    // scheduled, they don't need a thread of their own.
+                    std::size_t const num_scheduled = std::stable_partition(
+                            deferred_parcels.begin(), deferred_parcels.end(),
+                            [](parcel const& p)
+                            {
+                                return !p.get_action()->does_execute_inline();
+                            }
+                        ) - deferred_parcels.begin();
+
+                    for (std::size_t i = 0; i != num_scheduled; ++i)
                     {
                         // If we are the last deferred parcel, we don't need to spin
                         // a new thread...
@@ -213,6 +239,12 @@ namespace hpx { namespace parcelset
                                 num_thread, threads::thread_stacksize_default);
                         }
                     }
+
+                    for (std::size_t i = num_scheduled;
+                         i != deferred_parcels.size(); ++i)
+                    {
+                        deferred_parcels[i].schedule_action(num_thread);
+                    }
                 }
 
                 // store the time required for serialization
@@ -262,10 +294,11 @@ namespace hpx { namespace parcelset
       , std::size_t num_thread = -1
     )
     {
+        std::vector<std::shared_ptr<char> > chunk_owners;
         std::vector<serialization::serialization_chunk>
-            chunks(decode_chunks(buffer));
+            chunks(decode_chunks(buffer, &chunk_owners));
         decode_message_with_chunks(pp, std::move(buffer),
-            parcel_count, chunks, num_thread);
+            parcel_count, chunks, num_thread, &chunk_owners);
     }
 
     template <typename Parcelport, typename Buffer>
@@ -0,0 +1,345 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARCELSET_PENDING_PARCELS_QUEUE_FEB_27_2017_1032AM)
+#define HPX_PARCELSET_PENDING_PARCELS_QUEUE_FEB_27_2017_1032AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/shared_spinlock.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parcelset { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The parcels (and their write handlers) waiting to be sent to one
+    // destination. Any number of threads may add parcels without taking a
+    // lock (this is the node based multi-producer/single-consumer queue by
+    // D. Vyukov). Only one thread at a time can take parcels out of the queue,
+    // other threads trying to do so concurrently return right away.
+    //
+    // Every non-empty queue is counted exactly once in the number of
+    // destinations shared by all queues (see count_destination).
+    template <typename Handler>
+    class pending_parcels_queue
+    {
+    private:
+        struct node
+        {
+            node()
+              : next_(nullptr)
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+              , enqueued_(0)
+#endif
+            {}
+
+            node(parcel&& p, Handler&& f)
+              : parcel_(std::move(p)), handler_(std::move(f)), next_(nullptr)
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+              , enqueued_(static_cast<std::int64_t>(
+                    util::high_resolution_clock::now()))
+#endif
+            {}
+
+            parcel parcel_;
+            Handler handler_;
+            boost::atomic<node*> next_;
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+            std::int64_t enqueued_;     // time the parcel was added (ns)
+#endif
+        };
+
+        struct ignore_node
+        {
+            void operator()(node const&) const {}
+        };
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+        struct collect_queue_time
+        {
+            collect_queue_time(std::vector<std::int64_t>& queue_times)
+              : queue_times_(queue_times),
+                now_(static_cast<std::int64_t>(
+                    util::high_resolution_clock::now()))
+            {}
+
+            void operator()(node const& n) const
+            {
+                queue_times_.push_back(now_ - n.enqueued_);
+            }
+
+            std::vector<std::int64_t>& queue_times_;
+            std::int64_t now_;
+        };
+#endif
+
+    public:
+        explicit pending_parcels_queue(
+                boost::atomic<std::uint32_t>& destinations)
+          : head_(new node), tail_(head_.load(boost::memory_order_relaxed)),
+            size_(0), consuming_(false), counted_(false),
+            destinations_(destinations)
+        {}
+
+        pending_parcels_queue(pending_parcels_queue const&) = delete;
+        pending_parcels_queue& operator=(pending_parcels_queue const&) = delete;
+
+        ~pending_parcels_queue()
+        {
+            node* n = tail_;
+            while (n != nullptr)
+            {
+                node* next = n->next_.load(boost::memory_order_relaxed);
+                delete n;
+                n = next;
+            }
+        }
+
+        void push(parcel&& p, Handler&& f)
+        {
+            node* n = new node(std::move(p), std::move(f));
+            link(n, n);
+
+            size_.fetch_add(1, boost::memory_order_acq_rel);
+            count_destination();
+        }
+
+        // Add all given parcels using a single atomic exchange.
+        void push(std::vector<parcel>&& parcels,
+            std::vector<Handler>&& handlers)
+        {
+            HPX_ASSERT(parcels.size() == handlers.size());
+            if (parcels.empty())
+                return;
+
+            node* first =
+                new node(std::move(parcels[0]), std::move(handlers[0]));
+            node* last = first;
+            for (std::size_t i = 1; i != parcels.size(); ++i)
+            {
+                node* n =
+                    new node(std::move(parcels[i]), std::move(handlers[i]));
+                last->next_.store(n, boost::memory_order_relaxed);
+                last = n;
+            }
+            link(first, last);
+
+            size_.fetch_add(static_cast<std::int64_t>(parcels.size()),
+                boost::memory_order_acq_rel);
+            count_destination();
+        }
+
+        // Move all parcels which are currently available into the given
+        // vectors. Returns false if nothing was taken out of the queue, which
+        // is the case as well if another thread is currently doing the same.
+        bool pop_all(std::vector<parcel>& parcels,
+            std::vector<Handler>& handlers)
+        {
+            return pop_all_impl(parcels, handlers, ignore_node());
+        }
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+        // Same as above, additionally returns the time (nanoseconds) each of
+        // the parcels was waiting in this queue.
+        bool pop_all(std::vector<parcel>& parcels,
+            std::vector<Handler>& handlers,
+            std::vector<std::int64_t>& queue_times)
+        {
+            return pop_all_impl(parcels, handlers,
+                collect_queue_time(queue_times));
+        }
+#endif
+
+        // The number of parcels waiting in this queue.
+        std::int64_t size() const
+        {
+            return size_.load(boost::memory_order_acquire);
+        }
+
+        bool empty() const
+        {
+            return size() <= 0;
+        }
+
+    private:
+        template <typename F>
+        bool pop_all_impl(std::vector<parcel>& parcels,
+            std::vector<Handler>& handlers, F const& f)
+        {
+            if (size_.load(boost::memory_order_acquire) == 0 ||
+                consuming_.exchange(true, boost::memory_order_acquire))
+            {
+                return false;
+            }
+
+            std::int64_t count = 0;
+            node* tail = tail_;
+            node* next = tail->next_.load(boost::memory_order_acquire);
+            while (next != nullptr)
+            {
+                // the current tail is a dummy, its successor holds the data
+                f(*next);
+                parcels.push_back(std::move(next->parcel_));
+                handlers.push_back(std::move(next->handler_));
+                delete tail;
+
+                tail = next;
+                next = tail->next_.load(boost::memory_order_acquire);
+                ++count;
+            }
+            tail_ = tail;
+
+            if (count != 0)
+            {
+                // the size is incremented only after the nodes were linked,
+                // it may become negative for a short while
+                size_.fetch_sub(count, boost::memory_order_acq_rel);
+                uncount_destination();
+            }
+
+            consuming_.store(false, boost::memory_order_release);
+            return count != 0;
+        }
+
+        // Called by producers after linking new nodes. The destination is
+        // counted before it is marked, which guarantees that the shared
+        // counter never drops below the number of marked queues.
+        void count_destination()
+        {
+            if (counted_.load())
+                return;
+
+            ++destinations_;
+            if (counted_.exchange(true))
+                --destinations_;            // some other thread was faster
+        }
+
+        // Called by the consumer after taking nodes out of the queue.
+        void uncount_destination()
+        {
+            if (!counted_.exchange(false))
+                return;
+
+            HPX_ASSERT(0 != destinations_.load());
+            --destinations_;
+
+            // A producer which linked new nodes before the mark was cleared
+            // may have seen it still being set, count the destination again
+            // in this case. This pairs with the store in link().
+            if (tail_->next_.load() != nullptr)
+                count_destination();
+        }
+
+        void link(node* first, node* last)
+        {
+            node* prev = head_.exchange(last, boost::memory_order_acq_rel);
+            prev->next_.store(first);
+        }
+
+        boost::atomic<node*> head_;     // producers add here
+        node* tail_;                    // consumers take from here
+
+        boost::atomic<std::int64_t> size_;
+        boost::atomic<bool> consuming_;
+
+        boost::atomic<bool> counted_;   // queue is counted in destinations_
+        boost::atomic<std::uint32_t>& destinations_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The queues of pending parcels for all destinations. Queues are created
+    // on first use and live as long as the parcelport, which makes it safe to
+    // use a queue after the lookup has finished. Any number of threads can
+    // look up queues concurrently, only the creation of a new queue blocks
+    // other threads.
+    template <typename Handler>
+    class pending_parcels_destinations
+    {
+    public:
+        typedef pending_parcels_queue<Handler> queue_type;
+
+    private:
+        typedef std::map<locality, std::unique_ptr<queue_type> > map_type;
+
+        typedef lcos::local::shared_spinlock mutex_type;
+
+    public:
+        pending_parcels_destinations()
+          : num_destinations_(0)
+        {}
+
+        // Return the queue for the given destination, nullptr if nothing was
+        // ever sent there.
+        queue_type* find(locality const& loc) const
+        {
+            boost::shared_lock<mutex_type> l(mtx_);
+            typename map_type::const_iterator it = queues_.find(loc);
+            return it != queues_.end() ? it->second.get() : nullptr;
+        }
+
+        // Return the queue for the given destination, creates it if needed.
+        queue_type& get(locality const& loc)
+        {
+            if (queue_type* q = find(loc))
+                return *q;
+
+            std::lock_guard<mutex_type> l(mtx_);
+            std::unique_ptr<queue_type>& q = queues_[loc];
+            if (!q)
+                q.reset(new queue_type(num_destinations_));
+            return *q;
+        }
+
+        // Return all destinations which have parcels waiting.
+        void non_empty(std::vector<locality>& destinations) const
+        {
+            boost::shared_lock<mutex_type> l(mtx_);
+            for (typename map_type::value_type const& p : queues_)
+            {
+                if (!p.second->empty())
+                    destinations.push_back(p.first);
+            }
+        }
+
+        // Return the overall number of parcels waiting.
+        std::int64_t size() const
+        {
+            boost::shared_lock<mutex_type> l(mtx_);
+            std::int64_t count = 0;
+            for (typename map_type::value_type const& p : queues_)
+            {
+                if (!p.second->empty())
+                    count += p.second->size();
+            }
+            return count;
+        }
+
+        // Return the number of destinations which have parcels waiting.
+        std::uint32_t num_destinations() const
+        {
+            return num_destinations_.load(boost::memory_order_relaxed);
+        }
+
+    private:
+        mutable mutex_type mtx_;
+        boost::atomic<std::uint32_t> num_destinations_;
+        map_type queues_;
+    };
+}}}
+
+#endif
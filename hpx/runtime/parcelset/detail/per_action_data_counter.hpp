@@ -13,11 +13,13 @@
 #include <hpx/lcos/local/spinlock.hpp>
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
+#include <hpx/performance_counters/parcels/log2_histogram.hpp>
 #include <hpx/util/jenkins_hash.hpp>
 
 #include <cstdint>
 #include <string>
 #include <unordered_map>
+#include <vector>
 
 namespace hpx { namespace parcelset { namespace detail
 {
@@ -30,6 +32,9 @@ namespace hpx { namespace parcelset { namespace detail
         void add_data(char const* action,
             performance_counters::parcels::data_point const& data);
 
+        // add the time a parcel was waiting to be sent (nanoseconds)
+        void add_queue_time(char const* action, std::int64_t time);
+
         // retrieve counter data
 
         // number of parcels handled
@@ -44,12 +49,39 @@ namespace hpx { namespace parcelset { namespace detail
         std::int64_t total_bytes(
             std::string const& action, bool reset);
 
+        // histograms of the values above, the values for all actions are
+        // combined if no action is given
+
+        // histogram of the parcel sizes (bytes)
+        std::vector<std::int64_t> bytes_histogram(
+            std::string const& action, bool reset);
+
+        // histogram of the (de-)serialization times (nanoseconds)
+        std::vector<std::int64_t> serialization_time_histogram(
+            std::string const& action, bool reset);
+
+        // histogram of the times parcels were waiting to be sent (nanoseconds)
+        std::vector<std::int64_t> queue_time_histogram(
+            std::string const& action, bool reset);
+
     private:
+        typedef performance_counters::parcels::log2_histogram histogram_type;
+
+        struct action_data
+        {
+            performance_counters::parcels::gatherer_nolock data_;
+            histogram_type bytes_;
+            histogram_type serialization_time_;
+            histogram_type queue_time_;
+        };
+
         typedef std::unordered_map<
-                std::string, performance_counters::parcels::gatherer_nolock,
-                hpx::util::jenkins_hash
+                std::string, action_data, hpx::util::jenkins_hash
             > counter_data_map;
 
+        std::vector<std::int64_t> get_histogram(std::string const& action,
+            histogram_type action_data::* histogram, bool reset);
+
         mutable mutex_type mtx_;
         counter_data_map data_;
     };
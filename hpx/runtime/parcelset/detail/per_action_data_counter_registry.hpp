@@ -34,6 +34,8 @@ namespace hpx { namespace parcelset { namespace detail
 
     public:
         typedef util::function_nonser<std::int64_t(bool)> counter_function_type;
+        typedef util::function_nonser<std::vector<std::int64_t>(bool)>
+            counter_values_function_type;
 
         enum per_action_counter_type
         {
@@ -59,6 +61,12 @@ namespace hpx { namespace parcelset { namespace detail
                 std::int64_t(std::string const&, bool)
             > const& f) const;
 
+        counter_values_function_type get_histogram_counter(
+            std::string const& action,
+            hpx::util::function_nonser<
+                std::vector<std::int64_t>(std::string const&, bool)
+            > const& f) const;
+
         bool counter_discoverer(
             performance_counters::counter_info const& info,
             performance_counters::counter_path_elements& p,
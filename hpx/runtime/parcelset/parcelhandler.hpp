@@ -399,6 +399,14 @@ namespace hpx { namespace parcelset
         // total data received (bytes)
         std::int64_t get_action_data_received(std::string const& pp_type,
             std::string const& action, bool reset) const;
+
+        // histograms collected for each action, see parcelport
+        typedef std::vector<std::int64_t> (parcelport::*action_histogram_type)(
+            std::string const&, bool);
+
+        std::vector<std::int64_t> get_action_histogram(
+            std::string const& pp_type, action_histogram_type histogram,
+            std::string const& action, bool reset) const;
 #endif
 
         //
@@ -442,6 +450,9 @@ namespace hpx { namespace parcelset
 
         void register_counter_types(std::string const& pp_type);
         void register_connection_cache_counter_types(std::string const& pp_type);
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+        void register_histogram_counter_types(std::string const& pp_type);
+#endif
 
     private:
         int get_priority(std::string const& name) const
@@ -15,6 +15,7 @@
 #include <hpx/performance_counters/parcels/data_point.hpp>
 #include <hpx/performance_counters/parcels/gatherer.hpp>
 #include <hpx/runtime/applier_fwd.hpp>
+#include <hpx/runtime/parcelset/detail/pending_parcels_queue.hpp>
 #include <hpx/runtime/parcelset/detail/per_action_data_counter.hpp>
 #include <hpx/runtime/parcelset/locality.hpp>
 #include <hpx/runtime/parcelset/parcel.hpp>
@@ -37,10 +38,6 @@
 
 #include <hpx/config/warnings_prefix.hpp>
 
-#if defined(HPX_GCC_VERSION) && HPX_GCC_VERSION < 40900
-#define HPX_PARCELSET_PENDING_PARCELS_WORKAROUND
-#endif
-
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace agas
 {
@@ -274,6 +271,23 @@ namespace hpx { namespace parcelset
         // total data received (bytes)
         std::int64_t get_action_data_received(
             std::string const&, bool reset);
+
+        // histograms of the sizes of the parcels sent and received
+        std::vector<std::int64_t> get_action_data_sent_histogram(
+            std::string const&, bool reset);
+        std::vector<std::int64_t> get_action_data_received_histogram(
+            std::string const&, bool reset);
+
+        // histograms of the times needed for (de-)serializing parcels
+        std::vector<std::int64_t> get_action_sending_serialization_time_histogram(
+            std::string const&, bool reset);
+        std::vector<std::int64_t>
+            get_action_receiving_serialization_time_histogram(
+                std::string const&, bool reset);
+
+        // histogram of the times parcels were waiting to be sent
+        std::vector<std::int64_t> get_action_queue_time_histogram(
+            std::string const&, bool reset);
 #endif
 
         ///////////////////////////////////////////////////////////////////////
@@ -295,6 +309,8 @@ namespace hpx { namespace parcelset
 
         void add_sent_data(char const* action,
             performance_counters::parcels::data_point const& data);
+
+        void add_sent_queue_time(char const* action, std::int64_t time);
 #endif
 
         /// Return the configured maximal allowed message data size
@@ -335,30 +351,14 @@ namespace hpx { namespace parcelset
             parcel const & p);
 
     protected:
-        /// mutex for all of the member data
+        /// mutex for the member data of derived parcelports
         mutable lcos::local::spinlock mtx_;
 
         hpx::applier::applier *applier_;
 
         /// The cache for pending parcels
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-        typedef util::tuple<
-            std::shared_ptr<std::vector<parcel> >
-          , std::vector<write_handler_type>
-        >
-#else
-        typedef util::tuple<
-            std::vector<parcel>
-          , std::vector<write_handler_type>
-        >
-#endif
-            map_second_type;
-        typedef std::map<locality, map_second_type> pending_parcels_map;
-        pending_parcels_map pending_parcels_;
-
-        typedef std::set<locality> pending_parcels_destinations;
-        pending_parcels_destinations parcel_destinations_;
-        boost::atomic<std::uint32_t> num_parcel_destinations_;
+        detail::pending_parcels_destinations<write_handler_type>
+            pending_parcels_;
 
         /// The local locality
         locality here_;
@@ -560,157 +560,67 @@ namespace hpx { namespace parcelset
         void enqueue_parcel(locality const& locality_id,
             parcel&& p, write_handler_type&& f)
         {
-            typedef pending_parcels_map::mapped_type mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
-            mapped_type& e = pending_parcels_[locality_id];
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-            if(!util::get<0>(e))
-                util::get<0>(e) = std::make_shared<std::vector<parcel> >();
-            util::get<0>(e)->push_back(std::move(p));
-#else
-            util::get<0>(e).push_back(std::move(p));
-#endif
-            util::get<1>(e).push_back(std::move(f));
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            // Adding the parcel to the queue does not acquire any lock. The
+            // destination is counted only if its queue was empty before.
+            pending_parcels_.get(locality_id).push(std::move(p), std::move(f));
         }
 
         void enqueue_parcels(locality const& locality_id,
             std::vector<parcel>&& parcels,
             std::vector<write_handler_type>&& handlers)
         {
-            typedef pending_parcels_map::mapped_type mapped_type;
-
-            std::unique_lock<lcos::local::spinlock> l(mtx_);
-            // We ignore the lock here. It might happen that while enqueuing,
-            // we need to acquire a lock. This should not cause any problems
-            // (famous last words)
-            util::ignore_while_checking<
-                std::unique_lock<lcos::local::spinlock>
-            > il(&l);
-
             HPX_ASSERT(parcels.size() == handlers.size());
 
-            mapped_type& e = pending_parcels_[locality_id];
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-            if(!util::get<0>(e))
-            {
-                util::get<0>(e) = std::make_shared<std::vector<parcel> >();
-                HPX_ASSERT(util::get<1>(e).empty());
-                std::swap(*util::get<0>(e), parcels);
-                std::swap(util::get<1>(e), handlers);
-            }
-#else
-            if (util::get<0>(e).empty())
-            {
-                HPX_ASSERT(util::get<1>(e).empty());
-                std::swap(util::get<0>(e), parcels);
-                std::swap(util::get<1>(e), handlers);
-            }
-#endif
-            else
-            {
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-                HPX_ASSERT(util::get<0>(e)->size() == util::get<1>(e).size());
-                std::size_t new_size = util::get<0>(e)->size() + parcels.size();
-                util::get<0>(e)->reserve(new_size);
-
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(*util::get<0>(e)));
-#else
-                HPX_ASSERT(util::get<0>(e).size() == util::get<1>(e).size());
-                std::size_t new_size = util::get<0>(e).size() + parcels.size();
-                util::get<0>(e).reserve(new_size);
-
-                std::move(parcels.begin(), parcels.end(),
-                    std::back_inserter(util::get<0>(e)));
-#endif
-                util::get<1>(e).reserve(new_size);
-                std::move(handlers.begin(), handlers.end(),
-                    std::back_inserter(util::get<1>(e)));
-            }
-
-            parcel_destinations_.insert(locality_id);
-            ++num_parcel_destinations_;
+            pending_parcels_.get(locality_id).push(
+                std::move(parcels), std::move(handlers));
         }
 
         bool dequeue_parcels(locality const& locality_id,
             std::vector<parcel>& parcels,
             std::vector<write_handler_type>& handlers)
         {
-            typedef pending_parcels_map::iterator iterator;
+            typedef detail::pending_parcels_destinations<
+                    write_handler_type
+                >::queue_type queue_type;
 
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
+            // do nothing if parcels have already been picked up by
+            // another thread
+            queue_type* q = pending_parcels_.find(locality_id);
+            if (q == nullptr)
+                return false;
 
-                if (!l) return false;
+            HPX_ASSERT(parcels.empty() && handlers.empty());
 
-                iterator it = pending_parcels_.find(locality_id);
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+            std::vector<std::int64_t> queue_times;
+            if (!q->pop_all(parcels, handlers, queue_times))
+                return false;
 
-                // do nothing if parcels have already been picked up by
-                // another thread
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-                if (it != pending_parcels_.end() && !util::get<0>(it->second)->empty())
-#else
-                if (it != pending_parcels_.end() && !util::get<0>(it->second).empty())
-#endif
-                {
-                    HPX_ASSERT(it->first == locality_id);
-                    HPX_ASSERT(handlers.size() == parcels.size());
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-                    std::swap(parcels, *util::get<0>(it->second));
+            HPX_ASSERT(queue_times.size() == parcels.size());
+            for (std::size_t i = 0; i != parcels.size(); ++i)
+            {
+                this->add_sent_queue_time(
+                    parcels[i].get_action()->get_action_name(),
+                    queue_times[i]);
+            }
 #else
-                    std::swap(parcels, util::get<0>(it->second));
+            if (!q->pop_all(parcels, handlers))
+                return false;
 #endif
-                    std::swap(handlers, util::get<1>(it->second));
-
-                    HPX_ASSERT(!handlers.empty());
-                }
-                else
-                {
-                    HPX_ASSERT(util::get<1>(it->second).empty());
-                    return false;
-                }
 
-                parcel_destinations_.erase(locality_id);
+            HPX_ASSERT(!handlers.empty());
+            HPX_ASSERT(handlers.size() == parcels.size());
 
-                HPX_ASSERT(0 != num_parcel_destinations_.load());
-                --num_parcel_destinations_;
-
-                return true;
-            }
+            return true;
         }
 
         bool trigger_pending_work()
         {
-            if (0 == num_parcel_destinations_.load(boost::memory_order_relaxed))
+            if (0 == pending_parcels_.num_destinations())
                 return true;
 
             std::vector<locality> destinations;
-
-            {
-                std::unique_lock<lcos::local::spinlock> l(mtx_, std::try_to_lock);
-                if(l.owns_lock())
-                {
-                    if (parcel_destinations_.empty())
-                        return true;
-
-                    destinations.reserve(parcel_destinations_.size());
-                    for (locality const& loc : parcel_destinations_)
-                    {
-                        destinations.push_back(loc);
-                    }
-                }
-            }
+            pending_parcels_.non_empty(destinations);
 
             // Create new HPX threads which send the parcels that are still
             // pending.
@@ -835,6 +745,16 @@ namespace hpx { namespace parcelset
 #endif
             if (!ec)
             {
+                // Send the parcels which were queued for this destination
+                // while the write was in flight directly over this
+                // connection, this avoids going through the connection cache.
+                if (connection_handler_traits<ConnectionHandler>::
+                        send_pending_on_connection::value &&
+                    schedule_send_on_connection(locality_id, sender_connection))
+                {
+                    return;
+                }
+
                 // Give this connection back to the cache as it's not
                 // needed anymore.
                 connection_cache_.reclaim(locality_id, sender_connection);
@@ -844,25 +764,85 @@ namespace hpx { namespace parcelset
                 // remove this connection from cache
                 connection_cache_.clear(locality_id, sender_connection);
             }
-            {
-                std::lock_guard<lcos::local::spinlock> l(mtx_);
 
-                HPX_ASSERT(locality_id == sender_connection->destination());
-                pending_parcels_map::iterator it = pending_parcels_.find(locality_id);
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-                if (it == pending_parcels_.end() ||
-                    (util::get<0>(it->second) && util::get<0>(it->second)->empty()))
-#else
-                if (it == pending_parcels_.end() || util::get<0>(it->second).empty())
-#endif
-                    return;
-            }
+            HPX_ASSERT(locality_id == sender_connection->destination());
+            typedef detail::pending_parcels_destinations<
+                    write_handler_type
+                >::queue_type queue_type;
+
+            queue_type* q = pending_parcels_.find(locality_id);
+            if (q == nullptr || q->empty())
+                return;
 
             // Create a new HPX thread which sends parcels that are still
             // pending.
             get_connection_and_send_parcels(locality_id);
         }
 
+        // Create an HPX thread which sends the parcels pending for the given
+        // destination over the given connection. This keeps the encoding of
+        // the parcels off the io_service thread which completed the write.
+        bool schedule_send_on_connection(locality const& locality_id,
+            std::shared_ptr<connection> const& sender_connection)
+        {
+            typedef detail::pending_parcels_destinations<
+                    write_handler_type
+                >::queue_type queue_type;
+
+            queue_type* q = pending_parcels_.find(locality_id);
+            if (q == nullptr || q->empty())
+                return false;
+
+            // the connection is neither cached nor writing, make sure the
+            // parcelport does not shut down before the thread has run
+            ++operations_in_flight_;
+
+            error_code ec(lightweight);
+            hpx::applier::register_thread_nullary(
+                util::bind(
+                    &parcelport_impl::send_pending_on_connection,
+                    this, locality_id, sender_connection),
+                "send_pending_on_connection",
+                threads::pending, true, threads::thread_priority_boost,
+                get_next_num_thread(), threads::thread_stacksize_default,
+                ec);
+            if (!ec)
+                return true;
+
+            --operations_in_flight_;
+            return false;
+        }
+
+        void send_pending_on_connection(locality const& locality_id,
+            std::shared_ptr<connection> const& sender_connection)
+        {
+            std::vector<parcel> parcels;
+            std::vector<write_handler_type> handlers;
+            if (dequeue_parcels(locality_id, parcels, handlers))
+            {
+                send_pending_parcels(locality_id, sender_connection,
+                    std::move(parcels), std::move(handlers));
+            }
+            else
+            {
+                // the parcels have been picked up by another thread already
+                connection_cache_.reclaim(locality_id, sender_connection);
+
+                // parcels which were queued after the dequeue attempt above
+                // would not be sent before the next parcel arrives
+                typedef detail::pending_parcels_destinations<
+                        write_handler_type
+                    >::queue_type queue_type;
+
+                queue_type* q = pending_parcels_.find(locality_id);
+                if (q != nullptr && !q->empty())
+                    get_connection_and_send_parcels(locality_id);
+            }
+
+            HPX_ASSERT(operations_in_flight_ != 0);
+            --operations_in_flight_;
+        }
+
         void send_pending_parcels(
             parcelset::locality const & parcel_locality_id,
             std::shared_ptr<connection> sender_connection,
@@ -0,0 +1,91 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#ifndef HPX_PARCELSET_RECEIVE_CHUNK_HPP
+#define HPX_PARCELSET_RECEIVE_CHUNK_HPP
+
+#include <hpx/config.hpp>
+#include <hpx/util/function.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace parcelset
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// The type of the function used by the parcelports to allocate the
+    /// memory a received zero-copy chunk is placed in.
+    typedef util::function_nonser<std::shared_ptr<char>(std::size_t)>
+        receive_chunk_allocator_type;
+
+    /// Install the function used to allocate the memory for all zero-copy
+    /// chunks received from now on, returns the previously installed one. An
+    /// empty function re-installs the default allocator (operator new[]).
+    ///
+    /// Objects which support this (e.g. serialization::serialize_buffer<T>)
+    /// take over the received memory during de-serialization instead of
+    /// copying it. This allows for large arguments to end up in
+    /// pre-registered or pooled memory with a single copy only.
+    ///
+    /// The allocator is used for the chunks of all actions. The memory is
+    /// allocated while a message is being received, i.e. before its parcels
+    /// are decoded, and a single (coalesced) message may carry the parcels
+    /// of several actions. The allocator has to hand out memory suitable for
+    /// any of the received chunks, it may select a pool based on the size.
+    HPX_API_EXPORT receive_chunk_allocator_type set_receive_chunk_allocator(
+        receive_chunk_allocator_type const& f);
+
+    /// Allocate the memory for a received zero-copy chunk of the given size
+    HPX_API_EXPORT std::shared_ptr<char> allocate_receive_chunk(
+        std::size_t size);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The buffer holding a zero-copy chunk on the receiving side. It can be
+    /// used as the chunk type of a parcelset::parcel_buffer in place of a
+    /// std::vector<char>.
+    class receive_chunk
+    {
+    public:
+        receive_chunk()
+          : size_(0)
+        {}
+
+        // Always allocate new memory, the previously received data might
+        // still be referenced by de-serialized objects.
+        void resize(std::size_t size)
+        {
+            data_ = allocate_receive_chunk(size);
+            size_ = size;
+        }
+
+        char* data() const { return data_.get(); }
+        std::size_t size() const { return size_; }
+
+        std::shared_ptr<char> const& owner() const { return data_; }
+
+    private:
+        std::shared_ptr<char> data_;
+        std::size_t size_;
+    };
+
+    namespace detail
+    {
+        // Return the object owning the memory of a received chunk, this is
+        // empty for chunk types which don't allow to take over their memory.
+        template <typename Chunk>
+        std::shared_ptr<char> get_chunk_owner(Chunk const&)
+        {
+            return std::shared_ptr<char>();
+        }
+
+        inline std::shared_ptr<char> get_chunk_owner(receive_chunk const& c)
+        {
+            return c.owner();
+        }
+    }
+}}
+
+#endif
@@ -70,13 +70,7 @@ namespace hpx { namespace serialization
                     typename std::remove_const<T>::type
                 >::value> use_optimized;
 
-#ifdef BOOST_BIG_ENDIAN
-            bool archive_endianess_differs = ar.endian_little();
-#else
-            bool archive_endianess_differs = ar.endian_big();
-#endif
-
-            if (ar.disable_array_optimization() || archive_endianess_differs)
+            if (ar.disable_array_optimization() || ar.endianess_differs())
                 serialize_optimized(ar, v, std::false_type());
             else
                 serialize_optimized(ar, v, use_optimized());
@@ -50,6 +50,7 @@ namespace hpx { namespace serialization
         basic_archive(std::uint32_t flags)
           : flags_(flags)
           , size_(0)
+          , endianess_differs_(compute_endianess_differs(flags))
         {}
 
         virtual ~basic_archive()
@@ -81,6 +82,15 @@ namespace hpx { namespace serialization
             return (flags_ & hpx::serialization::endian_little) ? true : false;
         }
 
+        // Return whether the byte order of the archive differs from the one
+        // of this machine. This is determined once per archive, bitwise
+        // serialization has to fall back to element-wise serialization if
+        // this is true.
+        bool endianess_differs() const
+        {
+            return endianess_differs_;
+        }
+
         bool disable_array_optimization() const
         {
             return (flags_ & hpx::serialization::disable_array_optimization) ?
@@ -127,8 +137,24 @@ namespace hpx { namespace serialization
         }
 
     protected:
+        void set_flags(std::uint32_t flags)
+        {
+            flags_ = flags;
+            endianess_differs_ = compute_endianess_differs(flags);
+        }
+
+        static bool compute_endianess_differs(std::uint32_t flags)
+        {
+#ifdef BOOST_BIG_ENDIAN
+            return (flags & hpx::serialization::endian_little) ? true : false;
+#else
+            return (flags & hpx::serialization::endian_big) ? true : false;
+#endif
+        }
+
         std::uint32_t flags_;
         std::size_t size_;
+        bool endianess_differs_;
     };
 
     template <typename Archive>
@@ -15,6 +15,8 @@
 
 namespace hpx { namespace serialization
 {
+    struct erased_output_container;
+
     ///////////////////////////////////////////////////////////////////////////
     // Base class for all serialization filters.
     struct binary_filter
@@ -25,6 +27,12 @@ namespace hpx { namespace serialization
         virtual bool flush(void* dst, std::size_t dst_count,
             std::size_t& written) = 0;
 
+        // Filters which produce (part of) their output while the data is
+        // being saved may hand it to the given container right away (see
+        // erased_output_container::save_filtered_binary) instead of keeping
+        // it until flush() is called.
+        virtual void set_output(erased_output_container* /*output*/) {}
+
         // decompression API
         virtual std::size_t init_data(char const* buffer,
             std::size_t size, std::size_t buffer_size) = 0;
@@ -15,6 +15,7 @@
 #include <hpx/util/assert.hpp>
 
 #include <cstddef>
+#include <memory>
 
 namespace hpx { namespace serialization
 {
@@ -32,6 +33,9 @@ namespace hpx { namespace serialization
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void save_binary(void const* address, std::size_t count) = 0;
         virtual void save_binary_chunk(void const* address, std::size_t count) = 0;
+        // store data produced by the binary filter, this bypasses the filter
+        virtual void save_filtered_binary(
+            void const* address, std::size_t count) = 0;
         virtual void reset() = 0;
         virtual std::size_t get_num_chunks() const = 0;
         virtual void flush() = 0;
@@ -45,6 +49,11 @@ namespace hpx { namespace serialization
         virtual void set_filter(binary_filter* filter) = 0;
         virtual void load_binary(void * address, std::size_t count) = 0;
         virtual void load_binary_chunk(void * address, std::size_t count) = 0;
+        virtual std::shared_ptr<char> adopt_binary_chunk(
+            std::size_t /*count*/, std::size_t /*alignment*/)
+        {
+            return std::shared_ptr<char>();
+        }
     };
 }}
 
@@ -42,9 +42,11 @@ namespace hpx { namespace serialization
         template <typename Container>
         input_archive(Container & buffer,
             std::size_t inbound_data_size = 0,
-            const std::vector<serialization_chunk>* chunks = nullptr)
+            const std::vector<serialization_chunk>* chunks = nullptr,
+            const std::vector<std::shared_ptr<char> >* chunk_owners = nullptr)
           : base_type(0U)
-          , buffer_(new input_container<Container>(buffer, chunks, inbound_data_size))
+          , buffer_(new input_container<Container>(buffer, chunks,
+                inbound_data_size, chunk_owners))
         {
             // endianness needs to be saves separately as it is needed to
             // properly interpret the flags
@@ -53,13 +55,13 @@ namespace hpx { namespace serialization
             std::uint64_t endianess = 0ul;
             load(endianess);
             if (endianess)
-                this->base_type::flags_ = hpx::serialization::endian_big;
+                this->base_type::set_flags(hpx::serialization::endian_big);
 
             // load flags sent by the other end to make sure both ends have
             // the same assumptions about the archive format
             std::uint32_t flags = 0;
             load(flags);
-            this->base_type::flags_ = flags;
+            this->base_type::set_flags(flags);
 
             bool has_filter = false;
             load(has_filter);
@@ -134,6 +136,8 @@ namespace hpx { namespace serialization
         friend struct basic_archive<input_archive>;
         template <class T>
         friend class array;
+        template <typename T, typename Allocator>
+        friend class serialize_buffer;
 
         template <typename T>
         void load_bitwise(T & t, std::false_type)
@@ -147,7 +151,7 @@ namespace hpx { namespace serialization
         {
             static_assert(!std::is_abstract<T>::value,
                 "Can not bitwise serialize a class that is abstract");
-            if(disable_array_optimization())
+            if(disable_array_optimization() || endianess_differs())
             {
                 access::serialize(*this, t, 0);
             }
@@ -227,13 +231,8 @@ namespace hpx { namespace serialization
             char* cptr = reinterpret_cast<char *>(&l); //-V206
             load_binary(cptr, static_cast<std::size_t>(size));
 
-#ifdef BOOST_BIG_ENDIAN
-            if (endian_little())
+            if (endianess_differs())
                 reverse_bytes(size, cptr);
-#else
-            if (endian_big())
-                reverse_bytes(size, cptr);
-#endif
         }
 
         void load_binary(void * address, std::size_t count)
@@ -257,6 +256,23 @@ namespace hpx { namespace serialization
             size_ += count;
         }
 
+        // Take over the memory of the next zero-copy chunk instead of
+        // copying it, returns an empty pointer if this is not possible. In
+        // this case the data has to be loaded using load_binary_chunk.
+        std::shared_ptr<char> adopt_binary_chunk(std::size_t count,
+            std::size_t alignment)
+        {
+            if (0 == count || disable_data_chunking())
+                return std::shared_ptr<char>();
+
+            std::shared_ptr<char> data =
+                buffer_->adopt_binary_chunk(count, alignment);
+            if (data)
+                size_ += count;
+
+            return data;
+        }
+
         // make functions visible through adl
         friend void register_pointer(input_archive& ar,
                 std::uint64_t pos, detail::ptr_helper_ptr helper)
@@ -55,15 +55,20 @@ namespace hpx { namespace serialization
 
         input_container(Container const& cont,
                 std::vector<serialization_chunk> const* chunks,
-                std::size_t inbound_data_size)
+                std::size_t inbound_data_size,
+                std::vector<std::shared_ptr<char> > const* chunk_owners = nullptr)
           : cont_(cont), current_(0), filter_(),
             decompressed_size_(inbound_data_size),
-            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0)
+            chunks_(nullptr), current_chunk_(std::size_t(-1)), current_chunk_size_(0),
+            chunk_owners_(nullptr)
         {
             if (chunks && chunks->size() != 0)
             {
                 chunks_ = chunks;
                 current_chunk_ = 0;
+
+                if (chunk_owners && chunk_owners->size() == chunks->size())
+                    chunk_owners_ = chunk_owners;
             }
         }
 
@@ -155,6 +160,35 @@ namespace hpx { namespace serialization
             }
         }
 
+        std::shared_ptr<char> adopt_binary_chunk(std::size_t count,
+            std::size_t alignment) // override
+        {
+            // the memory of a chunk can be handed out only if the parcelport
+            // has told us who owns it
+            if (filter_.get() || chunk_owners_ == nullptr ||
+                count < HPX_ZERO_COPY_SERIALIZATION_THRESHOLD)
+            {
+                return std::shared_ptr<char>();
+            }
+
+            HPX_ASSERT(current_chunk_ != std::size_t(-1));
+            HPX_ASSERT(get_chunk_type(current_chunk_) == chunk_type_pointer);
+
+            std::shared_ptr<char> const& owner =
+                (*chunk_owners_)[current_chunk_];
+            char* data = static_cast<char*>(get_chunk_data(current_chunk_).pos_);
+
+            if (!owner || get_chunk_size(current_chunk_) != count ||
+                reinterpret_cast<std::uintptr_t>(data) % alignment != 0)
+            {
+                // let load_binary_chunk handle this chunk
+                return std::shared_ptr<char>();
+            }
+
+            ++current_chunk_;
+            return std::shared_ptr<char>(owner, data);
+        }
+
         Container const& cont_;
         std::size_t current_;
         std::unique_ptr<binary_filter> filter_;
@@ -163,6 +197,8 @@ namespace hpx { namespace serialization
         std::vector<serialization_chunk> const* chunks_;
         std::size_t current_chunk_;
         std::size_t current_chunk_size_;
+
+        std::vector<std::shared_ptr<char> > const* chunk_owners_;
     };
 }}
 
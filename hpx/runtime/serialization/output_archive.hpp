@@ -187,7 +187,7 @@ namespace hpx { namespace serialization
         {
             static_assert(!std::is_abstract<T>::value,
                 "Can not bitwise serialize a class that is abstract");
-            if(disable_array_optimization())
+            if(disable_array_optimization() || endianess_differs())
             {
                 access::serialize(*this, t, 0);
             }
@@ -262,13 +262,8 @@ namespace hpx { namespace serialization
         {
             const std::size_t size = sizeof(Promoted);
             char* cptr = reinterpret_cast<char *>(&l); //-V206
-#ifdef BOOST_BIG_ENDIAN
-            if(endian_little())
+            if(endianess_differs())
                 reverse_bytes(size, cptr);
-#else
-            if(endian_big())
-                reverse_bytes(size, cptr);
-#endif
 
             save_binary(cptr, size);
         }
@@ -16,6 +16,7 @@
 #include <hpx/runtime/serialization/serialization_chunk.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <algorithm>
 #include <cstddef> // for size_t
 #include <cstdint>
 #include <cstring> // for memcpy
@@ -218,7 +219,7 @@ namespace hpx { namespace serialization
         output_container(Container& cont,
             std::vector<serialization_chunk>* chunks,
             binary_filter* filter)
-            : cont_(cont), current_(0), start_compressing_at_(0), filter_(nullptr),
+            : cont_(cont), current_(0), filtered_end_(0), filter_(nullptr),
               chunker_(detail::create_chunker(chunks))
         {
             chunker_->reset();
@@ -232,9 +233,12 @@ namespace hpx { namespace serialization
             if (filter_) {
                 std::size_t written = 0;
 
-                if (cont_.size() < current_)
-                    cont_.resize(current_);
-                current_ = start_compressing_at_;
+                // the remaining filtered data is appended to whatever the
+                // filter has stored already while saving
+                std::size_t const size = (std::max)(current_, filtered_end_ + 1);
+                if (cont_.size() < size)
+                    cont_.resize(size);
+                current_ = filtered_end_;
 
                 do {
                     bool flushed = detail::access_data<Container>::flush(
@@ -250,6 +254,7 @@ namespace hpx { namespace serialization
                 } while (true);
 
                 cont_.resize(current_);         // truncate container
+                filter_->set_output(nullptr);
             }
             else {
                 HPX_ASSERT(
@@ -305,11 +310,25 @@ namespace hpx { namespace serialization
         {
             HPX_ASSERT(nullptr == filter_);
             filter_ = filter;
-            start_compressing_at_ = current_;
+            filtered_end_ = current_;
 
             HPX_ASSERT(chunker_->get_num_chunks() == 1 &&
                 chunker_->get_chunk_size() == 0);
             chunker_->reset();
+
+            filter_->set_output(this);
+        }
+
+        void save_filtered_binary(void const* address, std::size_t count) // override
+        {
+            HPX_ASSERT(filter_ && count != 0);
+
+            if (cont_.size() < filtered_end_ + count)
+                cont_.resize(filtered_end_ + count);
+
+            detail::access_data<Container>::write(
+                cont_, count, filtered_end_, address);
+            filtered_end_ += count;
         }
 
         void save_binary(void const* address, std::size_t count) // override
@@ -371,7 +390,7 @@ namespace hpx { namespace serialization
 
         Container& cont_;
         std::size_t current_;
-        std::size_t start_compressing_at_;
+        std::size_t filtered_end_;
         binary_filter* filter_;
 
         std::unique_ptr<detail::basic_chunker> chunker_;
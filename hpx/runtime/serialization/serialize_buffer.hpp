@@ -11,6 +11,7 @@
 #include <hpx/runtime/serialization/array.hpp>
 #include <hpx/runtime/serialization/serialize.hpp>
 #include <hpx/throw_exception.hpp>
+#include <hpx/traits/is_bitwise_serializable.hpp>
 #include <hpx/traits/supports_streaming_with_any.hpp>
 #include <hpx/util/bind.hpp>
 
@@ -18,6 +19,7 @@
 
 #include <algorithm>
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 
 namespace hpx { namespace serialization
@@ -253,12 +255,46 @@ namespace hpx { namespace serialization
         }
 
         ///////////////////////////////////////////////////////////////////////
+        // Take over the memory of a received zero-copy chunk, this is
+        // possible only if the data would have been loaded by a single
+        // load_binary_chunk and if it doesn't have to come from alloc_.
+        typedef std::integral_constant<bool,
+                hpx::traits::is_bitwise_serializable<T>::value &&
+                std::is_same<Allocator, std::allocator<T> >::value
+            > can_adopt_chunk;
+
+        template <typename Archive>
+        bool adopt_chunk(Archive&, std::false_type)
+        {
+            return false;
+        }
+
+        template <typename Archive>
+        bool adopt_chunk(Archive& ar, std::true_type)
+        {
+            if (ar.disable_array_optimization() || ar.endianess_differs())
+                return false;
+
+            std::shared_ptr<char> chunk =
+                ar.adopt_binary_chunk(size_ * sizeof(T), alignof(T));
+            if (!chunk)
+                return false;
+
+            // the deleter keeps the chunk alive
+            data_.reset(reinterpret_cast<T*>(chunk.get()),
+                [chunk](T*) {});
+            return true;
+        }
+
         template <typename Archive>
         void load(Archive& ar, const unsigned int version)
         {
             using util::placeholders::_1;
             ar >> size_ >> alloc_; //-V128
 
+            if (size_ != 0 && adopt_chunk(ar, can_adopt_chunk()))
+                return;
+
             data_.reset(alloc_.allocate(size_),
                 util::bind(&serialize_buffer::deleter<allocator_type>, _1,
                     alloc_, size_));
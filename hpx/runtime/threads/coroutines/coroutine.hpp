@@ -134,7 +134,10 @@ namespace hpx { namespace threads { namespace coroutines
             m_pimpl->bind_args(&arg);
             m_pimpl->bind_result_pointer(&ptr);
 
-            m_pimpl->invoke();
+            if (m_pimpl->is_stackless())
+                m_pimpl->invoke_stackless();
+            else
+                m_pimpl->invoke();
 
             return std::move(*m_pimpl->result());
         }
@@ -187,6 +190,8 @@ namespace hpx { namespace threads { namespace coroutines
         std::ptrdiff_t get_available_stack_space()
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+            if (m_pimpl->is_stackless())
+                return (std::numeric_limits<std::ptrdiff_t>::max)();
             return m_pimpl->get_available_stack_space();
 #else
             return (std::numeric_limits<std::ptrdiff_t>::max)();
@@ -145,6 +145,9 @@ namespace hpx { namespace threads { namespace coroutines
             /**
              * Create a context that on restore invokes Functor on
              *  a new stack. The stack size can be optionally specified.
+             *  A stack size of zero creates a context without a stack of
+             *  its own (used for stackless coroutines), such a context
+             *  must never be switched to.
              */
             template<typename Functor>
             x86_linux_context_impl(Functor& cb, std::ptrdiff_t stack_size = -1)
@@ -161,7 +164,10 @@ namespace hpx { namespace threads { namespace coroutines
                             % m_stack_size % EXEC_PAGESIZE));
                 }
 
-                if (0 >= m_stack_size)
+                if (0 == m_stack_size)
+                    return;
+
+                if (0 > m_stack_size)
                 {
                     throw std::runtime_error(
                         boost::str(boost::format("stack size of %1% is invalid") %
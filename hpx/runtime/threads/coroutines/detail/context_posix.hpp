@@ -213,11 +213,16 @@ namespace hpx { namespace threads { namespace coroutines
             explicit ucontext_context_impl(Functor & cb, std::ptrdiff_t stack_size)
               : m_stack_size(stack_size == -1 ? (std::ptrdiff_t)default_stack_size
                     : stack_size),
-                m_stack(alloc_stack(m_stack_size)),
+                m_stack(m_stack_size != 0 ? alloc_stack(m_stack_size) : nullptr),
                 cb_(&cb)
             {
-                HPX_ASSERT(m_stack);
                 funp_ = &trampoline<Functor>;
+
+                // a stack size of zero creates a context without a stack
+                if (0 == m_stack_size)
+                    return;
+
+                HPX_ASSERT(m_stack);
                 int error = HPX_COROUTINE_MAKE_CONTEXT(
                     &m_ctx, m_stack, m_stack_size, funp_, cb_, nullptr);
                 HPX_UNUSED(error);
@@ -195,16 +195,18 @@ namespace hpx { namespace threads { namespace coroutines
             /**
              * Create a context that on restore invokes Functor on
              *  a new stack. The stack size can be optionally specified.
+             *  Fibers always need a stack, contexts requested without one
+             *  (stack size of zero) get the minimal default stack.
              */
             template<typename Functor>
             explicit fibers_context_impl(Functor& cb, std::ptrdiff_t stack_size)
               : fibers_context_impl_base(
-                    CreateFiberEx(stack_size == -1 ? default_stack_size : stack_size,
-                        stack_size == -1 ? default_stack_size : stack_size, 0,
+                    CreateFiberEx(stack_size <= 0 ? default_stack_size : stack_size,
+                        stack_size <= 0 ? default_stack_size : stack_size, 0,
                         static_cast<LPFIBER_START_ROUTINE>(&trampoline<Functor>),
                         static_cast<LPVOID>(&cb))
                     ),
-                stacksize_(stack_size == -1 ? default_stack_size : stack_size)
+                stacksize_(stack_size <= 0 ? default_stack_size : stack_size)
             {
                 if (0 == m_ctx)
                 {
@@ -47,6 +47,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 namespace hpx { namespace threads { namespace coroutines { namespace detail
@@ -71,21 +72,22 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         typedef boost::intrusive_ptr<coroutine_impl> pointer;
 
+        // Stackless coroutines (thread_stacksize_nostack) are executed on the
+        // stack of the invoking OS thread, their context does not own a
+        // stack (stack size of zero).
         coroutine_impl(functor_type&& f, thread_id_repr_type id,
             std::ptrdiff_t stack_size)
-          : context_base(*this, stack_size, id)
+          : context_base(*this,
+                stack_size == std::ptrdiff_t(thread_stacksize_nostack) ?
+                    std::ptrdiff_t(0) : stack_size, id)
           , m_result_last(std::make_pair(thread_state_enum::unknown, nullptr))
           , m_arg(nullptr)
           , m_result(nullptr)
           , m_fun(std::move(f))
+          , m_stackless(stack_size == std::ptrdiff_t(thread_stacksize_nostack))
         {}
 
-        ~coroutine_impl()
-#if defined(HPX_DEBUG)
-            ;
-#else
-        {}
-#endif
+        HPX_EXPORT ~coroutine_impl();
 
         static inline coroutine_impl* create(
             functor_type&& f, thread_id_repr_type id = nullptr,
@@ -123,6 +125,19 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         HPX_EXPORT void operator()();
 
+        // Run the bound function to completion directly on the stack of the
+        // calling thread (stackless coroutines only). This has the same
+        // semantics as invoke().
+        HPX_EXPORT void invoke_stackless();
+
+        bool is_stackless() const
+        {
+            return m_stackless;
+        }
+
+        // Cause this coroutine to exit, see context_base::exit().
+        HPX_EXPORT void exit() HPX_NOEXCEPT;
+
     public:
         result_type * result()
         {
@@ -160,6 +175,9 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         }
 #endif
 
+        // Note: reset_stack() releases the stack memory only if the stack
+        // has been used deeply (past its watermark) since it was last reset,
+        // in all other cases it is cheap.
         void reset()
         {
             this->reset_stack();
@@ -174,6 +192,13 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
             this->super_type::rebind_base(id);
         }
 
+        // statistics of the pools of coroutine objects (and their stacks)
+        static HPX_EXPORT std::uint64_t get_stack_pool_hit_count(bool reset);
+        static HPX_EXPORT std::uint64_t get_stack_pool_miss_count(bool reset);
+        static HPX_EXPORT std::uint64_t get_stack_pool_release_count(bool reset);
+        static HPX_EXPORT std::uint64_t get_stack_pool_reserved_bytes(
+            bool reset);
+
     private:
         static HPX_EXPORT coroutine_impl* allocate(
             thread_id_repr_type id, std::ptrdiff_t stacksize);
@@ -186,6 +211,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         result_type** m_result;
 
         functor_type m_fun;
+        bool const m_stackless;
     };
 }}}}
 
@@ -33,6 +33,7 @@
 #include <hpx/runtime/threads/coroutines/detail/coroutine_accessor.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
 #include <hpx/runtime/threads/thread_enums.hpp>
+#include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
 #include <hpx/util/function.hpp>
 
@@ -88,6 +89,17 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         {
             HPX_ASSERT(m_pimpl);
 
+            // there is no context to switch away from if this thread runs
+            // on the stack of the scheduling OS thread
+            if (m_pimpl->is_stackless())
+            {
+                HPX_THROW_EXCEPTION(invalid_status,
+                    "coroutine_self::yield_impl",
+                    "attempting to suspend a stackless thread (created "
+                    "using thread_stacksize_nostack), such threads have to "
+                    "run to completion");
+            }
+
             this->m_pimpl->bind_result(&arg);
 
             {
@@ -154,9 +166,18 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 #endif
         }
 
+        bool is_stackless() const
+        {
+            HPX_ASSERT(m_pimpl);
+            return m_pimpl->is_stackless();
+        }
+
         std::ptrdiff_t get_available_stack_space()
         {
 #if defined(HPX_HAVE_THREADS_GET_STACK_POINTER)
+            // stackless threads run on the stack of the OS thread
+            if (m_pimpl->is_stackless())
+                return (std::numeric_limits<std::ptrdiff_t>::max)();
             return m_pimpl->get_available_stack_space();
 #else
             return (std::numeric_limits<std::ptrdiff_t>::max)();
@@ -143,6 +143,10 @@ namespace posix
             // We never free up the first page, as it's initialized only when the
             // stack is created.
             ::madvise(stack, size - EXEC_PAGESIZE, MADV_DONTNEED);
+
+            // Restore the watermark, this makes sure that the stack is not
+            // released again unless it was used deeply again.
+            *watermark = reinterpret_cast<void*>(0xDEADBEEFDEADBEEFull);
             return true;
         }
 
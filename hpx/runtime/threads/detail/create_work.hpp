@@ -13,7 +13,10 @@
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/logging.hpp>
 
+#include <cstddef>
+#include <cstdint>
 #include <sstream>
+#include <vector>
 
 namespace hpx { namespace threads { namespace detail
 {
@@ -86,18 +89,101 @@ namespace hpx { namespace threads { namespace detail
         }
 
         // create the new thread
+        std::size_t num_thread = data.num_os_thread;
         if (thread_priority_critical == data.priority ||
             thread_priority_boost == data.priority)
         {
             // For critical priority threads, create the thread immediately.
             scheduler->create_thread(data, nullptr, initial_state, true, ec,
-                data.num_os_thread);
+                num_thread);
         }
         else {
             // Create a task description for the new thread.
             scheduler->create_thread(data, nullptr, initial_state, false, ec,
-                data.num_os_thread);
+                num_thread);
         }
+
+        // potentially wake up waiting thread
+        scheduler->do_some_work(num_thread);
+    }
+
+    inline void create_work_bulk(policies::scheduler_base* scheduler,
+        std::vector<thread_init_data>& data,
+        thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws)
+    {
+        // verify parameters
+        switch (initial_state) {
+        case pending:
+        case pending_do_not_schedule:
+        case pending_boost:
+        case suspended:
+            break;
+
+        default:
+            {
+                std::ostringstream strm;
+                strm << "invalid initial state: "
+                     << get_thread_state_name(initial_state);
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "thread::detail::create_work_bulk",
+                    strm.str());
+                return;
+            }
+        }
+
+        LTM_(info)
+            << "create_work_bulk: initial_state("
+            << get_thread_state_name(initial_state) << "), count("
+            << data.size() << ")";
+
+        thread_self* self = get_self_ptr();
+
+        // Pass critical priority from parent to children.
+        bool critical = self &&
+            thread_priority_critical == threads::get_self_id()->get_priority();
+
+#ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
+        thread_id_repr_type parent_id = nullptr;
+        std::size_t parent_phase = 0;
+        if (self)
+        {
+            parent_id = threads::get_self_id().get();
+            parent_phase = self->get_thread_phase();
+        }
+        std::uint32_t parent_locality_id = get_locality_id();
+#endif
+
+        for (thread_init_data& d : data)
+        {
+#ifdef HPX_HAVE_THREAD_DESCRIPTION
+            if (!d.description)
+            {
+                HPX_THROWS_IF(ec, bad_parameter,
+                    "thread::detail::create_work_bulk",
+                    "description is nullptr");
+                return;
+            }
+#endif
+
+#ifdef HPX_HAVE_THREAD_PARENT_REFERENCE
+            if (nullptr == d.parent_id) {
+                d.parent_id = parent_id;
+                d.parent_phase = parent_phase;
+            }
+            if (0 == d.parent_locality_id)
+                d.parent_locality_id = parent_locality_id;
+#endif
+
+            if (nullptr == d.scheduler_base)
+                d.scheduler_base = scheduler;
+
+            if (critical)
+                d.priority = thread_priority_critical;
+        }
+
+        // create the new threads
+        scheduler->create_work_bulk(data, initial_state, ec);
     }
 }}}
 
@@ -25,10 +25,13 @@
 #include <hpx/util/apex.hpp>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <cstddef>
 #include <cstdint>
 #include <limits>
 #include <memory>
+#include <thread>
 #include <utility>
 
 namespace hpx { namespace threads { namespace detail
@@ -278,6 +281,17 @@ namespace hpx { namespace threads { namespace detail
             max_background_threads_(max_background_threads),
             max_idle_loop_count_(max_idle_loop_count),
             max_busy_loop_count_(max_busy_loop_count)
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+          , idle_spin_count_(hpx::util::safe_lexical_cast<std::int64_t>(
+                hpx::get_config_entry("hpx.idle_spin_count",
+                    HPX_IDLE_BACKOFF_SPIN_COUNT))),
+            idle_yield_count_(hpx::util::safe_lexical_cast<std::int64_t>(
+                hpx::get_config_entry("hpx.idle_yield_count",
+                    HPX_IDLE_BACKOFF_YIELD_COUNT))),
+            max_idle_backoff_time_(hpx::util::safe_lexical_cast<std::int64_t>(
+                hpx::get_config_entry("hpx.max_idle_backoff_time",
+                    HPX_IDLE_BACKOFF_TIME_MAX)))
+#endif
         {}
 
         callback_type outer_;
@@ -286,8 +300,57 @@ namespace hpx { namespace threads { namespace detail
         std::size_t const max_background_threads_;
         std::int64_t const max_idle_loop_count_;
         std::int64_t const max_busy_loop_count_;
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::int64_t const idle_spin_count_;
+        std::int64_t const idle_yield_count_;
+        std::int64_t const max_idle_backoff_time_;
+#endif
     };
 
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    ///////////////////////////////////////////////////////////////////////////
+    // Adaptive back-off for idle OS threads: keep spinning for a while after
+    // the queues have run empty, then start yielding the core to other OS
+    // threads, and finally put the OS thread to sleep until new work has been
+    // scheduled for it. The sleep time is doubled for each consecutive sleep
+    // without new work (up to max_idle_backoff_time_) to allow for background
+    // work to be done every now and then.
+    template <typename SchedulingPolicy>
+    void idle_backoff(SchedulingPolicy& scheduler,
+        scheduling_callbacks const& params, std::size_t num_thread,
+        std::int64_t idle_loop_count)
+    {
+        std::int64_t count = idle_loop_count - params.idle_spin_count_;
+        if (count <= 0)
+            return;
+
+        if (count <= params.idle_yield_count_)
+        {
+            std::this_thread::yield();
+            return;
+        }
+
+        count -= params.idle_yield_count_ + 1;
+        std::int64_t timeout = params.max_idle_backoff_time_;
+        if (count < 10)
+            timeout = (std::min)(std::int64_t(100) << count, timeout);
+
+        // don't sleep past the next timer deadline
+        std::int64_t next_timer = std::chrono::duration_cast<
+                std::chrono::microseconds
+            >(scheduler.get_timer_wheel().time_until_next_expiry()).count();
+        if (next_timer < timeout)
+        {
+            if (next_timer <= 0)
+                return;
+            timeout = next_timer;
+        }
+
+        scheduler.SchedulingPolicy::park(num_thread,
+            std::chrono::microseconds(timeout));
+    }
+#endif
+
     template <typename SchedulingPolicy>
     thread_id_type create_background_thread(SchedulingPolicy& scheduler,
         scheduling_callbacks& callbacks, std::shared_ptr<bool>& background_running,
@@ -691,9 +754,23 @@ namespace hpx { namespace threads { namespace detail
                         background_running, num_thread, idle_loop_count);
                 }
 
+                // fire expired timers
+                scheduler.SchedulingPolicy::process_timers();
+
                 // call back into invoking context
                 if (!params.inner_.empty())
                     params.inner_();
+
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+                // back off if there hasn't been any work for a while
+                if (running && !may_exit &&
+                    (scheduler.get_scheduler_mode() &
+                        policies::enable_idle_backoff))
+                {
+                    idle_backoff(scheduler, params, num_thread,
+                        idle_loop_count);
+                }
+#endif
             }
 
             // something went badly wrong, give up
@@ -704,6 +781,9 @@ namespace hpx { namespace threads { namespace detail
             {
                 busy_loop_count = 0;
 
+                // fire expired timers
+                scheduler.SchedulingPolicy::process_timers();
+
                 // do background work in parcel layer and in agas
                 if (!call_background_thread(background_thread, next_thrd, scheduler,
                     num_thread, running))
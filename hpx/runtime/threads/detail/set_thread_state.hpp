@@ -7,22 +7,18 @@
 #define HPX_RUNTIME_THREADS_DETAIL_SET_THREAD_STATE_JAN_13_2013_0518PM
 
 #include <hpx/config.hpp>
-#include <hpx/config/asio.hpp>
 #include <hpx/error_code.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
 #include <hpx/runtime/threads/detail/create_thread.hpp>
 #include <hpx/runtime/threads/detail/create_work.hpp>
+#include <hpx/runtime/threads/policies/timer_wheel.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
-#include <hpx/runtime_fwd.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/bind.hpp>
-#include <hpx/util/chrono_traits.hpp>
-#include <hpx/util/io_service_pool.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/steady_clock.hpp>
 
-#include <boost/asio/basic_deadline_timer.hpp>
 #include <boost/atomic.hpp>
 
 #include <chrono>
@@ -238,41 +234,40 @@ namespace hpx { namespace threads { namespace detail
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    /// This thread function is used by the at_timer thread below to trigger
-    /// the required action.
-    inline thread_result_type wake_timer_thread(
-        thread_id_type const& thrd, thread_state_enum newstate,
-        thread_state_ex_enum newstate_ex, thread_priority priority,
-        thread_id_type const& timer_id,
-        std::shared_ptr<boost::atomic<bool> > const& triggered)
+    /// The timer used by the at_timer thread below to trigger the required
+    /// action.
+    class wake_timer : public policies::timer_wheel::entry
     {
-        if (HPX_UNLIKELY(!thrd)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "null thread id encountered (id)");
-            return thread_result_type(terminated, nullptr);
-        }
-        if (HPX_UNLIKELY(!timer_id)) {
-            HPX_THROW_EXCEPTION(null_thread_id,
-                "threads::detail::wake_timer_thread",
-                "null thread id encountered (timer_id)");
-            return thread_result_type(terminated, nullptr);
-        }
-
-        bool oldvalue = false;
-        if (triggered->compare_exchange_strong(oldvalue, true)) //-V601
+    public:
+        wake_timer(thread_id_type const& thrd, thread_state_enum newstate,
+                thread_state_ex_enum newstate_ex, thread_priority priority,
+                thread_id_type const& timer_id)
+          : thrd_(thrd), newstate_(newstate), newstate_ex_(newstate_ex),
+            priority_(priority), timer_id_(timer_id)
+        {}
+
+    protected:
+        // This is executed by the scheduling loop of one of the worker
+        // threads, errors must not be propagated.
+        void expire()
         {
-            // timer has not been canceled yet, trigger the requested set_state
-            detail::set_thread_state(thrd, newstate, newstate_ex, priority);
+            // trigger the requested set_state
+            error_code ec(lightweight);    // do not throw
+            detail::set_thread_state(thrd_, newstate_, newstate_ex_,
+                priority_, std::size_t(-1), ec);
+
+            // then re-activate the thread waiting for the timer
+            detail::set_thread_state(timer_id_, pending, wait_timeout,
+                thread_priority_boost, std::size_t(-1), ec);
         }
 
-        // then re-activate the thread holding the deadline_timer
-        error_code ec(lightweight);    // do not throw
-        detail::set_thread_state(timer_id, pending, wait_timeout,
-            thread_priority_boost, std::size_t(-1), ec);
-
-        return thread_result_type(terminated, nullptr);
-    }
+    private:
+        thread_id_type thrd_;
+        thread_state_enum newstate_;
+        thread_state_ex_enum newstate_ex_;
+        thread_priority priority_;
+        thread_id_type timer_id_;
+    };
 
     /// This thread function initiates the required set_state action (on
     /// behalf of one of the threads#detail#set_thread_state functions).
@@ -289,55 +284,24 @@ namespace hpx { namespace threads { namespace detail
             return thread_result_type(terminated, nullptr);
         }
 
-        // create a new thread in suspended state, which will execute the
-        // requested set_state when timer fires and will re-awaken this thread,
-        // allowing the deadline_timer to go out of scope gracefully
-        thread_id_type self_id = get_self_id();
-
-        std::shared_ptr<boost::atomic<bool> > triggered(
-            std::make_shared<boost::atomic<bool> >(false));
-
-        thread_init_data data(
-            util::bind(&wake_timer_thread,
-                thrd, newstate, newstate_ex, priority,
-                self_id, triggered),
-            "wake_timer", 0, priority);
-
-        thread_id_type wake_id = invalid_thread_id;
-        create_thread(&scheduler, data, wake_id, suspended);
-
-        // create timer firing in correspondence with given time
-        typedef boost::asio::basic_deadline_timer<
-            util::steady_clock
-          , util::chrono_traits<util::steady_clock>
-        > deadline_timer;
-
-        deadline_timer t (
-            get_thread_pool("timer-pool")->get_io_service(), abs_time);
-
-        // let the timer invoke the set_state on the new (suspended) thread
-        t.async_wait(util::bind(&detail::set_thread_state,
-            wake_id, pending, wait_timeout, priority,
-            std::size_t(-1), std::ref(throws)));
+        // add a timer to the wheel of the scheduler, it will execute the
+        // requested set_state when it expires and will re-awaken this thread
+        wake_timer* t = new wake_timer(thrd, newstate, newstate_ex, priority,
+            get_self_id());
+        scheduler.get_timer_wheel().add(t, abs_time);
 
         // this waits for the thread to be reactivated when the timer fired
         // if it returns signaled the timer has been canceled, otherwise
-        // the timer fired and the wake_timer_thread above has been executed
+        // the timer fired and the requested set_state has been executed
         thread_state_ex_enum statex =
             get_self().yield(thread_result_type(suspended, nullptr));
 
         if (wait_timeout != statex) //-V601
         {
-            triggered->store(true);
-
-            // wake_timer_thread has not been executed yet, cancel timer
-            t.cancel();
-
-            // cancel wake_timer_thread
-            error_code ec(lightweight);    // do not throw
-            detail::set_thread_state(wake_id, pending, wait_abort,
-                priority, std::size_t(-1), ec);
+            // the timer has not expired yet, cancel it
+            t->cancel();
         }
+        t->release();
 
         return thread_result_type(terminated, nullptr);
     }
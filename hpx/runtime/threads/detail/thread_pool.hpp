@@ -69,6 +69,8 @@ namespace hpx { namespace threads { namespace detail
             thread_state_enum initial_state, bool run_now, error_code& ec);
         void create_work(thread_init_data& data,
             thread_state_enum initial_state, error_code& ec);
+        void create_work_bulk(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec);
 
         thread_state set_state(thread_id_type const& id,
             thread_state_enum new_state, thread_state_ex_enum new_state_ex,
@@ -128,6 +130,16 @@ namespace hpx { namespace threads { namespace detail
         std::int64_t get_num_stolen_to_pending(std::size_t num, bool reset);
         std::int64_t get_num_stolen_from_staged(std::size_t num, bool reset);
         std::int64_t get_num_stolen_to_staged(std::size_t num, bool reset);
+
+        std::int64_t get_num_stolen_local(std::size_t num, bool reset);
+        std::int64_t get_num_stolen_numa_local(std::size_t num, bool reset);
+        std::int64_t get_num_stolen_remote(std::size_t num, bool reset);
+#endif
+
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+        std::int64_t get_num_parks(std::size_t num, bool reset);
+        std::int64_t get_num_unparks(std::size_t num, bool reset);
+        std::int64_t get_average_wakeup_time(std::size_t num, bool reset);
 #endif
 
         std::int64_t get_thread_count(thread_state_enum state,
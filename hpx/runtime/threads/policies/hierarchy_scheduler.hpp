@@ -39,7 +39,7 @@ namespace hpx { namespace threads { namespace policies
     /// (threads). Every OS threads walks that tree to obtain new work
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class HPX_EXPORT hierarchy_scheduler : public scheduler_base
     {
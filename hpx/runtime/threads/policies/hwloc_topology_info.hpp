@@ -100,6 +100,17 @@ namespace hpx { namespace threads
           , error_code& ec = throws
             ) const;
 
+        mask_cref_type get_cache_affinity_mask(
+            std::size_t num_thread
+          , bool numa_sensitive
+          , error_code& ec = throws
+            ) const;
+
+        std::size_t get_numa_node_distance(
+            std::size_t numa_node1
+          , std::size_t numa_node2
+            ) const;
+
         mask_cref_type get_thread_affinity_mask(
             std::size_t num_thread
           , bool numa_sensitive = false
@@ -132,6 +143,7 @@ namespace hpx { namespace threads
         mask_type init_core_affinity_mask_from_core(
             std::size_t num_core, mask_cref_type default_mask = mask_type()
             ) const;
+        mask_type init_cache_affinity_mask(std::size_t num_thread) const;
         mask_type init_thread_affinity_mask(std::size_t num_thread) const;
         mask_type init_thread_affinity_mask(
             std::size_t num_core
@@ -232,6 +244,7 @@ namespace hpx { namespace threads
         }
 
         void init_num_of_pus();
+        void init_numa_node_distances();
 
         hwloc_topology_t topo;
 
@@ -259,7 +272,11 @@ namespace hpx { namespace threads
         std::vector<mask_type> socket_affinity_masks_;
         std::vector<mask_type> numa_node_affinity_masks_;
         std::vector<mask_type> core_affinity_masks_;
+        std::vector<mask_type> cache_affinity_masks_;
         std::vector<mask_type> thread_affinity_masks_;
+
+        // relative distances between NUMA domains (row-major matrix)
+        std::vector<std::size_t> numa_node_distances_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
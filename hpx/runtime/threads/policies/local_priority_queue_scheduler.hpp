@@ -23,6 +23,7 @@
 #include <boost/exception_ptr.hpp>
 #include <boost/thread/mutex.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
 #include <memory>
@@ -55,7 +56,7 @@ namespace hpx { namespace threads { namespace policies
     /// OS thread whenever no other work is available.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class HPX_EXPORT local_priority_queue_scheduler : public scheduler_base
     {
@@ -488,6 +489,65 @@ namespace hpx { namespace threads { namespace policies
                 run_now, ec);
         }
 
+        /// Register task descriptions for all of the given threads. Tasks of
+        /// normal priority without a requested target queue are distributed
+        /// in contiguous chunks over the queues, touching each queue (and
+        /// waking each of the worker threads) only once.
+        virtual void create_work_bulk(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            std::vector<thread_init_data*> tasks;
+            tasks.reserve(data.size());
+
+            for (thread_init_data& d : data)
+            {
+                if (d.num_os_thread == std::size_t(-1) &&
+                    d.priority != thread_priority_critical &&
+                    d.priority != thread_priority_boost &&
+                    d.priority != thread_priority_low)
+                {
+                    tasks.push_back(&d);
+                    continue;
+                }
+
+                bool run_now = d.priority == thread_priority_critical ||
+                    d.priority == thread_priority_boost;
+                std::size_t num_thread = d.num_os_thread;
+                create_thread(d, nullptr, initial_state, run_now, ec,
+                    num_thread);
+                if (ec) return;
+
+                this->do_some_work(num_thread);
+            }
+
+            if (tasks.empty())
+            {
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
+            }
+
+            std::size_t queue_size = queues_.size();
+            std::size_t chunk_size =
+                (tasks.size() + queue_size - 1) / queue_size;
+            std::size_t num_thread = curr_queue_++ % queue_size;
+
+            for (std::size_t base = 0; base < tasks.size(); base += chunk_size)
+            {
+                std::size_t count =
+                    (std::min)(chunk_size, tasks.size() - base);
+                queues_[num_thread]->create_work_bulk(&tasks[base], count,
+                    initial_state);
+                this->do_some_work(num_thread);
+
+                if (++num_thread == queue_size)
+                    num_thread = 0;
+            }
+
+            if (&ec != &throws)
+                ec = make_success_code();
+        }
+
         /// Return the next thread to be executed, return false if none is
         /// available
         virtual bool get_next_thread(std::size_t num_thread, bool running,
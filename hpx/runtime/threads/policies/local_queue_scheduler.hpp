@@ -53,7 +53,7 @@ namespace hpx { namespace threads { namespace policies
     /// from.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class HPX_EXPORT local_queue_scheduler : public scheduler_base
     {
@@ -10,18 +10,25 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/util/lockfree/bounded_ring.hpp>
+#include <hpx/util/lockfree/chase_lev_deque.hpp>
 #include <hpx/util/lockfree/deque.hpp>
+#include <boost/atomic.hpp>
 #include <boost/lockfree/queue.hpp>
 #include <boost/lockfree/stack.hpp>
 
+#include <algorithm>
 #include <cstddef>
 #include <cstdint>
+#include <thread>
 
 namespace hpx { namespace threads { namespace policies
 {
 
 struct lockfree_fifo;
 struct lockfree_lifo;
+struct lockfree_chase_lev;
+struct lockfree_staged_ring;
 
 ///////////////////////////////////////////////////////////////////////////////
 template <typename T, typename Queuing>
@@ -81,6 +88,256 @@ struct lockfree_lifo
     };
 };
 
+///////////////////////////////////////////////////////////////////////////////
+// Chase-Lev work-stealing deque: the owning OS thread pushes and pops (LIFO)
+// at the bottom end without atomic read-modify-write operations, all other
+// threads steal (FIFO) from the top end.
+//
+// The deque supports a single producer only, while threads may be scheduled
+// onto a queue from any OS thread. The owner is the worker thread the queue
+// belongs to, it is bound when that worker starts running (see bind_owner
+// below). Items pushed by any other thread (or pushed to the other end) are
+// put into a separate multi-producer queue which is drained after the deque
+// has run empty.
+template <typename T>
+struct lockfree_chase_lev_backend
+{
+    typedef boost::lockfree::chase_lev_deque<T> container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::uint64_t size_type;
+
+    lockfree_chase_lev_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : deque_(std::size_t(initial_size)),
+        inbox_(std::size_t(initial_size)),
+        owner_(std::thread::id())
+    {}
+
+    bool push(const_reference val, bool other_end = false)
+    {
+        if (!other_end &&
+            owner_.load(boost::memory_order_relaxed) ==
+                std::this_thread::get_id())
+        {
+            return deque_.push_bottom(val);
+        }
+        return inbox_.push(val);
+    }
+
+    bool pop(reference val, bool steal = true)
+    {
+        if (!steal && is_owner())
+        {
+            if (deque_.pop_bottom(val))
+                return true;
+        }
+        else if (deque_.steal_top(val))
+        {
+            return true;
+        }
+        return inbox_.pop(val);
+    }
+
+    bool empty()
+    {
+        return deque_.empty() && inbox_.empty();
+    }
+
+    // bind the calling thread as the owner of the deque
+    void bind_owner()
+    {
+        owner_.store(std::this_thread::get_id());
+    }
+
+  private:
+    bool is_owner() const
+    {
+        return owner_.load(boost::memory_order_relaxed) ==
+            std::this_thread::get_id();
+    }
+
+    container_type deque_;
+    boost::lockfree::queue<T> inbox_;
+    boost::atomic<std::thread::id> owner_;
+};
+
+struct lockfree_chase_lev
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_chase_lev_backend<T> type;
+    };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Bounded ring buffer used for staged tasks: pushing does not allocate, and
+// producers and consumers can claim a whole batch of items using a single
+// CAS (see push_bulk and pop_bulk below). Items pushed while the ring is full
+// are put into an unbounded overflow queue. All items pushed after that go to
+// the overflow queue as well until it has been drained, otherwise staged items
+// would starve behind newer ones for as long as a producer keeps the ring busy.
+template <typename T>
+struct lockfree_staged_ring_backend
+{
+    typedef boost::lockfree::bounded_ring<T> container_type;
+    typedef T value_type;
+    typedef T& reference;
+    typedef T const& const_reference;
+    typedef std::uint64_t size_type;
+
+    lockfree_staged_ring_backend(
+        size_type initial_size = 0
+      , size_type num_thread = size_type(-1)
+        )
+      : ring_((std::max)(std::size_t(initial_size),
+            std::size_t(HPX_THREAD_QUEUE_STAGED_RING_SIZE))),
+        overflow_(0),
+        overflow_count_(0)
+    {}
+
+    bool push(const_reference val, bool /*other_end*/ = false)
+    {
+        if (overflow_count_.load(boost::memory_order_acquire) == 0 &&
+            ring_.push(val))
+        {
+            return true;
+        }
+        return push_overflow(val);
+    }
+
+    std::size_t push_bulk(T const* vals, std::size_t count,
+        bool /*other_end*/ = false)
+    {
+        std::size_t pushed = 0;
+        if (overflow_count_.load(boost::memory_order_acquire) == 0)
+            pushed = ring_.push_bulk(vals, count);
+
+        for (/**/; pushed != count; ++pushed)
+        {
+            if (!push_overflow(vals[pushed]))
+                break;
+        }
+        return pushed;
+    }
+
+    bool pop(reference val, bool /*steal*/ = true)
+    {
+        if (ring_.pop(val))
+            return true;
+        return pop_overflow(val);
+    }
+
+    std::size_t pop_bulk(T* vals, std::size_t count, bool /*steal*/ = true)
+    {
+        std::size_t result = ring_.pop_bulk(vals, count);
+        while (result != count && pop_overflow(vals[result]))
+            ++result;
+        return result;
+    }
+
+    bool empty()
+    {
+        return ring_.empty() && overflow_.empty();
+    }
+
+  private:
+    // The counter is incremented before an item is pushed to the overflow
+    // queue, it can't drop to zero while items are left in there.
+    bool push_overflow(const_reference val)
+    {
+        ++overflow_count_;
+        if (overflow_.push(val))
+            return true;
+        --overflow_count_;
+        return false;
+    }
+
+    bool pop_overflow(reference val)
+    {
+        if (overflow_count_.load(boost::memory_order_acquire) == 0 ||
+            !overflow_.pop(val))
+        {
+            return false;
+        }
+        --overflow_count_;
+        return true;
+    }
+
+    container_type ring_;
+    boost::lockfree::queue<T> overflow_;
+    boost::atomic<std::int64_t> overflow_count_;
+};
+
+struct lockfree_staged_ring
+{
+    template <typename T>
+    struct apply
+    {
+        typedef lockfree_staged_ring_backend<T> type;
+    };
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// Bind the calling OS thread as the owner of the given queue backend. This is
+// called by the worker thread a queue belongs to when it starts running,
+// only backends distinguishing their owner need to do anything.
+template <typename Queue>
+void bind_owner(Queue&)
+{
+}
+
+template <typename T>
+void bind_owner(lockfree_chase_lev_backend<T>& queue)
+{
+    queue.bind_owner();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Push up to count items to the given queue backend, returns the number of
+// items taken from vals. Backends which can't claim space in bulk push the
+// items one by one.
+template <typename Queue, typename T>
+std::size_t push_bulk(Queue& queue, T const* vals, std::size_t count,
+    bool other_end = false)
+{
+    std::size_t result = 0;
+    while (result != count && queue.push(vals[result], other_end))
+        ++result;
+    return result;
+}
+
+template <typename T>
+std::size_t push_bulk(lockfree_staged_ring_backend<T>& queue, T const* vals,
+    std::size_t count, bool other_end = false)
+{
+    return queue.push_bulk(vals, count, other_end);
+}
+
+// Pop up to count items from the given queue backend, returns the number of
+// items stored in vals. Backends which can't claim items in bulk pop them one
+// by one.
+template <typename Queue, typename T>
+std::size_t pop_bulk(Queue& queue, T* vals, std::size_t count,
+    bool steal = true)
+{
+    std::size_t result = 0;
+    while (result != count && queue.pop(vals[result], steal))
+        ++result;
+    return result;
+}
+
+template <typename T>
+std::size_t pop_bulk(lockfree_staged_ring_backend<T>& queue, T* vals,
+    std::size_t count, bool steal = true)
+{
+    return queue.pop_bulk(vals, count, steal);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 // FIFO + stealing at opposite end.
 #if defined(HPX_HAVE_ABP_SCHEDULER)
@@ -0,0 +1,463 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_SCHEDULING_NUMA_PRIORITY_QUEUE_HPP)
+#define HPX_THREADMANAGER_SCHEDULING_NUMA_PRIORITY_QUEUE_HPP
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/cpu_mask.hpp>
+#include <hpx/runtime/threads/policies/local_priority_queue_scheduler.hpp>
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/runtime/threads_fwd.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/logging.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    namespace detail
+    {
+        // number of idle scheduling loop iterations a worker thread has to go
+        // through before it attempts to steal work from a NUMA domain with a
+        // relative distance of 20 (i.e. twice the local distance)
+        inline std::int64_t get_numa_steal_delay()
+        {
+            static std::int64_t numa_steal_delay =
+                boost::lexical_cast<std::int64_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.numa_steal_delay", "16"));
+            return numa_steal_delay;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The numa_priority_queue_scheduler maintains the same queues as the
+    /// local_priority_queue_scheduler, however it steals work based on the
+    /// topology of the machine. Each worker thread first tries to steal from
+    /// the cores sharing its L2/L3 cache, then from the cores inside its NUMA
+    /// domain, and only after that from other NUMA domains. Steals across NUMA
+    /// domains are throttled: a worker thread has to be idle for a number of
+    /// scheduling loop iterations which is proportional to the distance of
+    /// the victim's NUMA domain before it is allowed to steal from there.
+    template <typename Mutex = boost::mutex,
+        typename PendingQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
+        typename TerminatedQueuing = lockfree_lifo>
+    class HPX_EXPORT numa_priority_queue_scheduler
+      : public local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        >
+    {
+    public:
+        typedef local_priority_queue_scheduler<
+            Mutex, PendingQueuing, StagedQueuing, TerminatedQueuing
+        > base_type;
+
+        typedef typename base_type::thread_queue_type thread_queue_type;
+
+        typedef typename base_type::init_parameter_type
+            init_parameter_type;
+
+        numa_priority_queue_scheduler(init_parameter_type const& init,
+                bool deferred_initialization = true)
+          : base_type(init, deferred_initialization),
+            victims_(init.num_queues_),
+            steal_counts_(init.num_queues_)
+        {}
+
+        static std::string get_scheduler_name()
+        {
+            return "numa_priority_queue_scheduler";
+        }
+
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+        std::int64_t get_num_stolen_local(std::size_t num_thread, bool reset)
+        {
+            return get_steal_count(steal_local, num_thread, reset);
+        }
+
+        std::int64_t get_num_stolen_numa_local(std::size_t num_thread,
+            bool reset)
+        {
+            return get_steal_count(steal_numa_local, num_thread, reset);
+        }
+
+        std::int64_t get_num_stolen_remote(std::size_t num_thread, bool reset)
+        {
+            return get_steal_count(steal_remote, num_thread, reset);
+        }
+#endif
+
+        /// Return the next thread to be executed, return false if none is
+        /// available
+        virtual bool get_next_thread(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count, threads::thread_data*& thrd)
+        {
+            std::size_t queues_size = this->queues_.size();
+            std::size_t high_priority_queues =
+                this->high_priority_queues_.size();
+
+            HPX_ASSERT(num_thread < queues_size);
+            thread_queue_type* this_high_priority_queue = nullptr;
+            thread_queue_type* this_queue = this->queues_[num_thread];
+
+            if (num_thread < high_priority_queues)
+            {
+                this_high_priority_queue =
+                    this->high_priority_queues_[num_thread];
+                bool result =
+                    this_high_priority_queue->get_next_thread(thrd);
+
+                this_high_priority_queue->increment_num_pending_accesses();
+                if (result)
+                    return true;
+                this_high_priority_queue->increment_num_pending_misses();
+            }
+
+            {
+                bool result = this_queue->get_next_thread(thrd);
+
+                this_queue->increment_num_pending_accesses();
+                if (result)
+                    return true;
+                this_queue->increment_num_pending_misses();
+
+                bool have_staged = this_queue->
+                    get_staged_queue_length(boost::memory_order_relaxed) != 0;
+
+                // Give up, we should have work to convert.
+                if (have_staged)
+                    return false;
+            }
+
+            for (victim const& v : victims_[num_thread])
+            {
+                // victims are ordered by increasing distance, we're not
+                // allowed to steal from far away queues yet
+                if (idle_loop_count < v.min_idle_loop_count_)
+                    break;
+
+                std::size_t idx = v.num_thread_;
+                HPX_ASSERT(idx != num_thread);
+
+                if (idx < high_priority_queues &&
+                    num_thread < high_priority_queues)
+                {
+                    thread_queue_type* q = this->high_priority_queues_[idx];
+                    if (q->get_next_thread(thrd, running))
+                    {
+                        q->increment_num_stolen_from_pending();
+                        this_high_priority_queue->
+                            increment_num_stolen_to_pending();
+                        count_steal(v.domain_, num_thread);
+                        return true;
+                    }
+                }
+
+                thread_queue_type* q = this->queues_[idx];
+                if (q->get_next_thread(thrd, running))
+                {
+                    q->increment_num_stolen_from_pending();
+                    this_queue->increment_num_stolen_to_pending();
+                    count_steal(v.domain_, num_thread);
+                    return true;
+                }
+            }
+
+            return this->low_priority_queue_.get_next_thread(thrd);
+        }
+
+        /// This is a function which gets called periodically by the thread
+        /// manager to allow for maintenance tasks to be executed in the
+        /// scheduler. Returns true if the OS thread calling this function
+        /// has to be terminated (i.e. no more work has to be done).
+        virtual bool wait_or_add_new(std::size_t num_thread, bool running,
+            std::int64_t& idle_loop_count)
+        {
+            std::size_t added = 0;
+            bool result = true;
+
+            std::size_t high_priority_queues =
+                this->high_priority_queues_.size();
+            thread_queue_type* this_high_priority_queue = nullptr;
+            thread_queue_type* this_queue = this->queues_[num_thread];
+
+            if (num_thread < high_priority_queues)
+            {
+                this_high_priority_queue =
+                    this->high_priority_queues_[num_thread];
+                result = this_high_priority_queue->wait_or_add_new(running,
+                            idle_loop_count, added)
+                        && result;
+                if (0 != added) return result;
+            }
+
+            result = this_queue->wait_or_add_new(
+                running, idle_loop_count, added) && result;
+            if (0 != added) return result;
+
+            for (victim const& v : victims_[num_thread])
+            {
+                if (idle_loop_count < v.min_idle_loop_count_)
+                    break;
+
+                std::size_t idx = v.num_thread_;
+                HPX_ASSERT(idx != num_thread);
+
+                if (idx < high_priority_queues &&
+                    num_thread < high_priority_queues)
+                {
+                    thread_queue_type* q = this->high_priority_queues_[idx];
+                    result = this_high_priority_queue->
+                        wait_or_add_new(running, idle_loop_count,
+                            added, q)
+                      && result;
+
+                    if (0 != added)
+                    {
+                        q->increment_num_stolen_from_staged(added);
+                        this_high_priority_queue->
+                            increment_num_stolen_to_staged(added);
+                        count_steal(v.domain_, num_thread, added);
+                        return result;
+                    }
+                }
+
+                thread_queue_type* q = this->queues_[idx];
+                result = this_queue->wait_or_add_new(running,
+                    idle_loop_count, added, q) && result;
+                if (0 != added)
+                {
+                    q->increment_num_stolen_from_staged(added);
+                    this_queue->increment_num_stolen_to_staged(added);
+                    count_steal(v.domain_, num_thread, added);
+                    return result;
+                }
+            }
+
+#ifdef HPX_HAVE_THREAD_MINIMAL_DEADLOCK_DETECTION
+            // no new work is available, are we deadlocked?
+            if (HPX_UNLIKELY(minimal_deadlock_detection && LHPX_ENABLED(error)))
+            {
+                bool suspended_only = true;
+
+                for (std::size_t i = 0;
+                     suspended_only && i != this->queues_.size(); ++i)
+                {
+                    suspended_only = this->queues_[i]->dump_suspended_threads(
+                        i, idle_loop_count, running);
+                }
+
+                if (HPX_UNLIKELY(suspended_only)) {
+                    if (running) {
+                        LTM_(error) //-V128
+                            << "queue(" << num_thread << "): "
+                            << "no new work available, are we deadlocked?";
+                    }
+                    else {
+                        LHPX_CONSOLE_(hpx::util::logging::level::error) //-V128
+                              << "  [TM] " //-V128
+                              << "queue(" << num_thread << "): "
+                              << "no new work available, are we deadlocked?\n";
+                    }
+                }
+            }
+#endif
+
+            result = this->low_priority_queue_.wait_or_add_new(running,
+                idle_loop_count, added) && result;
+            if (0 != added) return result;
+
+            return result;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void on_start_thread(std::size_t num_thread)
+        {
+            // create the queues
+            this->base_type::on_start_thread(num_thread);
+
+            topology const& topo = this->topology_;
+            bool numa_sensitive = this->numa_sensitive_ != 0;
+
+            std::size_t num_threads = this->queues_.size();
+            std::size_t num_pu = this->get_pu_num(num_thread);
+
+            mask_cref_type core_mask =
+                topo.get_core_affinity_mask(num_pu, numa_sensitive);
+            mask_cref_type cache_mask =
+                topo.get_cache_affinity_mask(num_pu, numa_sensitive);
+            std::size_t numa_node = topo.get_numa_node_number(num_pu);
+
+            std::int64_t const numa_steal_delay =
+                detail::get_numa_steal_delay();
+
+            std::vector<victim>& victims = victims_[num_thread];
+            victims.clear();
+            victims.reserve(num_threads);
+
+            auto add_victim = [&](std::size_t other_num_thread)
+            {
+                std::size_t other_num_pu = this->get_pu_num(other_num_thread);
+                mask_cref_type other_pu_mask =
+                    topo.get_thread_affinity_mask(other_num_pu, numa_sensitive);
+
+                victim v;
+                v.num_thread_ = other_num_thread;
+                v.min_idle_loop_count_ = 0;
+
+                if (any(core_mask & other_pu_mask))
+                {
+                    v.domain_ = steal_local;
+                    v.rank_ = 0;
+                }
+                else if (any(cache_mask & other_pu_mask))
+                {
+                    v.domain_ = steal_local;
+                    v.rank_ = 1;
+                }
+                else
+                {
+                    std::size_t other_numa_node =
+                        topo.get_numa_node_number(other_num_pu);
+                    if (other_numa_node == numa_node)
+                    {
+                        v.domain_ = steal_numa_local;
+                        v.rank_ = 2;
+                    }
+                    else
+                    {
+                        // no stealing across NUMA domains at all
+                        if (this->numa_sensitive_ == 2)
+                            return;
+
+                        std::size_t distance = topo.get_numa_node_distance(
+                            numa_node, other_numa_node);
+
+                        v.domain_ = steal_remote;
+                        v.rank_ = 3;
+                        v.min_idle_loop_count_ = distance > 10 ?
+                            numa_steal_delay *
+                                static_cast<std::int64_t>(distance - 10) / 10 :
+                            0;
+                    }
+                }
+
+                victims.push_back(v);
+            };
+
+            // check our neighbors in a radial fashion (left and right
+            // alternating, increasing distance each iteration)
+            std::size_t radius = num_threads / 2;
+            for (std::size_t i = 1; i <= radius; ++i)
+            {
+                std::size_t left =
+                    (num_thread + num_threads - i) % num_threads;
+                std::size_t right = (num_thread + i) % num_threads;
+
+                add_victim(left);
+                if (right != left)
+                    add_victim(right);
+            }
+
+            // order the victims by their distance while preserving the radial
+            // order for equally distant ones
+            std::stable_sort(victims.begin(), victims.end(),
+                [](victim const& lhs, victim const& rhs)
+                {
+                    return lhs.rank_ < rhs.rank_ ||
+                        (lhs.rank_ == rhs.rank_ &&
+                         lhs.min_idle_loop_count_ < rhs.min_idle_loop_count_);
+                });
+        }
+
+    protected:
+        enum steal_domain
+        {
+            steal_local = 0,        // core sharing a cache with this one
+            steal_numa_local = 1,   // core in the same NUMA domain
+            steal_remote = 2        // core in another NUMA domain
+        };
+
+        struct victim
+        {
+            std::size_t num_thread_;
+            steal_domain domain_;
+            int rank_;
+            std::int64_t min_idle_loop_count_;
+        };
+
+        // the steal counts are updated by the owning worker thread only,
+        // keep them on separate cache lines
+        struct steal_counts_type
+        {
+            steal_counts_type()
+            {
+                for (std::size_t i = 0; i != 3; ++i)
+                    counts_[i].store(0);
+            }
+
+            boost::atomic<std::int64_t> counts_[3];
+
+            HPX_STATIC_CONSTEXPR std::size_t padding_size =
+                BOOST_LOCKFREE_CACHELINE_BYTES -
+                    (3 * sizeof(boost::atomic<std::int64_t>)) %
+                        BOOST_LOCKFREE_CACHELINE_BYTES;
+            char padding_[padding_size];
+        };
+
+        void count_steal(steal_domain domain, std::size_t num_thread,
+            std::size_t count = 1)
+        {
+#ifdef HPX_HAVE_THREAD_STEALING_COUNTS
+            steal_counts_[num_thread].counts_[domain].fetch_add(
+                static_cast<std::int64_t>(count), boost::memory_order_relaxed);
+#endif
+        }
+
+        std::int64_t get_steal_count(steal_domain domain,
+            std::size_t num_thread, bool reset)
+        {
+            std::int64_t count = 0;
+            if (num_thread == std::size_t(-1))
+            {
+                for (steal_counts_type& c : steal_counts_)
+                    count += util::get_and_reset_value(c.counts_[domain], reset);
+                return count;
+            }
+
+            HPX_ASSERT(num_thread < steal_counts_.size());
+            return util::get_and_reset_value(
+                steal_counts_[num_thread].counts_[domain], reset);
+        }
+
+    private:
+        std::vector<std::vector<victim> > victims_;
+        std::vector<steal_counts_type> steal_counts_;
+    };
+}}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+#endif
+#endif
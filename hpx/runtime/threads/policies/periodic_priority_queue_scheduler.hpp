@@ -39,7 +39,7 @@ namespace hpx { namespace threads { namespace policies
     /// OS thread whenever no other work is available.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class HPX_EXPORT periodic_priority_queue_scheduler
         : public local_priority_queue_scheduler<
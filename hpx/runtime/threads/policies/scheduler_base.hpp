@@ -15,10 +15,13 @@
 #include <hpx/runtime/parcelset_fwd.hpp>
 #include <hpx/runtime/threads/policies/affinity_data.hpp>
 #include <hpx/runtime/threads/policies/scheduler_mode.hpp>
+#include <hpx/runtime/threads/policies/timer_wheel.hpp>
 #include <hpx/runtime/threads/thread_init_data.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/state.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util_fwd.hpp>
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
 #include <hpx/runtime/threads/coroutines/detail/tss.hpp>
@@ -26,6 +29,7 @@
 
 #include <boost/chrono/chrono.hpp>
 #include <boost/exception_ptr.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
 #include <boost/thread/condition_variable.hpp>
 #include <boost/thread/locks.hpp>
 #include <boost/thread/mutex.hpp>
@@ -46,27 +50,6 @@
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
-#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-    namespace detail
-    {
-        struct reset_on_exit
-        {
-            reset_on_exit(boost::atomic<std::int32_t>& counter)
-              : counter_(counter)
-            {
-                ++counter_;
-                HPX_ASSERT(counter_ > 0);
-            }
-            ~reset_on_exit()
-            {
-                HPX_ASSERT(counter_ > 0);
-                --counter_;
-            }
-            boost::atomic<std::int32_t>& counter_;
-        };
-    }
-#endif
-
     ///////////////////////////////////////////////////////////////////////////
     /// The scheduler_base defines the interface to be implemented by all
     /// scheduler policies
@@ -83,7 +66,9 @@ namespace hpx { namespace threads { namespace policies
           , affinity_data_(num_threads)
           , mode_(mode)
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-          , wait_count_(0)
+          , idle_backoff_data_(num_threads)
+          , num_parked_(0)
+          , next_to_wake_(0)
 #endif
           , states_(num_threads)
           , description_(description)
@@ -119,18 +104,6 @@ namespace hpx { namespace threads { namespace policies
             return affinity_data_.init(data, topology);
         }
 
-        void idle_callback(std::size_t /*num_thread*/)
-        {
-#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            // Put this thread to sleep for some time, additionally it gets
-            // woken up on new work.
-            boost::chrono::milliseconds period(++wait_count_);
-
-            boost::unique_lock<boost::mutex> l(mtx_);
-            cond_.wait_for(l, period);
-#endif
-        }
-
         bool background_callback(std::size_t num_thread)
         {
             bool result = false;
@@ -142,18 +115,161 @@ namespace hpx { namespace threads { namespace policies
             return result;
         }
 
+        /// The timers for timed thread suspensions, these are driven by the
+        /// worker threads of this scheduler (see process_timers()).
+        timer_wheel& get_timer_wheel()
+        {
+            return timers_;
+        }
+
+        /// Fire all timers which have expired in the meantime, returns the
+        /// number of fired timers.
+        std::size_t process_timers()
+        {
+            return timers_.process();
+        }
+
+        /// Put the given OS thread to sleep until new work has been added for
+        /// it (see do_some_work) or until the given time has elapsed. Returns
+        /// whether the thread has been woken up because of new work.
+        bool park(std::size_t num_thread, std::chrono::microseconds timeout)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            HPX_ASSERT(num_thread < idle_backoff_data_.size());
+            idle_backoff_data& d = idle_backoff_data_[num_thread];
+
+            // Announce that we're about to sleep and look for work once more
+            // afterwards. Any thread adding work after this point will see
+            // the flag and wake us up, which avoids lost wakeups.
+            d.parked_.store(true);
+            ++num_parked_;
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+
+            bool woken = false;
+            if (get_queue_length(num_thread) != 0)
+            {
+                // Work has been added to our own queues in the meantime, go
+                // and get it. Work in other queues is not considered here as
+                // we might not be able to get hold of it (it might not be
+                // eligible for stealing), we would keep spinning instead of
+                // sleeping until it has been picked up by its owner.
+                d.parked_.store(false);
+                --num_parked_;
+                return false;
+            }
+
+            {
+                boost::unique_lock<boost::mutex> l(d.mtx_);
+                boost::chrono::steady_clock::time_point until =
+                    boost::chrono::steady_clock::now() +
+                        boost::chrono::microseconds(timeout.count());
+                while (!d.notified_)
+                {
+                    if (d.cond_.wait_until(l, until) ==
+                        boost::cv_status::timeout)
+                    {
+                        break;
+                    }
+                }
+                woken = d.notified_;
+                d.notified_ = false;
+            }
+
+            --num_parked_;
+            d.parked_.store(false);
+
+            ++d.park_count_;
+            if (woken)
+            {
+                std::uint64_t now = util::high_resolution_clock::now();
+                std::uint64_t notified_at =
+                    d.notify_time_.load(boost::memory_order_relaxed);
+
+                ++d.unpark_count_;
+                if (now > notified_at)
+                {
+                    d.wakeup_time_ += now - notified_at;
+                    ++d.wakeup_count_;
+                }
+            }
+            return woken;
+#else
+            return false;
+#endif
+        }
+
         /// This function gets called by the thread-manager whenever new work
         /// has been added, allowing the scheduler to reactivate one or more of
         /// possibly idling OS threads
         void do_some_work(std::size_t num_thread)
         {
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-            wait_count_.store(0, boost::memory_order_release);
+            // nobody is sleeping, nothing to do
+            if (num_parked_.load() == 0)
+                return;
 
-            if (num_thread == std::size_t(-1))
-                cond_.notify_all();
-            else
-                cond_.notify_one();
+            std::size_t num_threads = idle_backoff_data_.size();
+            if (num_thread < num_threads)
+            {
+                // the target thread will pick up the work if it is awake
+                unpark(num_thread);
+                return;
+            }
+
+            // no specific target, wake up one of the sleeping threads
+            std::size_t start = next_to_wake_++;
+            for (std::size_t i = 0; i != num_threads; ++i)
+            {
+                if (unpark((start + i) % num_threads))
+                    return;
+            }
+#endif
+        }
+
+        /// Wake up all OS threads which are currently sleeping
+        void do_all_work()
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            for (std::size_t i = 0; i != idle_backoff_data_.size(); ++i)
+                unpark(i);
+#endif
+        }
+
+        // number of times the given OS thread (or all of them) went to sleep
+        // and were woken up because of new work, respectively
+        std::int64_t get_num_parks(std::size_t num_thread, bool reset)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            return accumulate_idle_backoff_data(num_thread, reset,
+                &idle_backoff_data::park_count_);
+#else
+            return 0;
+#endif
+        }
+
+        std::int64_t get_num_unparks(std::size_t num_thread, bool reset)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            return accumulate_idle_backoff_data(num_thread, reset,
+                &idle_backoff_data::unpark_count_);
+#else
+            return 0;
+#endif
+        }
+
+        // average time [ns] between new work being announced for a sleeping
+        // OS thread and that thread resuming its work
+        std::int64_t get_average_wakeup_time(std::size_t num_thread,
+            bool reset)
+        {
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            std::int64_t time = accumulate_idle_backoff_data(num_thread,
+                reset, &idle_backoff_data::wakeup_time_);
+            std::int64_t count = accumulate_idle_backoff_data(num_thread,
+                reset, &idle_backoff_data::wakeup_count_);
+            return count == 0 ? 0 : time / count;
+#else
+            return 0;
 #endif
         }
 
@@ -248,6 +364,26 @@ namespace hpx { namespace threads { namespace policies
             bool reset) = 0;
         virtual std::int64_t get_num_stolen_to_staged(std::size_t num_thread,
             bool reset) = 0;
+
+        // Topology aware schedulers classify stolen work based on where it
+        // was stolen from: a core sharing a cache with the stealing core
+        // (local), the same NUMA domain (numa-local), or another NUMA domain
+        // (remote).
+        virtual std::int64_t get_num_stolen_local(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_stolen_numa_local(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
+        virtual std::int64_t get_num_stolen_remote(std::size_t num_thread,
+            bool reset)
+        {
+            return 0;
+        }
 #endif
 
         virtual std::int64_t get_queue_length(
@@ -272,6 +408,28 @@ namespace hpx { namespace threads { namespace policies
             thread_state_enum initial_state, bool run_now, error_code& ec,
             std::size_t num_thread) = 0;
 
+        /// Register task descriptions for all of the given threads (threads
+        /// with critical or boost priority are created right away) and wake
+        /// up sleeping worker threads, at most one per new task. Schedulers
+        /// may override this to distribute the tasks over their queues in one
+        /// pass.
+        virtual void create_work_bulk(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state, error_code& ec)
+        {
+            for (thread_init_data& d : data)
+            {
+                bool run_now = d.priority == thread_priority_critical ||
+                    d.priority == thread_priority_boost;
+                create_thread(d, nullptr, initial_state, run_now, ec,
+                    d.num_os_thread);
+                if (ec) return;
+            }
+
+            std::size_t count = (std::min)(data.size(), states_.size());
+            for (std::size_t i = 0; i != count; ++i)
+                do_some_work(std::size_t(-1));
+        }
+
         virtual bool get_next_thread(std::size_t num_thread, bool running,
             std::int64_t& idle_loop_count, threads::thread_data*& thrd) = 0;
 
@@ -312,15 +470,78 @@ namespace hpx { namespace threads { namespace policies
         boost::atomic<scheduler_mode> mode_;
 
 #if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
-        // support for suspension on idle queues
-        boost::mutex mtx_;
-        boost::condition_variable cond_;
-        boost::atomic<std::uint32_t> wait_count_;
+        // support for suspension on idle queues, one instance per OS thread
+        struct idle_backoff_data
+        {
+            idle_backoff_data()
+              : parked_(false), notified_(false), notify_time_(0),
+                park_count_(0), unpark_count_(0), wakeup_time_(0),
+                wakeup_count_(0)
+            {}
+
+            boost::mutex mtx_;
+            boost::condition_variable cond_;
+            boost::atomic<bool> parked_;
+            bool notified_;                 // protected by mtx_
+            boost::atomic<std::uint64_t> notify_time_;
+
+            boost::atomic<std::int64_t> park_count_;
+            boost::atomic<std::int64_t> unpark_count_;
+            boost::atomic<std::int64_t> wakeup_time_;
+            boost::atomic<std::int64_t> wakeup_count_;  // samples of the above
+
+            // avoid false sharing between OS threads
+            HPX_STATIC_CONSTEXPR std::size_t padding_size =
+                BOOST_LOCKFREE_CACHELINE_BYTES -
+                    (sizeof(boost::mutex) + sizeof(boost::condition_variable) +
+                        sizeof(boost::atomic<bool>) + sizeof(bool) +
+                        5 * sizeof(boost::atomic<std::int64_t>)) %
+                    BOOST_LOCKFREE_CACHELINE_BYTES;
+            char padding_[padding_size];
+        };
+
+        bool unpark(std::size_t num_thread)
+        {
+            idle_backoff_data& d = idle_backoff_data_[num_thread];
+            if (!d.parked_.load())
+                return false;
+
+            d.notify_time_.store(util::high_resolution_clock::now(),
+                boost::memory_order_relaxed);
+            {
+                boost::unique_lock<boost::mutex> l(d.mtx_);
+                d.notified_ = true;
+            }
+            d.cond_.notify_one();
+            return true;
+        }
+
+        std::int64_t accumulate_idle_backoff_data(std::size_t num_thread,
+            bool reset, boost::atomic<std::int64_t> idle_backoff_data::* value)
+        {
+            if (num_thread == std::size_t(-1))
+            {
+                std::int64_t result = 0;
+                for (idle_backoff_data& d : idle_backoff_data_)
+                    result += util::get_and_reset_value(d.*value, reset);
+                return result;
+            }
+
+            HPX_ASSERT(num_thread < idle_backoff_data_.size());
+            return util::get_and_reset_value(
+                idle_backoff_data_[num_thread].*value, reset);
+        }
+
+        std::vector<idle_backoff_data> idle_backoff_data_;
+        boost::atomic<std::int32_t> num_parked_;
+        boost::atomic<std::size_t> next_to_wake_;
 #endif
 
         std::vector<boost::atomic<hpx::state> > states_;
         char const* description_;
 
+        timer_wheel timers_;
+
 #if defined(HPX_HAVE_SCHEDULER_LOCAL_STORAGE)
     public:
         coroutines::detail::tss_data_node* find_tss_data(void const* key)
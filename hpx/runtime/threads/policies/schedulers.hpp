@@ -27,5 +27,8 @@
 #if defined(HPX_HAVE_PERIODIC_PRIORITY_SCHEDULER)
 #include <hpx/runtime/threads/policies/periodic_priority_queue_scheduler.hpp>
 #endif
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_priority_queue_scheduler.hpp>
+#endif
 
 #endif
@@ -38,7 +38,7 @@ namespace hpx { namespace threads { namespace policies
     /// This scheduler does not do any work stealing.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class HPX_EXPORT static_priority_queue_scheduler
         : public local_priority_queue_scheduler<
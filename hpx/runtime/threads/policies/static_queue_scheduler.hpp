@@ -49,7 +49,7 @@ namespace hpx { namespace threads { namespace policies
     /// from.
     template <typename Mutex = boost::mutex,
         typename PendingQueuing = lockfree_fifo,
-        typename StagedQueuing = lockfree_fifo,
+        typename StagedQueuing = lockfree_staged_ring,
         typename TerminatedQueuing = lockfree_lifo>
     class static_queue_scheduler
         : public local_queue_scheduler<
@@ -0,0 +1,186 @@
+//  Copyright (c) 2007-2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_POLICIES_THREAD_MAP_JAN_12_2017_0240PM)
+#define HPX_THREADMANAGER_POLICIES_THREAD_MAP_JAN_12_2017_0240PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/config_entry.hpp>
+#include <hpx/runtime/threads/thread_data.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/spinlock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace std
+{
+    template <>
+    struct hash< ::hpx::threads::thread_id_type>
+    {
+        typedef ::hpx::threads::thread_id_type argument_type;
+        typedef std::size_t result_type;
+
+        std::size_t operator()(::hpx::threads::thread_id_type const& v) const
+        {
+            std::hash<std::size_t> hasher_;
+            return hasher_(reinterpret_cast<std::size_t>(v.get()));
+        }
+    };
+}
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    namespace detail
+    {
+        inline std::size_t get_thread_map_shards()
+        {
+            static std::size_t thread_map_shards =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.thread_queue.thread_map_shards", "16"));
+            return thread_map_shards;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The thread_map holds the ids of all threads (except depleted ones)
+    // managed by a thread_queue. It is split into a number of shards, each of
+    // which is protected by its own spinlock. A thread id is mapped onto its
+    // shard based on the address of the referenced thread object. This
+    // decouples the bookkeeping of live threads from the thread_queue mutex
+    // and spreads concurrent insertions and removals (as caused by thread
+    // creation and cleanup from different cores) over independent locks.
+    class thread_map
+    {
+    private:
+        // The map is accessed by the scheduling loop, which may not run on an
+        // HPX thread, thus a lock which never suspends the calling thread is
+        // used. The critical sections are short (a single hash set lookup).
+        typedef util::spinlock mutex_type;
+        typedef std::unordered_set<thread_id_type> map_type;
+
+        struct shard
+        {
+            shard() {}
+
+            mutex_type mtx_;
+            map_type map_;
+
+            // avoid false sharing between neighboring shards
+            HPX_STATIC_CONSTEXPR std::size_t padding_size =
+                BOOST_LOCKFREE_CACHELINE_BYTES -
+                    (sizeof(mutex_type) + sizeof(map_type)) %
+                        BOOST_LOCKFREE_CACHELINE_BYTES;
+            char padding_[padding_size];
+        };
+
+        // round the number of shards up to the next power of two
+        static std::size_t normalize_shards(std::size_t num_shards)
+        {
+            std::size_t result = 1;
+            while (result < num_shards)
+                result <<= 1;
+            return result;
+        }
+
+        shard& get_shard(thread_data const* thrd) const
+        {
+            // thread objects are allocated from a pool of equally sized
+            // chunks, thus the lower bits of their address do not carry
+            // much information
+            std::size_t v = reinterpret_cast<std::size_t>(thrd);
+            return shards_[((v >> 6) ^ (v >> 12)) & (shards_.size() - 1)];
+        }
+
+    public:
+        explicit thread_map(
+                std::size_t num_shards = detail::get_thread_map_shards())
+          : shards_(normalize_shards(num_shards)),
+            count_(0)
+        {}
+
+        /// Add the given thread to the map, returns false if the thread was
+        /// already known.
+        bool insert(thread_id_type const& id)
+        {
+            shard& s = get_shard(id.get());
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                if (!s.map_.insert(id).second)
+                    return false;
+            }
+            ++count_;
+            return true;
+        }
+
+        /// Remove the given thread from the map. The removed id is handed
+        /// back through \a id, this makes sure that the thread object is not
+        /// released while the lock of the shard is being held.
+        bool erase(thread_data* thrd, thread_id_type& id)
+        {
+            shard& s = get_shard(thrd);
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                map_type::iterator it = s.map_.find(thrd);
+                if (it == s.map_.end())
+                    return false;
+
+                id = *it;
+                s.map_.erase(it);
+            }
+            --count_;
+            HPX_ASSERT(count_ >= 0);
+            return true;
+        }
+
+        bool contains(thread_data* thrd) const
+        {
+            shard& s = get_shard(thrd);
+            std::lock_guard<mutex_type> lk(s.mtx_);
+            return s.map_.find(thrd) != s.map_.end();
+        }
+
+        std::int64_t size() const
+        {
+            return count_.load(boost::memory_order_relaxed);
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        /// Invoke the given function for all threads in the map. The shards
+        /// are visited one by one while holding the corresponding lock, thus
+        /// the function must not modify the map.
+        template <typename F>
+        void for_each(F && f) const
+        {
+            for (shard& s : shards_)
+            {
+                std::lock_guard<mutex_type> lk(s.mtx_);
+                for (thread_id_type const& id : s.map_)
+                    f(id);
+            }
+        }
+
+    private:
+        mutable std::vector<shard> shards_;
+        boost::atomic<std::int64_t> count_;
+    };
+}}}
+
+#endif
@@ -12,6 +12,7 @@
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
 #include <hpx/runtime/threads/policies/queue_helpers.hpp>
+#include <hpx/runtime/threads/policies/thread_map.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/util/assert.hpp>
@@ -20,6 +21,7 @@
 #include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/high_resolution_clock.hpp>
 #include <hpx/util/unlock_guard.hpp>
+#include <hpx/util/unused.hpp>
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
 #   include <hpx/util/tick_counter.hpp>
@@ -36,27 +38,9 @@
 #include <map>
 #include <memory>
 #include <mutex>
-#include <unordered_set>
 #include <utility>
 #include <vector>
 
-///////////////////////////////////////////////////////////////////////////////
-namespace std
-{
-    template <>
-    struct hash< ::hpx::threads::thread_id_type>
-    {
-        typedef ::hpx::threads::thread_id_type argument_type;
-        typedef std::size_t result_type;
-
-        std::size_t operator()(::hpx::threads::thread_id_type const& v) const
-        {
-            std::hash<std::size_t> hasher_;
-            return hasher_(reinterpret_cast<std::size_t>(v.get()));
-        }
-    };
-}
-
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads { namespace policies
 {
@@ -173,8 +157,12 @@ namespace hpx { namespace threads { namespace policies
         // number of terminated threads to discard
         int const max_delete_count;
 
-        // this is the type of a map holding all threads (except depleted ones)
-        typedef std::unordered_set<thread_id_type> thread_map_type;
+        // maximum number of staged tasks claimed at once
+        HPX_STATIC_CONSTEXPR std::size_t max_add_new_batch = 64;
+
+        // this is the type of a map holding all threads (except depleted ones),
+        // it is not protected by the queue mutex
+        typedef policies::thread_map thread_map_type;
 
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
         typedef
@@ -227,6 +215,10 @@ namespace hpx { namespace threads { namespace policies
             {
                 heap = &thread_heap_huge_;
             }
+            else if (stacksize == get_stack_size(thread_stacksize_nostack))
+            {
+                heap = &thread_heap_nostack_;
+            }
             else {
                 switch(stacksize) {
                 case thread_stacksize_small:
@@ -245,6 +237,10 @@ namespace hpx { namespace threads { namespace policies
                     heap = &thread_heap_huge_;
                     break;
 
+                case thread_stacksize_nostack:
+                    heap = &thread_heap_nostack_;
+                    break;
+
                 default:
                     break;
                 }
@@ -285,55 +281,83 @@ namespace hpx { namespace threads { namespace policies
                 return 0;
 
             std::size_t added = 0;
-            task_description* task = nullptr;
-            while (add_count-- && addfrom->new_tasks_.pop(task, steal))
+
+            // claim the staged tasks in batches, this requires a single atomic
+            // operation per batch for backends supporting it
+            task_description* tasks[max_add_new_batch];
+            while (add_count != 0)
             {
-#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
-                if (maintain_queue_wait_times) {
-                    addfrom->new_tasks_wait_ +=
-                        util::high_resolution_clock::now() - util::get<2>(*task);
-                    ++addfrom->new_tasks_wait_count_;
-                }
-#endif
-                --addfrom->new_tasks_count_;
+                std::size_t batch = max_add_new_batch;
+                if (add_count > 0 && std::size_t(add_count) < batch)
+                    batch = std::size_t(add_count);
 
-                // measure thread creation time
-                util::block_profiler_wrapper<add_new_tag> bp(add_new_logger_);
+                std::size_t count = policies::pop_bulk(
+                    addfrom->new_tasks_, tasks, batch, steal);
+                if (count == 0)
+                    break;
 
-                // create the new thread
-                threads::thread_init_data& data = util::get<0>(*task);
-                thread_state_enum state = util::get<1>(*task);
-                threads::thread_id_type thrd;
+                addfrom->new_tasks_count_ -= std::int64_t(count);
+                if (add_count > 0)
+                    add_count -= std::int64_t(count);
+
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    task_description* task = tasks[i];
 
-                create_thread_object(thrd, data, state, lk);
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                    if (maintain_queue_wait_times) {
+                        addfrom->new_tasks_wait_ +=
+                            util::high_resolution_clock::now() -
+                                util::get<2>(*task);
+                        ++addfrom->new_tasks_wait_count_;
+                    }
+#endif
 
-                delete task;
+                    // measure thread creation time
+                    util::block_profiler_wrapper<add_new_tag> bp(
+                        add_new_logger_);
+
+                    // create the new thread
+                    threads::thread_init_data& data = util::get<0>(*task);
+                    thread_state_enum state = util::get<1>(*task);
+                    threads::thread_id_type thrd;
+
+                    create_thread_object(thrd, data, state, lk);
+
+                    delete task;
+
+                    // add the new entry to the map of all threads
+                    if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                        // give back the tasks not converted yet
+                        for (++i; i != count; ++i)
+                        {
+                            ++addfrom->new_tasks_count_;
+                            addfrom->new_tasks_.push(tasks[i]);
+                        }
+
+                        lk.unlock();
+                        HPX_THROW_EXCEPTION(hpx::out_of_memory,
+                            "threadmanager::add_new",
+                            "Couldn't add new thread to the thread map");
+                        return 0;
+                    }
 
-                // add the new entry to the map of all threads
-                std::pair<thread_map_type::iterator, bool> p =
-                    thread_map_.insert(thrd);
+                    // only insert the thread into the work-items queue if it
+                    // is in pending state
+                    if (state == pending) {
+                        // pushing the new thread into the pending queue of the
+                        // specified thread_queue
+                        ++added;
+                        schedule_thread(thrd.get());
+                    }
 
-                if (HPX_UNLIKELY(!p.second)) {
-                    lk.unlock();
-                    HPX_THROW_EXCEPTION(hpx::out_of_memory,
-                        "threadmanager::add_new",
-                        "Couldn't add new thread to the thread map");
-                    return 0;
-                }
-                ++thread_map_count_;
-
-                // only insert the thread into the work-items queue if it is in
-                // pending state
-                if (state == pending) {
-                    // pushing the new thread into the pending queue of the
-                    // specified thread_queue
-                    ++added;
-                    schedule_thread(thrd.get());
+                    // this thread has to be in the map now
+                    HPX_ASSERT(thread_map_.contains(thrd.get()));
+                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
                 }
 
-                // this thread has to be in the map now
-                HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                if (count != batch)
+                    break;
             }
 
             if (added) {
@@ -358,7 +382,8 @@ namespace hpx { namespace threads { namespace policies
             // if we are desperate (no work in the queues), add some even if the
             // map holds more than max_count
             if (HPX_LIKELY(max_count_)) {
-                std::size_t count = thread_map_.size();
+                std::size_t count =
+                    static_cast<std::size_t>(thread_map_.size());
                 if (max_count_ >= count + min_add_new_count) { //-V104
                     HPX_ASSERT(max_count_ - count <
                         static_cast<std::size_t>(
@@ -386,7 +411,7 @@ namespace hpx { namespace threads { namespace policies
 
         void recycle_thread(thread_id_type thrd)
         {
-            std::ptrdiff_t stacksize = thrd->get_stack_size();
+            std::ptrdiff_t stacksize = thrd->get_requested_stack_size();
 
             if (stacksize == get_stack_size(thread_stacksize_small))
             {
@@ -404,6 +429,10 @@ namespace hpx { namespace threads { namespace policies
             {
                 thread_heap_huge_.push_front(thrd);
             }
+            else if (stacksize == get_stack_size(thread_stacksize_nostack))
+            {
+                thread_heap_nostack_.push_front(thrd);
+            }
             else
             {
                 switch(stacksize) {
@@ -423,6 +452,10 @@ namespace hpx { namespace threads { namespace policies
                     thread_heap_huge_.push_front(thrd);
                     break;
 
+                case thread_stacksize_nostack:
+                    thread_heap_nostack_.push_front(thrd);
+                    break;
+
                 default:
                     HPX_ASSERT(false);
                     break;
@@ -452,15 +485,12 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    // this thread has to be in this map
-                    HPX_ASSERT(thread_map_.find(todelete) != thread_map_.end());
-
-                    bool deleted = thread_map_.erase(todelete) != 0;
+                    // this thread has to be in this map, the thread object is
+                    // released once 'id' goes out of scope
+                    thread_id_type id;
+                    bool deleted = thread_map_.erase(todelete, id);
                     HPX_ASSERT(deleted);
-                    if (deleted) {
-                        --thread_map_count_;
-                        HPX_ASSERT(thread_map_count_ >= 0);
-                    }
+                    HPX_UNUSED(deleted);
                 }
             }
             else {
@@ -475,16 +505,12 @@ namespace hpx { namespace threads { namespace policies
                 {
                     --terminated_items_count_;
 
-                    thread_map_type::iterator it = thread_map_.find(todelete);
-
                     // this thread has to be in this map
-                    HPX_ASSERT(it != thread_map_.end());
-
-                    recycle_thread(*it);
-
-                    thread_map_.erase(it);
-                    --thread_map_count_;
-                    HPX_ASSERT(thread_map_count_ >= 0);
+                    thread_id_type id;
+                    bool deleted = thread_map_.erase(todelete, id);
+                    HPX_ASSERT(deleted);
+                    if (deleted)
+                        recycle_thread(id);
 
                     --delete_count;
                 }
@@ -502,7 +528,7 @@ namespace hpx { namespace threads { namespace policies
         bool cleanup_terminated(bool delete_all = false)
         {
             if (terminated_items_count_ == 0)
-                return thread_map_count_ == 0;
+                return thread_map_.empty();
 
             if (delete_all) {
                 // do not lock mutex while deleting all threads, do it piece-wise
@@ -513,7 +539,7 @@ namespace hpx { namespace threads { namespace policies
                     if (cleanup_terminated_locked_helper(false))
                     {
                         thread_map_is_empty =
-                            (thread_map_count_ == 0) && (new_tasks_count_ == 0);
+                            thread_map_.empty() && (new_tasks_count_ == 0);
                         break;
                     }
                 }
@@ -522,7 +548,7 @@ namespace hpx { namespace threads { namespace policies
 
             std::lock_guard<mutex_type> lk(mtx_);
             return cleanup_terminated_locked_helper(false) &&
-                (thread_map_count_ == 0) && (new_tasks_count_ == 0);
+                thread_map_.empty() && (new_tasks_count_ == 0);
         }
 
         // The maximum number of active threads this thread manager should
@@ -539,7 +565,7 @@ namespace hpx { namespace threads { namespace policies
             min_add_new_count(detail::get_min_add_new_count()),
             max_add_new_count(detail::get_max_add_new_count()),
             max_delete_count(detail::get_max_delete_count()),
-            thread_map_count_(0),
+            thread_map_(),
             work_items_(128, queue_num),
             work_items_count_(0),
 #ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
@@ -562,6 +588,7 @@ namespace hpx { namespace threads { namespace policies
             thread_heap_medium_(),
             thread_heap_large_(),
             thread_heap_huge_(),
+            thread_heap_nostack_(),
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
             add_new_time_(0),
             cleanup_terminated_time_(0),
@@ -716,39 +743,35 @@ namespace hpx { namespace threads { namespace policies
 
                 // The mutex can not be locked while a new thread is getting
                 // created, as it might have that the current HPX thread gets
-                // suspended.
+                // suspended. It is needed only for accessing the heaps of
+                // recycled thread objects.
                 {
                     std::unique_lock<mutex_type> lk(mtx_);
-
                     create_thread_object(thrd, data, initial_state, lk);
+                }
 
-                    // add a new entry in the map for this thread
-                    std::pair<thread_map_type::iterator, bool> p =
-                        thread_map_.insert(thrd);
-
-                    if (HPX_UNLIKELY(!p.second)) {
-                        HPX_THROWS_IF(ec, hpx::out_of_memory,
-                            "threadmanager::register_thread",
-                            "Couldn't add new thread to the map of threads");
-                        return;
-                    }
-                    ++thread_map_count_;
+                // add a new entry in the map for this thread
+                if (HPX_UNLIKELY(!thread_map_.insert(thrd))) {
+                    HPX_THROWS_IF(ec, hpx::out_of_memory,
+                        "threadmanager::register_thread",
+                        "Couldn't add new thread to the map of threads");
+                    return;
+                }
 
-                    // this thread has to be in the map now
-                    HPX_ASSERT(thread_map_.find(thrd.get()) != thread_map_.end());
-                    HPX_ASSERT(thrd->get_pool() == &memory_pool_);
+                // this thread has to be in the map now
+                HPX_ASSERT(thread_map_.contains(thrd.get()));
+                HPX_ASSERT(thrd->get_pool() == &memory_pool_);
 
-                    // push the new thread in the pending queue thread
-                    if (initial_state == pending)
-                        schedule_thread(thrd.get());
+                // push the new thread in the pending queue thread
+                if (initial_state == pending)
+                    schedule_thread(thrd.get());
 
-                    // return the thread_id of the newly created thread
-                    if (id) *id = std::move(thrd);
+                // return the thread_id of the newly created thread
+                if (id) *id = std::move(thrd);
 
-                    if (&ec != &throws)
-                        ec = make_success_code();
-                    return;
-                }
+                if (&ec != &throws)
+                    ec = make_success_code();
+                return;
             }
 
             // do not execute the work, but register a task description for
@@ -768,6 +791,41 @@ namespace hpx { namespace threads { namespace policies
                 ec = make_success_code();
         }
 
+        // register task descriptions for all of the given threads for later
+        // thread creation, this updates the count of staged tasks only once
+        void create_work_bulk(thread_init_data* const* data, std::size_t count,
+            thread_state_enum initial_state)
+        {
+            new_tasks_count_ += std::int64_t(count);
+
+            task_description* tasks[max_add_new_batch];
+            while (count != 0)
+            {
+                std::size_t batch = max_add_new_batch;
+                if (count < batch)
+                    batch = count;
+                for (std::size_t i = 0; i != batch; ++i)
+                {
+#ifdef HPX_HAVE_THREAD_QUEUE_WAITTIME
+                    tasks[i] = new task_description(
+                        std::move(*data[i]), initial_state,
+                        util::high_resolution_clock::now());
+#else
+                    tasks[i] = new task_description( //-V106
+                        std::move(*data[i]), initial_state);
+#endif
+                }
+
+                std::size_t pushed =
+                    policies::push_bulk(new_tasks_, tasks, batch);
+                for (/**/; pushed != batch; ++pushed)
+                    new_tasks_.push(tasks[pushed]);
+
+                data += batch;
+                count -= batch;
+            }
+        }
+
         void move_work_items_from(thread_queue *src, std::int64_t count)
         {
             thread_description* trd;
@@ -901,35 +959,39 @@ namespace hpx { namespace threads { namespace policies
                 return new_tasks_count_;
 
             if (unknown == state)
-                return thread_map_count_ + new_tasks_count_ - terminated_items_count_;
-
-            // acquire lock only if absolutely necessary
-            std::lock_guard<mutex_type> lk(mtx_);
-
-            std::int64_t num_threads = 0;
-            thread_map_type::const_iterator end = thread_map_.end();
-            for (thread_map_type::const_iterator it = thread_map_.begin();
-                 it != end; ++it)
             {
-                if ((*it)->get_state().state() == state)
-                    ++num_threads;
+                return thread_map_.size() + new_tasks_count_ -
+                    terminated_items_count_;
             }
+
+            std::int64_t num_threads = 0;
+            thread_map_.for_each(
+                [&](thread_id_type const& id)
+                {
+                    if (id->get_state().state() == state)
+                        ++num_threads;
+                });
             return num_threads;
         }
 
         ///////////////////////////////////////////////////////////////////////
         void abort_all_suspended_threads()
         {
-            std::lock_guard<mutex_type> lk(mtx_);
-            thread_map_type::iterator end =  thread_map_.end();
-            for (thread_map_type::iterator it = thread_map_.begin();
-                 it != end; ++it)
-            {
-                if ((*it)->get_state().state() == suspended)
+            // the threads are rescheduled only after the locks of the thread
+            // map have been released, this keeps the scheduler from being
+            // called while holding them
+            std::vector<thread_id_type> ids;
+            thread_map_.for_each(
+                [&ids](thread_id_type const& id)
                 {
-                    (*it)->set_state(pending, wait_abort);
-                    schedule_thread((*it).get());
-                }
+                    if (id->get_state().state() == suspended)
+                        ids.push_back(id);
+                });
+
+            for (thread_id_type const& id : ids)
+            {
+                id->set_state(pending, wait_abort);
+                schedule_thread(id.get());
             }
         }
 
@@ -937,7 +999,8 @@ namespace hpx { namespace threads { namespace policies
             util::function_nonser<bool(thread_id_type)> const& f,
             thread_state_enum state = unknown) const
         {
-            std::uint64_t count = thread_map_count_;
+            std::uint64_t count =
+                static_cast<std::uint64_t>(thread_map_.size());
             if (state == terminated)
             {
                 count = terminated_items_count_;
@@ -955,24 +1018,20 @@ namespace hpx { namespace threads { namespace policies
 
             if (state == unknown)
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids](thread_id_type const& id)
+                    {
+                        ids.push_back(id);
+                    });
             }
             else
             {
-                std::lock_guard<mutex_type> lk(mtx_);
-                thread_map_type::const_iterator end =  thread_map_.end();
-                for (thread_map_type::const_iterator it = thread_map_.begin();
-                     it != end; ++it)
-                {
-                    if ((*it)->get_state().state() == state)
-                        ids.push_back(*it);
-                }
+                thread_map_.for_each(
+                    [&ids, state](thread_id_type const& id)
+                    {
+                        if (id->get_state().state() == state)
+                            ids.push_back(id);
+                    });
             }
 
             // now invoke callback function for all matching threads
@@ -1059,8 +1118,16 @@ namespace hpx { namespace threads { namespace policies
             return false;
 #else
             if (minimal_deadlock_detection) {
-                std::lock_guard<mutex_type> lk(mtx_);
-                return detail::dump_suspended_threads(num_thread, thread_map_
+                // take a snapshot of the current threads, this avoids holding
+                // any of the locks of the thread map while logging
+                std::vector<thread_id_type> ids;
+                ids.reserve(static_cast<std::size_t>(thread_map_.size()));
+                thread_map_.for_each(
+                    [&ids](thread_id_type const& id)
+                    {
+                        ids.push_back(id);
+                    });
+                return detail::dump_suspended_threads(num_thread, ids
                   , idle_loop_count, running);
             }
             return false;
@@ -1068,7 +1135,12 @@ namespace hpx { namespace threads { namespace policies
         }
 
         ///////////////////////////////////////////////////////////////////////
-        void on_start_thread(std::size_t num_thread) {}
+        void on_start_thread(std::size_t num_thread)
+        {
+            // the worker thread this queue belongs to is the owner of the
+            // pending queue
+            policies::bind_owner(work_items_);
+        }
         void on_stop_thread(std::size_t num_thread) {}
         void on_error(std::size_t num_thread, boost::exception_ptr const& e) {}
 
@@ -1076,9 +1148,8 @@ namespace hpx { namespace threads { namespace policies
         mutable mutex_type mtx_;                    ///< mutex protecting the members
 
         thread_map_type thread_map_;
-        ///< mapping of thread id's to HPX-threads
-        boost::atomic<std::int64_t> thread_map_count_;
-        ///< overall count of work items
+        ///< mapping of thread id's to HPX-threads, also keeps the overall
+        ///< count of work items
 
         work_items_type work_items_;
         ///< list of active work items
@@ -1116,6 +1187,7 @@ namespace hpx { namespace threads { namespace policies
         std::list<thread_id_type> thread_heap_medium_;
         std::list<thread_id_type> thread_heap_large_;
         std::list<thread_id_type> thread_heap_huge_;
+        std::list<thread_id_type> thread_heap_nostack_;
 
 #ifdef HPX_HAVE_THREAD_CREATION_AND_CLEANUP_RATES
         std::uint64_t add_new_time_;
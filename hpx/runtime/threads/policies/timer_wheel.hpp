@@ -0,0 +1,372 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_THREADMANAGER_POLICIES_TIMER_WHEEL_FEB_20_2017_0614PM)
+#define HPX_THREADMANAGER_POLICIES_TIMER_WHEEL_FEB_20_2017_0614PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/steady_clock.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace threads { namespace policies
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A hierarchical timing wheel (see "Hashed and Hierarchical Timing
+    /// Wheels" by G. Varghese and T. Lauck) holding the pending timers of a
+    /// scheduler.
+    ///
+    /// Timers may be added concurrently from any thread, this pushes them
+    /// onto a lock-free list of new timers only. The wheel is advanced by the
+    /// worker threads of the scheduler (see process()), only one of them at a
+    /// time will move the new timers into their slots, cascade timers from the
+    /// higher levels, and collect all expired timers. The expired timers are
+    /// fired in one batch after the wheel has been released again.
+    ///
+    /// Canceling a timer is O(1): it just marks the timer, the wheel releases
+    /// canceled timers whenever it encounters them.
+    class timer_wheel
+    {
+    public:
+        ///////////////////////////////////////////////////////////////////////
+        class entry
+        {
+        private:
+            HPX_NON_COPYABLE(entry);
+
+            enum state
+            {
+                armed = 0,
+                expired = 1,
+                canceled = 2
+            };
+
+        public:
+            entry()
+              : deadline_(0), next_(nullptr), state_(armed), count_(1)
+            {}
+
+            virtual ~entry() {}
+
+            /// Mark this timer as canceled. Returns false if the timer has
+            /// expired (or was canceled) already.
+            bool cancel()
+            {
+                int expected = armed;
+                return state_.compare_exchange_strong(expected, canceled);
+            }
+
+            /// Release the reference to this timer held by the caller.
+            void release()
+            {
+                if (--count_ == 0)
+                    delete this;
+            }
+
+        protected:
+            /// Will be called exactly once if the timer expires before it has
+            /// been canceled.
+            virtual void expire() = 0;
+
+        private:
+            friend class timer_wheel;
+
+            // returns whether the timer has to be fired
+            bool try_expire()
+            {
+                int expected = armed;
+                return state_.compare_exchange_strong(expected, expired);
+            }
+
+            bool is_canceled() const
+            {
+                return state_.load(boost::memory_order_relaxed) == canceled;
+            }
+
+            std::uint64_t deadline_;    // in ticks of the wheel
+            entry* next_;
+            boost::atomic<int> state_;
+            boost::atomic<int> count_;
+        };
+
+    private:
+        HPX_NON_COPYABLE(timer_wheel);
+
+        HPX_STATIC_CONSTEXPR std::size_t num_levels = 4;
+        HPX_STATIC_CONSTEXPR std::size_t slot_bits = 8;
+        HPX_STATIC_CONSTEXPR std::size_t num_slots = std::size_t(1) << slot_bits;
+        HPX_STATIC_CONSTEXPR std::uint64_t slot_mask = num_slots - 1;
+
+        // the largest distance (in ticks) a timer can be placed ahead of the
+        // current tick, timers further in the future are re-inserted whenever
+        // the topmost level is cascaded
+        HPX_STATIC_CONSTEXPR std::uint64_t max_ticks =
+            (std::uint64_t(1) << (num_levels * slot_bits)) - 1;
+
+        HPX_STATIC_CONSTEXPR std::uint64_t no_deadline =
+            (std::numeric_limits<std::uint64_t>::max)();
+
+    public:
+        explicit timer_wheel(std::chrono::microseconds resolution =
+                std::chrono::microseconds(HPX_TIMER_WHEEL_RESOLUTION))
+          : epoch_(util::steady_clock::now()),
+            resolution_(std::chrono::duration_cast<
+                util::steady_clock::duration>(resolution)),
+            current_(0), size_(0),
+            new_timers_(nullptr), next_deadline_(no_deadline), busy_(false)
+        {
+            HPX_ASSERT(resolution_.count() > 0);
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                for (std::size_t slot = 0; slot != num_slots; ++slot)
+                    slots_[level][slot] = nullptr;
+            }
+        }
+
+        ~timer_wheel()
+        {
+            release_all(new_timers_.exchange(nullptr));
+            for (std::size_t level = 0; level != num_levels; ++level)
+            {
+                for (std::size_t slot = 0; slot != num_slots; ++slot)
+                    release_all(slots_[level][slot]);
+            }
+        }
+
+        /// Add the given timer to the wheel, it will expire as soon as the
+        /// wheel has been advanced past the given point in time. The wheel
+        /// holds its own reference to the timer.
+        void add(entry* e, util::steady_clock::time_point const& abs_time)
+        {
+            e->deadline_ = to_ticks(abs_time);
+            ++e->count_;
+
+            entry* head = new_timers_.load(boost::memory_order_relaxed);
+            do {
+                e->next_ = head;
+            } while (!new_timers_.compare_exchange_weak(head, e,
+                boost::memory_order_release, boost::memory_order_relaxed));
+
+            // make sure idle workers don't sleep past this deadline
+            std::uint64_t next = next_deadline_.load();
+            while (e->deadline_ < next &&
+                !next_deadline_.compare_exchange_weak(next, e->deadline_))
+                /**/;
+        }
+
+        /// Advance the wheel up to the current time and fire all timers which
+        /// have expired. Returns the number of fired timers. Does nothing if
+        /// some other thread is advancing the wheel concurrently.
+        std::size_t process()
+        {
+            if (new_timers_.load(boost::memory_order_relaxed) == nullptr &&
+                next_deadline_.load(boost::memory_order_relaxed) == no_deadline)
+            {
+                return 0;
+            }
+
+            std::uint64_t now = now_ticks();
+            if (new_timers_.load(boost::memory_order_relaxed) == nullptr &&
+                next_deadline_.load(boost::memory_order_relaxed) > now)
+            {
+                return 0;
+            }
+
+            if (busy_.exchange(true, boost::memory_order_acquire))
+                return 0;
+
+            entry* expired = nullptr;
+
+            // sort newly added timers into the wheel
+            entry* e = new_timers_.exchange(nullptr, boost::memory_order_acquire);
+            while (e != nullptr)
+            {
+                entry* next = e->next_;
+                insert(e, expired);
+                e = next;
+            }
+
+            advance(now, expired);
+
+            next_deadline_.store(next_deadline());
+            if (new_timers_.load() != nullptr)
+                next_deadline_.store(current_);
+
+            busy_.store(false, boost::memory_order_release);
+
+            // now fire all expired timers
+            std::size_t count = 0;
+            while (expired != nullptr)
+            {
+                entry* next = expired->next_;
+                if (expired->try_expire())
+                {
+                    expired->expire();
+                    ++count;
+                }
+                expired->release();
+                expired = next;
+            }
+            return count;
+        }
+
+        /// Return the time until the next timer will expire (or the maximal
+        /// duration if there is no pending timer).
+        util::steady_clock::duration time_until_next_expiry() const
+        {
+            std::uint64_t next = next_deadline_.load(boost::memory_order_relaxed);
+            if (next == no_deadline)
+                return (util::steady_clock::duration::max)();
+
+            util::steady_clock::time_point t = epoch_ +
+                util::steady_clock::duration(
+                    std::int64_t(next) * resolution_.count());
+            util::steady_clock::time_point now = util::steady_clock::now();
+            return t > now ? t - now : util::steady_clock::duration(0);
+        }
+
+    private:
+        // round up to the next tick, timers never expire early
+        std::uint64_t to_ticks(util::steady_clock::time_point const& t) const
+        {
+            if (t <= epoch_)
+                return 0;
+            return std::uint64_t(((t - epoch_).count() +
+                resolution_.count() - 1) / resolution_.count());
+        }
+
+        std::uint64_t now_ticks() const
+        {
+            return std::uint64_t((util::steady_clock::now() - epoch_).count() /
+                resolution_.count());
+        }
+
+        static void release_all(entry* e)
+        {
+            while (e != nullptr)
+            {
+                entry* next = e->next_;
+                e->release();
+                e = next;
+            }
+        }
+
+        // put the given timer into the slot of the lowest level which covers
+        // its deadline
+        void insert(entry* e, entry*& expired)
+        {
+            if (e->is_canceled())
+            {
+                e->release();
+                return;
+            }
+
+            if (e->deadline_ <= current_)
+            {
+                e->next_ = expired;
+                expired = e;
+                return;
+            }
+
+            std::uint64_t deadline = e->deadline_;
+            std::uint64_t delta = deadline - current_;
+            if (delta > max_ticks)
+            {
+                delta = max_ticks;
+                deadline = current_ + max_ticks;
+            }
+
+            std::size_t level = 0;
+            while (level != num_levels - 1 &&
+                delta >= (std::uint64_t(1) << ((level + 1) * slot_bits)))
+            {
+                ++level;
+            }
+
+            entry*& slot =
+                slots_[level][(deadline >> (level * slot_bits)) & slot_mask];
+            e->next_ = slot;
+            slot = e;
+            ++size_;
+        }
+
+        // re-distribute the timers from the given slot over the lower levels
+        void cascade(std::size_t level, std::size_t slot, entry*& expired)
+        {
+            entry* e = slots_[level][slot];
+            slots_[level][slot] = nullptr;
+            while (e != nullptr)
+            {
+                entry* next = e->next_;
+                --size_;
+                insert(e, expired);
+                e = next;
+            }
+        }
+
+        void advance(std::uint64_t now, entry*& expired)
+        {
+            while (current_ < now)
+            {
+                // nothing to do if the wheel is empty
+                if (size_ == 0)
+                {
+                    current_ = now;
+                    break;
+                }
+
+                std::uint64_t tick = ++current_;
+                for (std::size_t level = 1; level != num_levels; ++level)
+                {
+                    std::size_t shift = level * slot_bits;
+                    if ((tick & ((std::uint64_t(1) << shift) - 1)) != 0)
+                        break;
+                    cascade(level, (tick >> shift) & slot_mask, expired);
+                }
+                cascade(0, tick & slot_mask, expired);
+            }
+        }
+
+        // compute a lower bound for the next deadline of the timers in the
+        // wheel
+        std::uint64_t next_deadline() const
+        {
+            if (size_ == 0)
+                return no_deadline;
+
+            for (std::uint64_t tick = current_ + 1;
+                 tick != current_ + num_slots; ++tick)
+            {
+                if (slots_[0][tick & slot_mask] != nullptr)
+                    return tick;
+            }
+
+            // no timer in the lowest level, the next cascade has to happen
+            // anyways
+            return ((current_ >> slot_bits) + 1) << slot_bits;
+        }
+
+        util::steady_clock::time_point const epoch_;
+        util::steady_clock::duration const resolution_;
+
+        // the following are protected by busy_
+        std::uint64_t current_;
+        std::size_t size_;
+        entry* slots_[num_levels][num_slots];
+
+        boost::atomic<entry*> new_timers_;
+        boost::atomic<std::uint64_t> next_deadline_;
+        boost::atomic<bool> busy_;
+    };
+}}}
+
+#endif
@@ -496,7 +496,17 @@ namespace hpx { namespace threads
             return scheduler_base_;
         }
 
+        // Return the size of the stack owned by this thread, stackless
+        // threads run on the stack of the OS thread and report zero.
         std::ptrdiff_t get_stack_size() const
+        {
+            return stacksize_ == std::ptrdiff_t(thread_stacksize_nostack) ?
+                0 : stacksize_;
+        }
+
+        // Return the stack size this thread object was created with, this is
+        // thread_stacksize_nostack for stackless threads.
+        std::ptrdiff_t get_requested_stack_size() const
         {
             return stacksize_;
         }
@@ -652,7 +662,7 @@ namespace hpx { namespace threads
             exit_funcs_.clear();
             scheduler_base_ = init_data.scheduler_base;
 
-            HPX_ASSERT(init_data.stacksize == get_stack_size());
+            HPX_ASSERT(init_data.stacksize == get_requested_stack_size());
 
             LTM_(debug) << "thread::thread(" << this << "), description("
                         << get_description() << "), rebind";
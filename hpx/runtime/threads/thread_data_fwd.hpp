@@ -100,9 +100,16 @@ namespace hpx { namespace threads
     HPX_API_EXPORT std::size_t get_parent_phase();
 
     /// The function \a get_self_stacksize returns the stack size of the
-    /// current thread (or zero if the current thread is not a HPX thread).
+    /// current thread (or zero if the current thread is not a HPX thread or
+    /// is a stackless HPX thread).
     HPX_API_EXPORT std::size_t get_self_stacksize();
 
+    /// The function \a is_self_suspendable returns whether the current thread
+    /// is a HPX thread which can be suspended. This is not the case for
+    /// stackless HPX threads (see \a thread_stacksize_nostack) and for
+    /// threads which are not HPX threads.
+    HPX_API_EXPORT bool is_self_suspendable();
+
     /// The function \a get_parent_locality_id returns the id of the locality of
     /// the current thread's parent (or zero if the current thread is not a
     /// HPX thread).
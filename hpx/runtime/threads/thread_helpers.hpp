@@ -23,6 +23,7 @@
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace threads
@@ -900,6 +901,40 @@ namespace hpx { namespace applier
         threads::thread_init_data& data,
         threads::thread_state_enum initial_state = threads::pending,
         error_code& ec = throws);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create new work items for all of the given thread
+    ///        descriptions.
+    ///
+    /// \note This function is equivalent to calling
+    ///       threads#register_work_plain for each of the elements of
+    ///       \a data, except that the work items are handed to the scheduler
+    ///       at once, which distributes them over its queues in one pass.
+    ///       The elements of \a data are moved from.
+    ///
+    HPX_API_EXPORT void register_work_bulk(
+        std::vector<threads::thread_init_data>& data,
+        threads::thread_state_enum initial_state = threads::pending,
+        error_code& ec = throws);
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \brief Create new work items using the given functions as the work to
+    ///        be executed.
+    ///
+    /// \param funcs      [in] The functions to be executed as the
+    ///                   thread-functions, one new thread is created for each
+    ///                   of them (see \a threads#register_work_nullary).
+    ///
+    /// \note All other arguments are equivalent to those of the function
+    ///       \a threads#register_work_plain
+    ///
+    HPX_API_EXPORT void register_work_nullary_bulk(
+        std::vector<util::unique_function_nonser<void()> > && funcs,
+        util::thread_description const& description = util::thread_description(),
+        threads::thread_state_enum initial_state = threads::pending,
+        threads::thread_priority priority = threads::thread_priority_normal,
+        threads::thread_stacksize stacksize = threads::thread_stacksize_default,
+        error_code& ec = throws);
 }}
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -914,6 +949,8 @@ namespace hpx { namespace threads
     using applier::register_work_plain;
     using applier::register_work;
     using applier::register_work_nullary;
+    using applier::register_work_bulk;
+    using applier::register_work_nullary_bulk;
 }}
 
 /// \endcond
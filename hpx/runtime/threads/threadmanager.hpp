@@ -24,6 +24,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
@@ -104,6 +105,23 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             error_code& ec = throws) = 0;
 
+        /// The function \a register_work_bulk adds new work items for all of
+        /// the given thread descriptions to the thread manager. This is
+        /// equivalent to calling \a register_work for each of the elements
+        /// of \a data, except that the work items are distributed over the
+        /// queues of the scheduler in one pass.
+        ///
+        /// \param data   [in] The descriptions of the threads to create, the
+        ///               elements are moved from.
+        /// \param initial_state
+        ///               [in] The value of this parameter defines the initial
+        ///               state of the newly created threads (see
+        ///               \a register_work).
+        virtual void
+        register_work_bulk(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws) = 0;
+
         /// The function \a register_thread adds a new work item to the thread
         /// manager. It creates a new \a thread, adds it to the internal
         /// management data structures, and schedules the new thread, if
@@ -88,6 +88,13 @@ namespace hpx { namespace threads
             thread_state_enum initial_state = pending,
             error_code& ec = throws);
 
+        /// The function \a register_work_bulk adds new work items for all of
+        /// the given thread descriptions to the thread manager (see
+        /// \a threadmanager_base#register_work_bulk).
+        void register_work_bulk(std::vector<thread_init_data>& data,
+            thread_state_enum initial_state = pending,
+            error_code& ec = throws);
+
         /// The function \a register_thread adds a new work item to the thread
         /// manager. It creates a new \a thread, adds it to the internal
         /// management data structures, and schedules the new thread, if
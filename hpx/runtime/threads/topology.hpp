@@ -104,6 +104,24 @@ namespace hpx { namespace threads
         virtual mask_cref_type get_core_affinity_mask(std::size_t num_thread,
             bool numa_sensitive, error_code& ec = throws) const = 0;
 
+        /// \brief Return a bit mask where each set bit corresponds to a
+        ///        processing unit sharing the outermost L2 or L3 cache with
+        ///        the processing unit the given thread is running on. This
+        ///        returns the core affinity mask if no such cache is known.
+        ///
+        /// \param ec         [in,out] this represents the error status on exit,
+        ///                   if this is pre-initialized to \a hpx#throws
+        ///                   the function will throw on error instead.
+        virtual mask_cref_type get_cache_affinity_mask(std::size_t num_thread,
+            bool numa_sensitive, error_code& ec = throws) const;
+
+        /// \brief Return the relative distance between the two given NUMA
+        ///        domains. The values follow the conventions of the ACPI
+        ///        system locality information table (SLIT), i.e. the distance
+        ///        of a NUMA domain to itself is 10.
+        virtual std::size_t get_numa_node_distance(std::size_t numa_node1,
+            std::size_t numa_node2) const;
+
         /// \brief Return a bit mask where each set bit corresponds to a
         ///        processing unit available to the given thread.
         ///
@@ -29,7 +29,7 @@ namespace hpx { namespace util { namespace detail {
 #endif
         else if(k < 32 || k & 1) //-V112
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::threads::is_self_suspendable())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(0);
@@ -46,7 +46,7 @@ namespace hpx { namespace util { namespace detail {
         }
         else
         {
-            if(!hpx::threads::get_self_ptr())
+            if(!hpx::threads::is_self_suspendable())
             {
 #if defined(HPX_WINDOWS)
                 Sleep(1);
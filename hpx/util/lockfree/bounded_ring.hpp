@@ -0,0 +1,247 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithm from the bounded multi-producer/multi-consumer queue by D. Vyukov
+//  (http://www.1024cores.net/home/lock-free-algorithms/queues/bounded-mpmc-queue)
+//
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  Every cell of the ring carries a sequence number telling producers and
+//  consumers whether the cell is ready for them in the current lap around the
+//  ring. Pushing and popping a single element requires one CAS on the
+//  enqueue or dequeue position. Producers and consumers can claim any number
+//  of consecutive cells with a single CAS as well (see push_bulk and
+//  pop_bulk).
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_BOUNDED_RING_FEB_22_2017_0943AM)
+#define HPX_UTIL_LOCKFREE_BOUNDED_RING_FEB_22_2017_0943AM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+
+namespace boost { namespace lockfree
+{
+
+template <typename T>
+struct bounded_ring
+{
+private:
+    struct cell
+    {
+        boost::atomic<std::size_t> sequence_;
+        T data_;
+    };
+
+    // round the requested capacity up to the next power of two
+    static std::size_t normalize_capacity(std::size_t capacity)
+    {
+        std::size_t result = 2;
+        while (result < capacity)
+            result <<= 1;
+        return result;
+    }
+
+public:
+    typedef T value_type;
+
+    explicit bounded_ring(std::size_t capacity)
+      : mask_(normalize_capacity(capacity) - 1),
+        buffer_(new cell[mask_ + 1]),
+        enqueue_pos_(0), dequeue_pos_(0)
+    {
+        for (std::size_t i = 0; i != mask_ + 1; ++i)
+            buffer_[i].sequence_.store(i, boost::memory_order_relaxed);
+    }
+
+    ~bounded_ring()
+    {
+        delete [] buffer_;
+    }
+
+    bounded_ring(bounded_ring const&) = delete;
+    bounded_ring& operator=(bounded_ring const&) = delete;
+
+    std::size_t capacity() const
+    {
+        return mask_ + 1;
+    }
+
+    // Returns false if the ring is full.
+    bool push(T const& val)
+    {
+        cell* c = nullptr;
+        std::size_t pos = enqueue_pos_.load(boost::memory_order_relaxed);
+        for (;;)
+        {
+            c = &buffer_[pos & mask_];
+            std::size_t seq = c->sequence_.load(boost::memory_order_acquire);
+            std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+            if (diff == 0)
+            {
+                if (enqueue_pos_.compare_exchange_weak(pos, pos + 1,
+                        boost::memory_order_relaxed))
+                {
+                    break;
+                }
+            }
+            else if (diff < 0)
+            {
+                return false;
+            }
+            else
+            {
+                pos = enqueue_pos_.load(boost::memory_order_relaxed);
+            }
+        }
+
+        c->data_ = val;
+        c->sequence_.store(pos + 1, boost::memory_order_release);
+        return true;
+    }
+
+    // Push up to count elements using a single CAS, returns the number of
+    // elements taken from vals.
+    std::size_t push_bulk(T const* vals, std::size_t count)
+    {
+        HPX_ASSERT(count != 0);
+
+        std::size_t pos = enqueue_pos_.load(boost::memory_order_relaxed);
+        for (;;)
+        {
+            // find out how many cells are free to be filled
+            std::size_t free = 0;
+            while (free != count && free != mask_ + 1)
+            {
+                std::size_t seq = buffer_[(pos + free) & mask_].
+                    sequence_.load(boost::memory_order_acquire);
+                if (seq != pos + free)
+                    break;
+                ++free;
+            }
+
+            if (free == 0)
+            {
+                std::size_t seq = buffer_[pos & mask_].
+                    sequence_.load(boost::memory_order_acquire);
+                std::ptrdiff_t diff = std::ptrdiff_t(seq) - std::ptrdiff_t(pos);
+                if (diff < 0)
+                    return 0;       // the ring is full
+
+                // some other producer got in between
+                pos = enqueue_pos_.load(boost::memory_order_relaxed);
+                continue;
+            }
+
+            if (enqueue_pos_.compare_exchange_weak(pos, pos + free,
+                    boost::memory_order_relaxed))
+            {
+                // the claimed cells are ours now
+                for (std::size_t i = 0; i != free; ++i)
+                {
+                    cell& c = buffer_[(pos + i) & mask_];
+                    c.data_ = vals[i];
+                    c.sequence_.store(pos + i + 1,
+                        boost::memory_order_release);
+                }
+                return free;
+            }
+        }
+    }
+
+    // Returns false if the ring is empty.
+    bool pop(T& val)
+    {
+        return pop_bulk(&val, 1) != 0;
+    }
+
+    // Pop up to count consecutive elements using a single CAS, returns the
+    // number of elements stored in vals.
+    std::size_t pop_bulk(T* vals, std::size_t count)
+    {
+        HPX_ASSERT(count != 0);
+
+        std::size_t pos = dequeue_pos_.load(boost::memory_order_relaxed);
+        for (;;)
+        {
+            // find out how many elements are ready to be consumed
+            std::size_t ready = 0;
+            while (ready != count && ready != mask_ + 1)
+            {
+                std::size_t expected = pos + ready + 1;
+                std::size_t seq = buffer_[(pos + ready) & mask_].
+                    sequence_.load(boost::memory_order_acquire);
+                if (seq != expected)
+                    break;
+                ++ready;
+            }
+
+            if (ready == 0)
+            {
+                std::size_t seq = buffer_[pos & mask_].
+                    sequence_.load(boost::memory_order_acquire);
+                std::ptrdiff_t diff =
+                    std::ptrdiff_t(seq) - std::ptrdiff_t(pos + 1);
+                if (diff < 0)
+                    return 0;       // the ring is empty
+
+                // some other consumer got in between
+                pos = dequeue_pos_.load(boost::memory_order_relaxed);
+                continue;
+            }
+
+            if (dequeue_pos_.compare_exchange_weak(pos, pos + ready,
+                    boost::memory_order_relaxed))
+            {
+                // the claimed cells are ours now
+                for (std::size_t i = 0; i != ready; ++i)
+                {
+                    cell& c = buffer_[(pos + i) & mask_];
+                    vals[i] = c.data_;
+                    c.sequence_.store(pos + i + mask_ + 1,
+                        boost::memory_order_release);
+                }
+                return ready;
+            }
+        }
+    }
+
+    bool empty() const
+    {
+        return size() == 0;
+    }
+
+    std::size_t size() const
+    {
+        std::size_t e = enqueue_pos_.load(boost::memory_order_relaxed);
+        std::size_t d = dequeue_pos_.load(boost::memory_order_relaxed);
+        return e > d ? e - d : 0;
+    }
+
+private:
+    std::size_t const mask_;
+    cell* const buffer_;
+
+    // the enqueue position is modified by producers, the dequeue position
+    // by consumers, keep them on separate cache lines
+    char padding0_[BOOST_LOCKFREE_CACHELINE_BYTES];
+    boost::atomic<std::size_t> enqueue_pos_;
+    char padding1_[BOOST_LOCKFREE_CACHELINE_BYTES -
+        sizeof(boost::atomic<std::size_t>)];
+    boost::atomic<std::size_t> dequeue_pos_;
+    char padding2_[BOOST_LOCKFREE_CACHELINE_BYTES -
+        sizeof(boost::atomic<std::size_t>)];
+};
+
+}}
+
+#endif
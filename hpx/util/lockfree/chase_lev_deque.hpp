@@ -0,0 +1,217 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Algorithms from "Dynamic Circular Work-Stealing Deque" by D. Chase and
+//  Y. Lev, with the memory orderings taken from "Correct and Efficient
+//  Work-Stealing for Weak Memory Models" by N. M. Le, A. Pop, A. Cohen, and
+//  F. Zappa Nardelli
+//
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+//  Disclaimer: Not a Boost library.
+//
+//  The owner of the deque pushes and pops at the bottom end without any atomic
+//  read-modify-write operation (pop needs a CAS only when racing for the very
+//  last element). All other threads steal from the top end using a single CAS.
+//  The buffer is a circular array which doubles its size whenever it runs full.
+//  Retired buffers are kept alive until the deque is destroyed, as concurrent
+//  thieves might still be reading from them.
+////////////////////////////////////////////////////////////////////////////////
+
+#if !defined(HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_FEB_13_2017_0817PM)
+#define HPX_UTIL_LOCKFREE_CHASE_LEV_DEQUE_FEB_13_2017_0817PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/lockfree/detail/prefix.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace boost { namespace lockfree
+{
+
+template <typename T>
+struct chase_lev_deque
+{
+private:
+    struct circular_array
+    {
+        explicit circular_array(std::int64_t capacity)
+          : mask_(capacity - 1),
+            buffer_(new boost::atomic<T>[std::size_t(capacity)])
+        {
+            HPX_ASSERT((capacity & mask_) == 0);
+        }
+
+        ~circular_array()
+        {
+            delete [] buffer_;
+        }
+
+        std::int64_t capacity() const
+        {
+            return mask_ + 1;
+        }
+
+        T load(std::int64_t i) const
+        {
+            return buffer_[i & mask_].load(boost::memory_order_relaxed);
+        }
+
+        void store(std::int64_t i, T const& val)
+        {
+            buffer_[i & mask_].store(val, boost::memory_order_relaxed);
+        }
+
+        // copy the live elements [top, bottom) into a buffer of twice the
+        // size of this one
+        circular_array* grow(std::int64_t top, std::int64_t bottom) const
+        {
+            circular_array* a = new circular_array(2 * capacity());
+            for (std::int64_t i = top; i != bottom; ++i)
+                a->store(i, load(i));
+            return a;
+        }
+
+        std::int64_t const mask_;
+        boost::atomic<T>* const buffer_;
+    };
+
+    // round the requested capacity up to the next power of two
+    static std::int64_t normalize_capacity(std::size_t initial_size)
+    {
+        std::int64_t result = 32;
+        while (result < std::int64_t(initial_size))
+            result <<= 1;
+        return result;
+    }
+
+public:
+    typedef T value_type;
+
+    explicit chase_lev_deque(std::size_t initial_size = 0)
+      : top_(0), bottom_(0),
+        array_(new circular_array(normalize_capacity(initial_size)))
+    {}
+
+    ~chase_lev_deque()
+    {
+        delete array_.load(boost::memory_order_relaxed);
+        for (circular_array* a : retired_)
+            delete a;
+    }
+
+    chase_lev_deque(chase_lev_deque const&) = delete;
+    chase_lev_deque& operator=(chase_lev_deque const&) = delete;
+
+    // May only be called by the owner of the deque.
+    bool push_bottom(T const& val)
+    {
+        std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        std::int64_t t = top_.load(boost::memory_order_acquire);
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+
+        if (b - t > a->capacity() - 1)
+        {
+            // the buffer is full, replace it by a larger one
+            circular_array* new_a = a->grow(t, b);
+            retired_.push_back(a);
+            array_.store(new_a, boost::memory_order_release);
+            a = new_a;
+        }
+
+        a->store(b, val);
+        boost::atomic_thread_fence(boost::memory_order_release);
+        bottom_.store(b + 1, boost::memory_order_relaxed);
+        return true;
+    }
+
+    // May only be called by the owner of the deque.
+    bool pop_bottom(T& val)
+    {
+        std::int64_t b = bottom_.load(boost::memory_order_relaxed) - 1;
+        circular_array* a = array_.load(boost::memory_order_relaxed);
+        bottom_.store(b, boost::memory_order_relaxed);
+        boost::atomic_thread_fence(boost::memory_order_seq_cst);
+        std::int64_t t = top_.load(boost::memory_order_relaxed);
+
+        if (t > b)
+        {
+            // the deque was empty
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return false;
+        }
+
+        val = a->load(b);
+        if (t == b)
+        {
+            // this is the last element, race against thieves for it
+            bool result = top_.compare_exchange_strong(t, t + 1,
+                boost::memory_order_seq_cst, boost::memory_order_relaxed);
+            bottom_.store(b + 1, boost::memory_order_relaxed);
+            return result;
+        }
+        return true;
+    }
+
+    // May be called by any thread.
+    bool steal_top(T& val)
+    {
+        for (;;)
+        {
+            std::int64_t t = top_.load(boost::memory_order_acquire);
+            boost::atomic_thread_fence(boost::memory_order_seq_cst);
+            std::int64_t b = bottom_.load(boost::memory_order_acquire);
+
+            if (t >= b)
+                return false;
+
+            circular_array* a = array_.load(boost::memory_order_acquire);
+            T v = a->load(t);
+            if (top_.compare_exchange_strong(t, t + 1,
+                    boost::memory_order_seq_cst, boost::memory_order_relaxed))
+            {
+                val = v;
+                return true;
+            }
+
+            // lost the race against another thief or the owner, try again
+        }
+    }
+
+    bool empty() const
+    {
+        std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        std::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b <= t;
+    }
+
+    std::int64_t size() const
+    {
+        std::int64_t b = bottom_.load(boost::memory_order_relaxed);
+        std::int64_t t = top_.load(boost::memory_order_relaxed);
+        return b > t ? b - t : 0;
+    }
+
+private:
+    // top_ is modified by thieves, bottom_ by the owner only, keep them on
+    // separate cache lines
+    boost::atomic<std::int64_t> top_;
+    char padding0_[BOOST_LOCKFREE_CACHELINE_BYTES -
+        sizeof(boost::atomic<std::int64_t>)];
+
+    boost::atomic<std::int64_t> bottom_;
+    boost::atomic<circular_array*> array_;
+
+    // buffers replaced by a larger one, touched by the owner only
+    std::vector<circular_array*> retired_;
+};
+
+}}
+
+#endif
@@ -1005,16 +1005,62 @@ namespace hpx { namespace util
 #endif
 }}
 
+namespace hpx { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename ...Ts>
+    struct sum_of_sizes
+      : std::integral_constant<std::size_t, 0>
+    {};
+
+    template <typename T, typename ...Ts>
+    struct sum_of_sizes<T, Ts...>
+      : std::integral_constant<std::size_t,
+            sizeof(T) + sum_of_sizes<Ts...>::value
+        >
+    {};
+
+    // A tuple is copied as a whole only if all of its members can be copied
+    // bitwise and if it does not hold anything but its members (no padding
+    // bytes may end up in the archive). The tuple itself is not trivially
+    // copyable as it provides its own assignment operators, however those
+    // are member-wise, which makes the tuple's object representation the one
+    // of its members.
+    template <typename Tuple, typename ...Ts>
+    struct is_bitwise_serializable_tuple
+      : std::integral_constant<bool,
+            all_of<
+                hpx::traits::is_bitwise_serializable<
+                    typename std::remove_const<Ts>::type
+                >...
+            >::value &&
+#if defined(HPX_HAVE_CXX11_STD_IS_TRIVIALLY_COPYABLE)
+            all_of<std::is_trivially_copyable<Ts>...>::value &&
+#endif
+            sizeof(Tuple) == sum_of_sizes<Ts...>::value
+        >
+    {};
+}}}
+
 namespace hpx { namespace traits
 {
     ///////////////////////////////////////////////////////////////////////////
     template <typename Is, typename ...Ts>
     struct is_bitwise_serializable<
         ::hpx::util::detail::tuple_impl<Is, Ts...>
-    > : ::hpx::util::detail::all_of<
-            hpx::traits::is_bitwise_serializable<
-                typename std::remove_const<Ts>::type
-            >...
+    > : ::hpx::util::detail::is_bitwise_serializable_tuple<
+            ::hpx::util::detail::tuple_impl<Is, Ts...>, Ts...
+        >
+    {};
+
+    // A tuple of bitwise serializable types (as used for the arguments of
+    // actions) is saved with a single copy instead of element by element.
+    // The empty tuple does not write anything at all.
+    template <typename ...Ts>
+    struct is_bitwise_serializable<
+        ::hpx::util::tuple<Ts...>
+    > : ::hpx::util::detail::is_bitwise_serializable_tuple<
+            ::hpx::util::tuple<Ts...>, Ts...
         >
     {};
 }}
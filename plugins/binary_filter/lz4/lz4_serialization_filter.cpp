@@ -0,0 +1,416 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/plugins/plugin_registry.hpp>
+#include <hpx/plugins/binary_filter_factory.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+#include <hpx/runtime/components/component_startup_shutdown.hpp>
+#include <hpx/runtime/serialization/container.hpp>
+#include <hpx/runtime/startup_function.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <lz4.h>
+
+///////////////////////////////////////////////////////////////////////////////
+HPX_REGISTER_PLUGIN_MODULE_DYNAMIC();
+HPX_REGISTER_BINARY_FILTER_FACTORY(
+    hpx::plugins::compression::lz4_serialization_filter,
+    lz4_serialization_filter);
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace plugins { namespace compression
+{
+    namespace
+    {
+        // size of the blocks the data is compressed in
+        const std::size_t block_size = 64 * 1024;
+
+        // messages smaller than this are sent uncompressed
+        const std::size_t compression_threshold = 1024;
+
+        // blocks which do not shrink to 7/8 of their size are stored as they
+        // are, after this many of those the rest of the message is stored
+        const std::size_t max_poor_blocks = 2;
+
+        // each block starts with its uncompressed and its stored size, the
+        // highest bit of the stored size is set for uncompressed blocks
+        const std::size_t header_size = 2 * sizeof(std::uint32_t);
+        const std::uint32_t stored_flag = 0x80000000;
+
+        void write_uint32(char* dst, std::uint32_t value)
+        {
+            for (std::size_t i = 0; i != sizeof(std::uint32_t); ++i)
+            {
+                dst[i] = static_cast<char>(value & 0xff);
+                value >>= 8;
+            }
+        }
+
+        std::uint32_t read_uint32(char const* src)
+        {
+            std::uint32_t value = 0;
+            for (std::size_t i = sizeof(std::uint32_t); i != 0; --i)
+            {
+                value <<= 8;
+                value |= static_cast<unsigned char>(src[i - 1]);
+            }
+            return value;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // statistics collected by all instances of this filter
+        boost::atomic<std::int64_t> ratio_uncompressed_bytes(0);
+        boost::atomic<std::int64_t> ratio_compressed_bytes(0);
+        boost::atomic<std::int64_t> throughput_uncompressed_bytes(0);
+        boost::atomic<std::int64_t> throughput_time(0);
+        boost::atomic<std::int64_t> stored_blocks(0);
+
+        // size of the compressed data relative to the uncompressed data
+        std::int64_t get_compression_ratio(bool reset)
+        {
+            std::int64_t uncompressed =
+                util::get_and_reset_value(ratio_uncompressed_bytes, reset);
+            std::int64_t compressed =
+                util::get_and_reset_value(ratio_compressed_bytes, reset);
+            return uncompressed ? (compressed * 1000) / uncompressed : 0;
+        }
+
+        // uncompressed bytes per microsecond, i.e. MB/s
+        std::int64_t get_compression_throughput(bool reset)
+        {
+            std::int64_t bytes =
+                util::get_and_reset_value(throughput_uncompressed_bytes, reset);
+            std::int64_t time =
+                util::get_and_reset_value(throughput_time, reset);
+            return time ? (bytes * 1000) / time : 0;
+        }
+
+        std::int64_t get_stored_blocks(bool reset)
+        {
+            return util::get_and_reset_value(stored_blocks, reset);
+        }
+    }
+
+    void lz4_serialization_filter::set_max_length(std::size_t size)
+    {
+        buffer_.reserve((std::min)(size, block_size));
+        compressed_.reserve(header_size + LZ4_compressBound(
+            static_cast<int>((std::min)(size, block_size))));
+    }
+
+    void lz4_serialization_filter::set_output(
+        serialization::erased_output_container* output)
+    {
+        output_ = output;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::size_t lz4_serialization_filter::init_data(
+        char const* buffer, std::size_t size, std::size_t buffer_size)
+    {
+        buffer_.resize(buffer_size);
+
+        // the given buffer_size is an upper bound only, as it includes the
+        // data saved by the archive before the filter was attached
+        std::size_t pos = 0;
+        std::size_t decompressed = 0;
+        while (pos != size)
+        {
+            if (pos + header_size > size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "lz4_serialization_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            std::uint32_t raw_size = read_uint32(buffer + pos);
+            std::uint32_t stored_size =
+                read_uint32(buffer + pos + sizeof(std::uint32_t));
+            pos += header_size;
+
+            bool stored = (stored_size & stored_flag) != 0;
+            stored_size &= ~stored_flag;
+
+            if (pos + stored_size > size ||
+                decompressed + raw_size > buffer_size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "lz4_serialization_filter::init_data",
+                    "archive data bstream is too short");
+                return 0;
+            }
+
+            if (stored && stored_size != raw_size)
+            {
+                HPX_THROW_EXCEPTION(serialization_error,
+                    "lz4_serialization_filter::init_data",
+                    boost::str(boost::format("inconsistent size of stored "
+                        "block, uncompressed size: %d, stored size: %d") %
+                        raw_size % stored_size));
+                return 0;
+            }
+
+            if (stored)
+            {
+                std::memcpy(&buffer_[decompressed], buffer + pos, raw_size);
+            }
+            else
+            {
+                int s = LZ4_decompress_safe(buffer + pos,
+                    &buffer_[decompressed], static_cast<int>(stored_size),
+                    static_cast<int>(raw_size));
+                if (s < 0 || std::uint32_t(s) != raw_size)
+                {
+                    HPX_THROW_EXCEPTION(serialization_error,
+                        "lz4_serialization_filter::init_data",
+                        boost::str(boost::format("decompression failure, "
+                            "number of bytes expected: %d, number of bytes "
+                            "decoded: %d") % raw_size % s));
+                    return 0;
+                }
+            }
+
+            pos += stored_size;
+            decompressed += raw_size;
+        }
+
+        buffer_.resize(decompressed);
+        current_ = 0;
+        return buffer_.size();
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::load(void* dst, std::size_t dst_count)
+    {
+        if (current_+dst_count > buffer_.size())
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                    "lz4_serialization_filter::load",
+                    "archive data bstream is too short");
+            return;
+        }
+
+        std::memcpy(dst, &buffer_[current_], dst_count);
+        current_ += dst_count;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    void lz4_serialization_filter::save(void const* src,
+        std::size_t src_count)
+    {
+        // compress every block as soon as it is complete
+        char const* src_begin = static_cast<char const*>(src);
+        while (src_count != 0)
+        {
+            // complete blocks are compressed directly from the source
+            if (buffer_.empty() && src_count >= block_size)
+            {
+                uncompressed_size_ += block_size;
+                compress_block(src_begin, block_size, true, true);
+
+                src_begin += block_size;
+                src_count -= block_size;
+                continue;
+            }
+
+            std::size_t count =
+                (std::min)(src_count, block_size - buffer_.size());
+            buffer_.insert(buffer_.end(), src_begin, src_begin + count);
+
+            src_begin += count;
+            src_count -= count;
+            uncompressed_size_ += count;
+
+            if (buffer_.size() == block_size)
+            {
+                compress_block(buffer_.data(), buffer_.size(), true, true);
+                buffer_.clear();
+            }
+        }
+    }
+
+    // Compress the given block. If requested, the block is written to the
+    // output container right away, otherwise it is appended to compressed_
+    // to be returned from flush().
+    void lz4_serialization_filter::compress_block(char const* src,
+        std::size_t raw_size, bool try_compression, bool stream)
+    {
+        std::int64_t start = static_cast<std::int64_t>(
+            util::high_resolution_clock::now());
+
+        bool const write_out = stream && output_ != nullptr;
+
+        std::size_t const offset = write_out ? 0 : compressed_.size();
+        compressed_.resize(
+            offset + header_size + LZ4_compressBound(static_cast<int>(raw_size)));
+
+        char* dst = &compressed_[offset + header_size];
+        int stored_size = 0;
+        if (try_compression && poor_blocks_ < max_poor_blocks)
+        {
+            stored_size = LZ4_compress_default(src, dst,
+                static_cast<int>(raw_size),
+                static_cast<int>(compressed_.size() - offset - header_size));
+        }
+
+        bool stored = false;
+        if (stored_size <= 0 || std::size_t(stored_size) * 8 > raw_size * 7)
+        {
+            // not worth it, store this block as it is
+            if (try_compression)
+                ++poor_blocks_;
+
+            stored_size = static_cast<int>(raw_size);
+            stored = true;
+            ++stored_blocks;
+        }
+        else
+        {
+            poor_blocks_ = 0;
+        }
+
+        write_uint32(&compressed_[offset], static_cast<std::uint32_t>(raw_size));
+        write_uint32(&compressed_[offset + sizeof(std::uint32_t)],
+            static_cast<std::uint32_t>(stored_size) | (stored ? stored_flag : 0));
+
+        if (write_out)
+        {
+            // stored blocks are written directly from the source
+            if (stored)
+            {
+                output_->save_filtered_binary(compressed_.data(), header_size);
+                output_->save_filtered_binary(src, raw_size);
+            }
+            else
+            {
+                output_->save_filtered_binary(
+                    compressed_.data(), header_size + stored_size);
+            }
+            compressed_.clear();
+        }
+        else
+        {
+            if (stored)
+                std::memcpy(dst, src, raw_size);
+            compressed_.resize(offset + header_size + stored_size);
+        }
+
+        compressed_size_ += header_size + stored_size;
+        compression_time_ += static_cast<std::int64_t>(
+            util::high_resolution_clock::now()) - start;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool lz4_serialization_filter::flush(void* dst, std::size_t dst_count,
+        std::size_t& written)
+    {
+        // this may be called again if the destination buffer was too small
+        if (!flushed_)
+        {
+            // the last (partial) block is returned from here as the output
+            // container must not be modified while being flushed
+            if (!buffer_.empty())
+            {
+                compress_block(buffer_.data(), buffer_.size(),
+                    uncompressed_size_ >= compression_threshold, false);
+                buffer_.clear();
+            }
+            flushed_ = true;
+
+            ratio_uncompressed_bytes += uncompressed_size_;
+            ratio_compressed_bytes += compressed_size_;
+            throughput_uncompressed_bytes += uncompressed_size_;
+            throughput_time += compression_time_;
+        }
+
+        if (compressed_.size() > dst_count)
+        {
+            written = 0;
+            return false;
+        }
+
+        if (!compressed_.empty())
+            std::memcpy(dst, compressed_.data(), compressed_.size());
+
+        written = compressed_.size();
+        return true;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // This function will be registered as a startup function for HPX below.
+    void startup()
+    {
+        using namespace hpx::performance_counters;
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        generic_counter_type_data const counter_types[] =
+        {
+            { "/compression/lz4/ratio", counter_raw,
+              "returns the overall size of the data compressed by the lz4 "
+              "binary filter relative to its uncompressed size",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&locality_raw_counter_creator, _1,
+                  &get_compression_ratio, _2),
+              &locality_counter_discoverer,
+              "0.1%"
+            },
+            { "/compression/lz4/throughput", counter_raw,
+              "returns the number of bytes compressed by the lz4 binary "
+              "filter per unit of time spent compressing",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&locality_raw_counter_creator, _1,
+                  &get_compression_throughput, _2),
+              &locality_counter_discoverer,
+              "MB/s"
+            },
+            { "/compression/lz4/count/stored-blocks", counter_raw,
+              "returns the number of blocks the lz4 binary filter has sent "
+              "uncompressed, as they were too small or did not compress well",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&locality_raw_counter_creator, _1,
+                  &get_stored_blocks, _2),
+              &locality_counter_discoverer,
+              ""
+            }
+        };
+
+        install_counter_types(counter_types,
+            sizeof(counter_types)/sizeof(counter_types[0]));
+    }
+
+    bool get_startup(hpx::startup_function_type& startup_func,
+        bool& pre_startup)
+    {
+        startup_func = startup;   // function to run during startup
+        pre_startup = true;       // run 'startup' as pre-startup function
+        return true;
+    }
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+// Register a startup function which will be called as a HPX-thread during
+// runtime startup. We use this function to register our performance counter
+// types.
+HPX_REGISTER_STARTUP_MODULE_DYNAMIC(hpx::plugins::compression::get_startup);
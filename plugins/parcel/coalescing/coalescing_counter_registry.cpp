@@ -9,10 +9,12 @@
 #include <hpx/performance_counters/registry.hpp>
 
 #include <hpx/plugins/parcel/coalescing_counter_registry.hpp>
+#include <hpx/util/bind.hpp>
 
 #include <boost/format.hpp>
 #include <boost/regex.hpp>
 
+#include <cstddef>
 #include <cstdint>
 #include <mutex>
 #include <string>
@@ -34,7 +36,9 @@ namespace hpx { namespace plugins { namespace parcel
         get_counter_type num_parcels, get_counter_type num_messages,
         get_counter_type num_parcels_per_message,
         get_counter_type average_time_between_parcels,
-        get_counter_values_creator_type time_between_parcels_histogram_creator)
+        get_counter_values_creator_type time_between_parcels_histogram_creator,
+        get_counter_type max_parcels_per_message,
+        get_counter_type flush_interval)
     {
         if (name.empty())
         {
@@ -43,40 +47,32 @@ namespace hpx { namespace plugins { namespace parcel
                 "Cannot register an action with an empty name");
         }
 
-        std::lock_guard<mutex_type> l(mtx_);
-
-        auto it = map_.find(name);
-        if (it == map_.end())
+        counter_functions data =
         {
-            counter_functions data =
-            {
-                num_parcels, num_messages,
-                num_parcels_per_message, average_time_between_parcels,
-                time_between_parcels_histogram_creator,
-                0, 0, 1
-            };
+            num_parcels, num_messages,
+            num_parcels_per_message, average_time_between_parcels,
+            time_between_parcels_histogram_creator,
+            max_parcels_per_message, flush_interval
+        };
 
-            map_.emplace(name, std::move(data));
-        }
-        else
+        std::unique_lock<mutex_type> l(mtx_);
+
+        // add the functions of this message handler to the ones of all other
+        // destinations of the same action
+        action_counters& counters = map_[name];
+        counters.handlers.push_back(std::move(data));
+
+        if (counters.min_boundary != counters.max_boundary)
         {
-            // replace the existing functions
-            (*it).second.num_parcels = num_parcels;
-            (*it).second.num_messages = num_messages;
-            (*it).second.num_parcels_per_message = num_parcels_per_message;
-            (*it).second.average_time_between_parcels =
-                average_time_between_parcels;
-            (*it).second.time_between_parcels_histogram_creator =
-                time_between_parcels_histogram_creator;
-
-            if ((*it).second.min_boundary != (*it).second.max_boundary)
-            {
-                // instantiate actual histogram collection
-                coalescing_counter_registry::get_counter_values_type result;
-                time_between_parcels_histogram_creator(
-                    (*it).second.min_boundary, (*it).second.max_boundary,
-                    (*it).second.num_buckets, result);
-            }
+            std::int64_t min_boundary = counters.min_boundary;
+            std::int64_t max_boundary = counters.max_boundary;
+            std::int64_t num_buckets = counters.num_buckets;
+            l.unlock();
+
+            // instantiate actual histogram collection
+            coalescing_counter_registry::get_counter_values_type result;
+            time_between_parcels_histogram_creator(
+                min_boundary, max_boundary, num_buckets, result);
         }
     }
 
@@ -94,32 +90,46 @@ namespace hpx { namespace plugins { namespace parcel
         auto it = map_.find(name);
         if (it == map_.end())
         {
-            map_.emplace(name, counter_functions());
+            map_.emplace(name, action_counters());
         }
     }
 
     ///////////////////////////////////////////////////////////////////////////
-    coalescing_counter_registry::get_counter_type
-        coalescing_counter_registry::get_parcels_counter(
-            std::string const& name) const
+    std::vector<coalescing_counter_registry::counter_functions>
+        coalescing_counter_registry::get_handlers(std::string const& name) const
     {
-        std::unique_lock<mutex_type> l(mtx_);
+        std::lock_guard<mutex_type> l(mtx_);
 
         map_type::const_iterator it = map_.find(name);
         if (it == map_.end())
+            return std::vector<counter_functions>();
+
+        return (*it).second.handlers;
+    }
+
+    // The counter functions of the message handlers are invoked without
+    // holding the lock, as they acquire the lock of their handler.
+    std::int64_t coalescing_counter_registry::get_combined_value(
+        std::string const& name, counter_member counter, bool sum,
+        bool reset) const
+    {
+        std::int64_t value = 0;
+        std::int64_t count = 0;
+        for (counter_functions const& handler : get_handlers(name))
         {
-            l.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_parcels_counter",
-                "unknown action type");
-            return get_counter_type();
+            std::int64_t v = (handler.*counter)(reset);
+            if (v != 0)
+            {
+                value += v;
+                ++count;
+            }
         }
-        return (*it).second.num_parcels;
+        return (sum || count == 0) ? value : value / count;
     }
 
     coalescing_counter_registry::get_counter_type
-        coalescing_counter_registry::get_messages_counter(
-            std::string const& name) const
+        coalescing_counter_registry::get_counter(std::string const& name,
+            counter_member counter, bool sum, char const* func) const
     {
         std::unique_lock<mutex_type> l(mtx_);
 
@@ -127,49 +137,113 @@ namespace hpx { namespace plugins { namespace parcel
         if (it == map_.end())
         {
             l.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_messages_counter",
-                "unknown action type");
+            HPX_THROW_EXCEPTION(bad_parameter, func, "unknown action type");
             return get_counter_type();
         }
-        return (*it).second.num_messages;
+
+        // no parcel of this type has been sent yet
+        if ((*it).second.handlers.empty())
+            return get_counter_type();
+
+        using util::placeholders::_1;
+        return util::bind(&coalescing_counter_registry::get_combined_value,
+            this, name, counter, sum, _1);
     }
 
     coalescing_counter_registry::get_counter_type
-        coalescing_counter_registry::get_parcels_per_message_counter(
+        coalescing_counter_registry::get_parcels_counter(
             std::string const& name) const
     {
-        std::unique_lock<mutex_type> l(mtx_);
+        return get_counter(name, &counter_functions::num_parcels, true,
+            "coalescing_counter_registry::get_num_parcels_counter");
+    }
 
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
-        {
-            l.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::get_num_messages_counter",
-                "unknown action type");
-            return get_counter_type();
-        }
-        return (*it).second.num_parcels_per_message;
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_messages_counter(
+            std::string const& name) const
+    {
+        return get_counter(name, &counter_functions::num_messages, true,
+            "coalescing_counter_registry::get_num_messages_counter");
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_parcels_per_message_counter(
+            std::string const& name) const
+    {
+        return get_counter(name, &counter_functions::num_parcels_per_message,
+            false, "coalescing_counter_registry::get_num_messages_counter");
     }
 
     coalescing_counter_registry::get_counter_type
         coalescing_counter_registry::get_average_time_between_parcels_counter(
             std::string const& name) const
     {
-        std::unique_lock<mutex_type> l(mtx_);
+        return get_counter(name,
+            &counter_functions::average_time_between_parcels, false,
+            "coalescing_counter_registry::"
+                "get_average_time_between_parcels_counter");
+    }
 
-        map_type::const_iterator it = map_.find(name);
-        if (it == map_.end())
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_max_parcels_per_message_counter(
+            std::string const& name) const
+    {
+        return get_counter(name, &counter_functions::max_parcels_per_message,
+            false, "coalescing_counter_registry::"
+                "get_max_parcels_per_message_counter");
+    }
+
+    coalescing_counter_registry::get_counter_type
+        coalescing_counter_registry::get_flush_interval_counter(
+            std::string const& name) const
+    {
+        return get_counter(name, &counter_functions::flush_interval, false,
+            "coalescing_counter_registry::get_flush_interval_counter");
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The histograms of all handlers of the action are averaged bucket by
+    // bucket, the first three values are the histogram parameters.
+    std::vector<std::int64_t>
+        coalescing_counter_registry::get_time_between_parcels_histogram(
+            std::string const& name, std::int64_t min_boundary,
+            std::int64_t max_boundary, std::int64_t num_buckets,
+            bool reset) const
+    {
+        std::vector<std::int64_t> result;
+        std::int64_t count = 0;
+        for (counter_functions const& handler : get_handlers(name))
         {
-            l.unlock();
-            HPX_THROW_EXCEPTION(bad_parameter,
-                "coalescing_counter_registry::"
-                    "get_average_time_between_parcels_counter",
-                "unknown action type");
-            return get_counter_type();
+            get_counter_values_type f;
+            handler.time_between_parcels_histogram_creator(
+                min_boundary, max_boundary, num_buckets, f);
+            if (f.empty())
+                continue;
+
+            std::vector<std::int64_t> values = f(reset);
+            if (result.empty())
+            {
+                result = std::move(values);
+            }
+            else if (values.size() == result.size())
+            {
+                for (std::size_t i = 3; i < result.size(); ++i)
+                    result[i] += values[i];
+            }
+            else
+            {
+                continue;
+            }
+            ++count;
         }
-        return (*it).second.average_time_between_parcels;
+
+        if (result.empty())
+            return empty_histogram(reset);
+
+        for (std::size_t i = 3; i < result.size(); ++i)
+            result[i] /= count;
+
+        return result;
     }
 
     coalescing_counter_registry::get_counter_values_type
@@ -190,19 +264,21 @@ namespace hpx { namespace plugins { namespace parcel
             return &coalescing_counter_registry::empty_histogram;
         }
 
-        if ((*it).second.time_between_parcels_histogram_creator.empty())
+        // handlers registered later collect the histogram right away
+        (*it).second.min_boundary = min_boundary;
+        (*it).second.max_boundary = max_boundary;
+        (*it).second.num_buckets = num_buckets;
+
+        if ((*it).second.handlers.empty())
         {
             // no parcel of this type has been sent yet
-            (*it).second.min_boundary = min_boundary;
-            (*it).second.max_boundary = max_boundary;
-            (*it).second.num_buckets = num_buckets;
             return coalescing_counter_registry::get_counter_values_type();
         }
 
-        coalescing_counter_registry::get_counter_values_type result;
-        (*it).second.time_between_parcels_histogram_creator(
-            min_boundary, max_boundary, num_buckets, result);
-        return result;
+        using util::placeholders::_1;
+        return util::bind(
+            &coalescing_counter_registry::get_time_between_parcels_histogram,
+            this, name, min_boundary, max_boundary, num_buckets, _1);
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -22,6 +22,7 @@
 #include <boost/lexical_cast.hpp>
 #include <boost/accumulators/accumulators.hpp>
 
+#include <algorithm>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
@@ -40,6 +41,8 @@ namespace hpx { namespace traits
     //      ...
     //      num_messages = 50
     //      interval = 100
+    //      adaptive = 0
+    //      ...
     //
     template <>
     struct plugin_config_data<hpx::plugins::parcel::coalescing_message_handler>
@@ -48,7 +51,12 @@ namespace hpx { namespace traits
         {
             return "num_messages = 50\n"
                    "interval = 100\n"
-                   "allow_background_flush = 1";
+                   "allow_background_flush = 1\n"
+                   "adaptive = 0\n"
+                   "min_num_messages = 1\n"
+                   "max_num_messages = 256\n"
+                   "min_interval = 10\n"
+                   "max_interval = 100";
         }
     };
 }}
@@ -84,6 +92,20 @@ namespace hpx { namespace plugins { namespace parcel
                 "1");
             return !value.empty() && value[0] != '0';
         }
+
+        bool get_adaptive()
+        {
+            std::string value = hpx::get_config_entry(
+                "hpx.plugins.coalescing_message_handler.adaptive", "0");
+            return !value.empty() && value[0] != '0';
+        }
+
+        std::size_t get_bound(char const* name, std::size_t dflt)
+        {
+            return boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                std::string("hpx.plugins.coalescing_message_handler.") + name,
+                dflt));
+        }
     }
 
     void coalescing_message_handler::update_num_messages()
@@ -113,6 +135,16 @@ namespace hpx { namespace plugins { namespace parcel
         stopped_(false),
         allow_background_flush_(detail::get_background_flush()),
         action_name_(action_name),
+        adaptive_(detail::get_adaptive()),
+        min_num_coalesced_parcels_(
+            (std::max)(detail::get_bound("min_num_messages", 1), std::size_t(1))),
+        max_num_coalesced_parcels_((std::max)(
+            detail::get_bound("max_num_messages", 256),
+            min_num_coalesced_parcels_)),
+        min_interval_(detail::get_bound("min_interval", 10)),
+        max_interval_((std::max)(
+            detail::get_bound("max_interval", 100), min_interval_)),
+        estimated_time_between_parcels_(0),
         num_parcels_(0), reset_num_parcels_(0),
             reset_num_parcels_per_message_parcels_(0),
         num_messages_(0), reset_num_messages_(0),
@@ -137,7 +169,10 @@ namespace hpx { namespace plugins { namespace parcel
             util::bind(&coalescing_message_handler::
                 get_average_time_between_parcels, this, _1),
             util::bind(&coalescing_message_handler::
-                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4));
+                get_time_between_parcels_histogram_creator, this, _1, _2, _3, _4),
+            util::bind(&coalescing_message_handler::
+                get_max_parcels_per_message, this, _1),
+            util::bind(&coalescing_message_handler::get_flush_interval, this, _1));
 
         // register parameter update callbacks
         set_config_entry_callback(
@@ -164,13 +199,18 @@ namespace hpx { namespace plugins { namespace parcel
         if (time_between_parcels_)
             (*time_between_parcels_)(time_since_last_parcel);
 
+        if (adaptive_)
+            adapt_locked(time_since_last_parcel);
+
         std::chrono::microseconds interval(interval_);
 
         // just send parcel if the coalescing was stopped or the buffer is
-        // empty and time since last parcel is larger than coalescing interval.
+        // empty and time since last parcel is larger than coalescing interval
+        // (or there is nothing to coalesce).
         if (stopped_ ||
             (buffer_.empty() &&
-                std::chrono::nanoseconds(time_since_last_parcel) > interval
+                (std::chrono::nanoseconds(time_since_last_parcel) > interval ||
+                    num_coalesced_parcels_ == 1)
            ))
         {
             ++num_messages_;
@@ -184,6 +224,11 @@ namespace hpx { namespace plugins { namespace parcel
         detail::message_buffer::message_buffer_append_state s =
             buffer_.append(dest, std::move(p), std::move(f));
 
+        // the number of parcels to coalesce might have been lowered since
+        // the buffer was created
+        if (adaptive_ && buffer_.size() >= num_coalesced_parcels_)
+            s = detail::message_buffer::buffer_now_full;
+
         switch(s) {
         case detail::message_buffer::first_message:
             // start deadline timer to flush buffer
@@ -215,6 +260,48 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    // Derive the number of parcels to coalesce and the flush interval from an
+    // estimate of the time between parcels. Sparse traffic ends up with
+    // messages holding a single parcel (i.e. it is sent right away), while
+    // bursts are coalesced into messages which fill up within the maximal
+    // interval.
+    void coalescing_message_handler::adapt_locked(
+        std::int64_t time_since_last_parcel)
+    {
+        // all times are in nanoseconds, the configured intervals are given
+        // in microseconds
+        std::int64_t const max_delay = std::int64_t(max_interval_) * 1000;
+
+        // any time larger than the maximal delay means the same to us, limit
+        // the sample to allow for a quick recovery after idle periods
+        std::int64_t sample =
+            (std::min)(time_since_last_parcel, 2 * max_delay + 1);
+
+        // exponentially weighted moving average, the new sample has a
+        // weight of 1/8
+        if (estimated_time_between_parcels_ == 0)
+            estimated_time_between_parcels_ = sample;
+        else
+            estimated_time_between_parcels_ +=
+                (sample - estimated_time_between_parcels_) / 8;
+
+        std::int64_t gap =
+            (std::max)(estimated_time_between_parcels_, std::int64_t(1));
+
+        // coalesce as many parcels as are expected to arrive within the
+        // maximal delay
+        std::size_t num = std::size_t(max_delay / gap);
+        num_coalesced_parcels_ = (std::min)(
+            (std::max)(num, min_num_coalesced_parcels_),
+            max_num_coalesced_parcels_);
+
+        // flush once the buffer is expected to be full
+        std::size_t interval =
+            std::size_t((gap * std::int64_t(num_coalesced_parcels_)) / 1000);
+        interval_ = (std::min)((std::max)(interval, min_interval_),
+            max_interval_);
+    }
+
     bool coalescing_message_handler::timer_flush()
     {
         // adjust timer if needed
@@ -428,6 +515,19 @@ namespace hpx { namespace plugins { namespace parcel
             get_time_between_parcels_histogram, this, util::placeholders::_1);
     }
 
+    std::int64_t
+    coalescing_message_handler::get_max_parcels_per_message(bool reset)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return std::int64_t(num_coalesced_parcels_);
+    }
+
+    std::int64_t coalescing_message_handler::get_flush_interval(bool reset)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        return std::int64_t(interval_) * 1000;      // in nanoseconds
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // register the given action (called during startup)
     void coalescing_message_handler::register_action(char const* action,
@@ -371,6 +371,162 @@ namespace hpx { namespace plugins { namespace parcel
         }
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    struct max_parcels_per_message_counter_surrogate
+    {
+        max_parcels_per_message_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        std::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_max_parcels_per_message_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<std::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type max_parcels_per_message_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "max_parcels_per_message_counter_creator",
+                        "invalid counter name for parcels per message limit "
+                        "(instance name must not be a valid base counter "
+                        "name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "max_parcels_per_message_counter_creator",
+                        "invalid counter parameter for parcels per message "
+                        "limit: must specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_max_parcels_per_message_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(
+                    info, max_parcels_per_message_counter_surrogate(
+                        paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "max_parcels_per_message_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct flush_interval_counter_surrogate
+    {
+        flush_interval_counter_surrogate(std::string const& parameters)
+          : parameters_(parameters)
+        {}
+
+        std::int64_t operator()(bool reset)
+        {
+            if (counter_.empty())
+            {
+                counter_ = coalescing_counter_registry::instance().
+                    get_flush_interval_counter(parameters_);
+                if (counter_.empty())
+                    return 0;           // no counter available yet
+            }
+
+            // dispatch to actual counter
+            return counter_(reset);
+        }
+
+        hpx::util::function_nonser<std::int64_t(bool)> counter_;
+        std::string parameters_;
+    };
+
+    hpx::naming::gid_type flush_interval_counter_creator(
+        hpx::performance_counters::counter_info const& info, hpx::error_code& ec)
+    {
+        switch (info.type_) {
+        case performance_counters::counter_raw:
+            {
+                performance_counters::counter_path_elements paths;
+                performance_counters::get_counter_path_elements(
+                    info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_interval_counter_creator",
+                        "invalid counter name for flush interval (instance "
+                        "name must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "flush_interval_counter_creator",
+                        "invalid counter parameter for flush interval: must "
+                        "specify an action type");
+                    return naming::invalid_gid;
+                }
+
+                // ask registry
+                hpx::util::function_nonser<std::int64_t(bool)> f =
+                    coalescing_counter_registry::instance().
+                        get_flush_interval_counter(paths.parameters_);
+
+                if (!f.empty())
+                {
+                    return performance_counters::detail::create_raw_counter(
+                        info, std::move(f), ec);
+                }
+
+                // the counter is not available yet, create surrogate function
+                return performance_counters::detail::create_raw_counter(
+                    info, flush_interval_counter_surrogate(paths.parameters_), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "flush_interval_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     struct time_between_parcels_histogram_counter_surrogate
     {
@@ -550,6 +706,26 @@ namespace hpx { namespace plugins { namespace parcel
               &counter_discoverer,
               "ns"
             },
+            // /coalescing(...)/count/max-parcels-per-message@action-name
+            { "/coalescing/count/max-parcels-per-message", counter_raw,
+              "returns the current maximal number of parcels coalesced into "
+              "one message by the message handler associated with the action "
+              "which is given by the counter parameter",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &max_parcels_per_message_counter_creator,
+              &counter_discoverer,
+              ""
+            },
+            // /coalescing(...)/time/flush-interval@action-name
+            { "/coalescing/time/flush-interval", counter_raw,
+              "returns the current time after which the message handler "
+              "associated with the action which is given by the counter "
+              "parameter flushes its buffered parcels",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &flush_interval_counter_creator,
+              &counter_discoverer,
+              "ns"
+            },
             // /coalescing(...)/time/between-parcels-histogram@action-name,min,max,buckets
             { "/coalescing/time/between-parcels-histogram", counter_histogram,
               "returns the histogram for the times between parcels for "
@@ -0,0 +1,229 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+#include <hpx/traits/plugin_config_data.hpp>
+
+#include <hpx/plugins/parcelport_factory.hpp>
+#include <hpx/util/command_line_handling.hpp>
+
+// parcelport
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcelport_impl.hpp>
+
+#include <hpx/plugins/parcelport/shmem/locality.hpp>
+#include <hpx/plugins/parcelport/shmem/receiver.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/plugins/parcelport/shmem/sender.hpp>
+
+#include <hpx/util/runtime_configuration.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+#include <unistd.h>
+
+#include <hpx/config/warnings_prefix.hpp>
+
+namespace hpx { namespace parcelset
+{
+    namespace policies { namespace shmem
+    {
+        class HPX_EXPORT parcelport;
+    }}
+
+    template <>
+    struct connection_handler_traits<policies::shmem::parcelport>
+    {
+        typedef policies::shmem::sender_connection connection_type;
+        typedef std::false_type send_early_parcel;
+        typedef std::true_type  do_background_work;
+        typedef std::false_type send_immediate_parcels;
+        typedef std::false_type send_pending_on_connection;
+
+        static const char * type()
+        {
+            return "shmem";
+        }
+
+        static const char * pool_name()
+        {
+            return "parcel-pool-shmem";
+        }
+
+        static const char * pool_name_postfix()
+        {
+            return "-shmem";
+        }
+    };
+
+    namespace policies { namespace shmem
+    {
+        void add_connection(sender * s, std::shared_ptr<sender_connection> const &ptr)
+        {
+            s->add(ptr);
+        }
+
+        // The shared memory parcelport is used for all destinations living on
+        // the same node as this locality. It can't be used for bootstrapping,
+        // the localities learn about each others' shared memory endpoints
+        // through the bootstrap parcelport.
+        class HPX_EXPORT parcelport
+          : public parcelport_impl<parcelport>
+        {
+            typedef parcelport_impl<parcelport> base_type;
+
+            static parcelset::locality here()
+            {
+                return
+                    parcelset::locality(
+                        locality(
+                            node_name()
+                          , static_cast<std::int32_t>(::getpid())
+                        )
+                    );
+            }
+
+        public:
+            parcelport(util::runtime_configuration const& ini,
+                util::function_nonser<void(std::size_t, char const*)> const& on_start,
+                util::function_nonser<void()> const& on_stop)
+              : base_type(ini, here(), on_start, on_stop)
+              , running_(false)
+              , node_(node_name())
+              , num_channels_(hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.num_channels", "32"))
+              , channel_size_(hpx::util::get_entry_as<std::size_t>(
+                    ini, "hpx.parcel.shmem.channel_size", "1048576"))
+              , sender_(static_cast<std::int32_t>(::getpid()))
+              , receiver_(*this)
+            {}
+
+            /// Start the handling of connections.
+            bool do_run()
+            {
+                // the inbound segment has to exist before any of the other
+                // localities on this node tries to connect
+                receiver_.run(static_cast<std::int32_t>(::getpid()),
+                    num_channels_, channel_size_);
+                running_ = true;
+                return true;
+            }
+
+            /// Stop the handling of connectons.
+            void do_stop()
+            {
+                while(do_background_work(0))
+                {
+                    if(threads::get_self_ptr())
+                        hpx::this_thread::suspend(hpx::threads::pending,
+                            "shmem::parcelport::do_stop");
+                }
+                running_ = false;
+                sender_.clear();
+            }
+
+            /// Return the name of this locality
+            std::string get_locality_name() const
+            {
+                return node_;
+            }
+
+            /// Only destinations on the same node can be reached through
+            /// shared memory.
+            bool can_connect(parcelset::locality const& dest,
+                bool use_alternative_parcelport)
+            {
+                return use_alternative_parcelport &&
+                    dest.get<locality>().node() == node_;
+            }
+
+            std::shared_ptr<sender_connection> create_connection(
+                parcelset::locality const& l, error_code& ec)
+            {
+                return sender_.create_connection(l.get<locality>(), this);
+            }
+
+            parcelset::locality agas_locality(
+                util::runtime_configuration const & ini) const
+            {
+                return parcelset::locality(locality());
+            }
+
+            parcelset::locality create_locality() const
+            {
+                return parcelset::locality(locality());
+            }
+
+            bool background_work(std::size_t num_thread)
+            {
+                if (!running_)
+                    return false;
+
+                bool has_work = false;
+                has_work = sender_.background_work();
+                has_work = receiver_.background_work(num_thread) || has_work;
+                return has_work;
+            }
+
+        private:
+            boost::atomic<bool> running_;
+            std::string node_;
+
+            std::size_t num_channels_;
+            std::size_t channel_size_;
+
+            sender sender_;
+            receiver<parcelport> receiver_;
+        };
+    }}
+}}
+
+#include <hpx/config/warnings_suffix.hpp>
+
+namespace hpx { namespace traits
+{
+    // Inject additional configuration data into the factory registry for this
+    // type. This information ends up in the system wide configuration database
+    // under the plugin specific section:
+    //
+    //      [hpx.parcel.shmem]
+    //      ...
+    //      priority = 1000
+    //
+    template <>
+    struct plugin_config_data<hpx::parcelset::policies::shmem::parcelport>
+    {
+        static char const* priority()
+        {
+            return "1000";
+        }
+        static void init(int *argc, char ***argv, util::command_line_handling &cfg)
+        {
+        }
+
+        static char const* call()
+        {
+            return
+                "num_channels = ${HPX_PARCEL_SHMEM_NUM_CHANNELS:32}\n"
+                "channel_size = ${HPX_PARCEL_SHMEM_CHANNEL_SIZE:1048576}\n"
+                ;
+        }
+    };
+}}
+
+HPX_REGISTER_PARCELPORT(
+    hpx::parcelset::policies::shmem::parcelport,
+    shmem);
+
+#endif
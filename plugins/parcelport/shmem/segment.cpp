@@ -0,0 +1,228 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_NETWORKING) && defined(HPX_HAVE_PARCELPORT_SHMEM)
+
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <boost/asio/ip/host_name.hpp>
+#include <boost/atomic.hpp>
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <new>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace hpx { namespace parcelset { namespace policies { namespace shmem
+{
+    namespace detail
+    {
+        std::uint64_t const segment_magic = 0x6870782e73686d31ull;  // hpx.shm1
+
+        struct segment_header
+        {
+            std::uint64_t magic_;
+            std::uint64_t num_channels_;
+            std::uint64_t channel_size_;
+            boost::atomic<std::uint32_t> ready_;
+        };
+
+        std::size_t round_up(std::size_t size)
+        {
+            std::size_t const align = BOOST_LOCKFREE_CACHELINE_BYTES;
+            return (size + align - 1) / align * align;
+        }
+
+        std::size_t header_size()
+        {
+            return round_up(sizeof(segment_header));
+        }
+
+        std::string error_message(char const* what, std::string const& name)
+        {
+            return std::string(what) + " '" + name + "': " +
+                std::strerror(errno);
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    segment::segment(std::int32_t pid, std::size_t num_channels,
+            std::size_t channel_size)
+      : name_(name(pid)), base_(nullptr), size_(0), owner_(true)
+    {
+        if (!boost::atomic<std::uint64_t>().is_lock_free())
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "the shared memory parcelport requires lock-free 64 bit "
+                "atomics");
+        }
+
+        // remove a stale segment left behind by a process with the same id
+        ::shm_unlink(name_.c_str());
+
+        int fd = ::shm_open(name_.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                detail::error_message("could not create segment", name_));
+        }
+
+        std::size_t stride =
+            detail::round_up(sizeof(channel_header) + channel_size);
+        std::size_t size = detail::header_size() + num_channels * stride;
+
+        if (::ftruncate(fd, static_cast<off_t>(size)) == -1)
+        {
+            std::string msg =
+                detail::error_message("could not resize segment", name_);
+            ::close(fd);
+            ::shm_unlink(name_.c_str());
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment", msg);
+        }
+
+        map(fd, size);
+
+        // the memory of a new segment is zero-initialized, which makes all
+        // channels unclaimed and empty
+        detail::segment_header* header =
+            static_cast<detail::segment_header*>(base_);
+        header->magic_ = detail::segment_magic;
+        header->num_channels_ = num_channels;
+        header->channel_size_ = channel_size;
+        header->ready_.store(1, boost::memory_order_release);
+    }
+
+    segment::segment(std::int32_t pid)
+      : name_(name(pid)), base_(nullptr), size_(0), owner_(false)
+    {
+        int fd = ::shm_open(name_.c_str(), O_RDWR, 0600);
+        if (fd == -1)
+        {
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                detail::error_message("could not open segment", name_));
+        }
+
+        struct stat st;
+        if (::fstat(fd, &st) == -1 ||
+            static_cast<std::size_t>(st.st_size) < detail::header_size())
+        {
+            ::close(fd);
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "invalid shared memory segment '" + name_ + "'");
+        }
+
+        map(fd, static_cast<std::size_t>(st.st_size));
+
+        detail::segment_header* header =
+            static_cast<detail::segment_header*>(base_);
+        if (header->ready_.load(boost::memory_order_acquire) == 0 ||
+            header->magic_ != detail::segment_magic)
+        {
+            ::munmap(base_, size_);
+            base_ = nullptr;
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::segment",
+                "invalid shared memory segment '" + name_ + "'");
+        }
+    }
+
+    segment::~segment()
+    {
+        if (base_ != nullptr)
+            ::munmap(base_, size_);
+        if (owner_)
+            ::shm_unlink(name_.c_str());
+    }
+
+    void segment::map(int fd, std::size_t size)
+    {
+        void* base = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+            fd, 0);
+        if (base == MAP_FAILED)
+        {
+            std::string msg =
+                detail::error_message("could not map segment", name_);
+            ::close(fd);
+            if (owner_)
+                ::shm_unlink(name_.c_str());
+            HPX_THROW_EXCEPTION(network_error, "shmem::segment::map", msg);
+        }
+
+        ::close(fd);
+        base_ = base;
+        size_ = size;
+    }
+
+    std::size_t segment::num_channels() const
+    {
+        return static_cast<std::size_t>(
+            static_cast<detail::segment_header const*>(base_)->num_channels_);
+    }
+
+    std::size_t segment::channel_stride() const
+    {
+        std::size_t channel_size = static_cast<std::size_t>(
+            static_cast<detail::segment_header const*>(base_)->channel_size_);
+        return detail::round_up(sizeof(channel_header) + channel_size);
+    }
+
+    channel segment::get_channel(std::size_t i) const
+    {
+        HPX_ASSERT(i < num_channels());
+
+        char* p = static_cast<char*>(base_) + detail::header_size() +
+            i * channel_stride();
+        return channel(reinterpret_cast<channel_header*>(p),
+            p + sizeof(channel_header),
+            static_cast<std::size_t>(
+                static_cast<detail::segment_header const*>(base_)->
+                    channel_size_));
+    }
+
+    channel segment::claim_channel(std::int32_t owner) const
+    {
+        std::size_t count = num_channels();
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            channel c = get_channel(i);
+            if (c.claim(owner))
+                return c;
+        }
+        return channel();
+    }
+
+    std::string segment::name(std::int32_t pid)
+    {
+        return "/hpx.shmem." + std::to_string(pid);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::string node_name()
+    {
+        std::string name = boost::asio::ip::host_name();
+
+        // host names are not necessarily unique (think of containers), the
+        // boot id makes sure we only ever connect to processes sharing the
+        // same kernel
+        std::ifstream boot_id("/proc/sys/kernel/random/boot_id");
+        std::string id;
+        if (boot_id >> id)
+            name += "/" + id;
+
+        return name;
+    }
+}}}}
+
+#endif
@@ -65,6 +65,7 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
             util::function_nonser<void()> const& on_stop_thread)
       : base_type(ini, parcelport_address(ini), on_start_thread, on_stop_thread)
       , acceptor_(nullptr)
+      , emulation_(ini)
     {
         if (here_.type() != std::string("tcp")) {
             HPX_THROW_EXCEPTION(network_error, "tcp::parcelport::parcelport",
@@ -153,7 +154,8 @@ namespace hpx { namespace parcelset { namespace policies { namespace tcp
 
         // The parcel gets serialized inside the connection constructor, no
         // need to keep the original parcel alive after this call returned.
-        std::shared_ptr<sender> sender_connection(new sender(io_service, l, this));
+        std::shared_ptr<sender> sender_connection(new sender(io_service, l, this,
+            emulation_.enabled() ? &emulation_ : nullptr));
 
         // Connect to the target locality, retry if needed
         boost::system::error_code error = boost::asio::error::try_again;
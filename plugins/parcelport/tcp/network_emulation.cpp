@@ -0,0 +1,89 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+
+#if defined(HPX_HAVE_PARCELPORT_TCP)
+#include <hpx/plugins/parcelport/tcp/network_emulation.hpp>
+#include <hpx/util/runtime_configuration.hpp>
+#include <hpx/util/safe_lexical_cast.hpp>
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <random>
+
+namespace hpx { namespace parcelset { namespace policies { namespace tcp
+{
+    network_emulation::network_emulation(util::runtime_configuration const& ini)
+      : network_emulation(
+            std::chrono::microseconds(hpx::util::get_entry_as<std::int64_t>(
+                ini, "hpx.parcel.tcp.emulated_latency", "0")),
+            std::chrono::microseconds(hpx::util::get_entry_as<std::int64_t>(
+                ini, "hpx.parcel.tcp.emulated_jitter", "0")),
+            hpx::util::get_entry_as<double>(
+                ini, "hpx.parcel.tcp.emulated_bandwidth", "0"),
+            hpx::util::get_entry_as<std::int64_t>(
+                ini, "hpx.parcel.tcp.emulated_reordering", "0"),
+            hpx::util::get_entry_as<std::uint32_t>(
+                ini, "hpx.parcel.tcp.emulation_seed", "0"))
+    {
+        enabled_ = hpx::util::get_entry_as<int>(
+            ini, "hpx.parcel.tcp.emulate_network", "0") != 0;
+    }
+
+    network_emulation::network_emulation(std::chrono::nanoseconds latency,
+            std::chrono::nanoseconds jitter, double bandwidth,
+            std::int64_t reordering, std::uint32_t seed)
+      : enabled_(true)
+      , latency_(latency)
+      , jitter_(jitter)
+      , bandwidth_(bandwidth / 1000.0)
+      , reordering_(reordering)
+      , link_available_()
+      , random_(seed)
+    {
+        if (latency_.count() < 0)
+            latency_ = std::chrono::nanoseconds(0);
+        if (jitter_.count() < 0)
+            jitter_ = std::chrono::nanoseconds(0);
+        if (bandwidth_ < 0)
+            bandwidth_ = 0;
+    }
+
+    network_emulation::time_point network_emulation::release_time(
+        std::size_t bytes, time_point now)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+
+        // the link is busy until all earlier messages have been transmitted
+        link_available_ = (std::max)(now, link_available_);
+        if (bandwidth_ != 0)
+        {
+            link_available_ += std::chrono::nanoseconds(
+                static_cast<std::int64_t>(bytes / bandwidth_));
+        }
+
+        std::chrono::nanoseconds delay = latency_;
+        if (jitter_.count() != 0)
+        {
+            std::uniform_int_distribution<std::int64_t> dist(0, jitter_.count());
+            delay += std::chrono::nanoseconds(dist(random_));
+        }
+
+        if (reordering_ != 0)
+        {
+            std::uniform_int_distribution<std::int64_t> dist(0, 99);
+            if (dist(random_) < reordering_)
+                delay += latency_ + jitter_;
+        }
+
+        return link_available_ + delay;
+    }
+}}}}
+
+#endif
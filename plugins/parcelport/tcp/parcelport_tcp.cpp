@@ -21,6 +21,8 @@ namespace hpx { namespace traits
     //      [hpx.parcel.tcp]
     //      ...
     //      priority = 1
+    //      emulate_network = 0
+    //      ...
     //
     template <>
     struct plugin_config_data<hpx::parcelset::policies::tcp::connection_handler>
@@ -35,7 +37,14 @@ namespace hpx { namespace traits
         }
         static char const* call()
         {
-            return "";
+            return
+                "emulate_network = ${HPX_PARCEL_TCP_EMULATE_NETWORK:0}\n"
+                "emulated_latency = ${HPX_PARCEL_TCP_EMULATED_LATENCY:0}\n"
+                "emulated_jitter = ${HPX_PARCEL_TCP_EMULATED_JITTER:0}\n"
+                "emulated_bandwidth = ${HPX_PARCEL_TCP_EMULATED_BANDWIDTH:0}\n"
+                "emulated_reordering = ${HPX_PARCEL_TCP_EMULATED_REORDERING:0}\n"
+                "emulation_seed = ${HPX_PARCEL_TCP_EMULATION_SEED:0}\n"
+                ;
         }
     };
 }}
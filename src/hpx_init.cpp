@@ -518,7 +518,8 @@ namespace hpx
             if (vm.count("hpx:high-priority-threads")) {
                 throw detail::command_line_error("Invalid command line option "
                     "--hpx:high-priority-threads, valid for "
-                    "--hpx:queuing=local-priority and "
+                    "--hpx:queuing=local-priority, "
+                    "--hpx:queuing=numa-priority, and "
                     "--hpx:queuing=abp-priority only");
             }
         }
@@ -529,7 +530,8 @@ namespace hpx
             if (vm.count("hpx:numa-sensitive")) {
                 throw detail::command_line_error("Invalid command line option "
                     "--hpx:numa-sensitive, valid for "
-                    "--hpx:queuing=local, --hpx:queuing=local-priority, or "
+                    "--hpx:queuing=local, --hpx:queuing=local-priority, "
+                    "--hpx:queuing=numa-priority, or "
                     "--hpx:queuing=abp-priority only");
             }
         }
@@ -1088,6 +1090,54 @@ namespace hpx
 #endif
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        // NUMA aware priority scheduler: local priority queues for each OS
+        // thread, work is stolen from cores sharing a cache first, then from
+        // the same NUMA domain, and only then from other NUMA domains
+        int run_numa_priority(startup_function_type startup,
+            shutdown_function_type shutdown,
+            util::command_line_handling& cfg, bool blocking)
+        {
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+            ensure_hierarchy_arity_compatibility(cfg.vm_);
+
+            std::size_t num_high_priority_queues =
+                get_num_high_priority_queues(cfg);
+            std::size_t pu_offset = get_pu_offset(cfg);
+            std::size_t pu_step = get_pu_step(cfg);
+            std::string affinity_domain = get_affinity_domain(cfg);
+            std::string affinity_desc;
+            std::size_t numa_sensitive =
+                get_affinity_description(cfg, affinity_desc);
+
+            // scheduling policy
+            typedef hpx::threads::policies::numa_priority_queue_scheduler<>
+                numa_queue_policy;
+
+            numa_queue_policy::init_parameter_type init(
+                cfg.num_threads_, num_high_priority_queues, 1000,
+                numa_sensitive, "core-numa_priority_queue_scheduler");
+            threads::policies::init_affinity_data affinity_init(
+                pu_offset, pu_step, affinity_domain, affinity_desc);
+
+            LPROGRESS_ << "run_numa_priority: create runtime";
+
+            // Build and configure this runtime instance.
+            typedef hpx::runtime_impl<numa_queue_policy> runtime_type;
+            std::unique_ptr<hpx::runtime> rt(
+                new runtime_type(cfg.rtcfg_, cfg.mode_, cfg.num_threads_, init,
+                    affinity_init));
+
+            return run_or_start(blocking, std::move(rt), cfg,
+                std::move(startup), std::move(shutdown));
+#else
+            throw detail::command_line_error("Command line option "
+                "--hpx:queuing=numa-priority "
+                "is not configured in this build. Please rebuild with "
+                "'cmake -DHPX_WITH_THREAD_SCHEDULERS=numa-priority'.");
+#endif
+        }
+
         ///////////////////////////////////////////////////////////////////////
         HPX_EXPORT int run_or_start(
             util::function_nonser<
@@ -1180,6 +1230,16 @@ namespace hpx
                             hpx::threads::policies::lockfree_lifo
                         >(std::move(startup), std::move(shutdown), cfg, blocking);
                 }
+                else if (0 == std::string("local-priority-chase-lev").find(cfg.queuing_))
+                {
+                    // local scheduler with priority queue (one Chase-Lev
+                    // work-stealing deque for each OS thread plus separate
+                    // dequeues for low/high priority HPX-threads)
+                    cfg.queuing_ = "local-priority-chase-lev";
+                    result = run_priority_local<
+                            hpx::threads::policies::lockfree_chase_lev
+                        >(std::move(startup), std::move(shutdown), cfg, blocking);
+                }
                 else if (0 == std::string("static-priority").find(cfg.queuing_))
                 {
                     cfg.queuing_ = "static-priority";
@@ -1209,6 +1269,14 @@ namespace hpx
                     result = run_periodic(std::move(startup),
                         std::move(shutdown), cfg, blocking);
                 }
+                else if (0 == std::string("numa-priority").find(cfg.queuing_))
+                {
+                    // local scheduler with priority queues, steals work based
+                    // on the cache and NUMA topology of the machine
+                    cfg.queuing_ = "numa-priority";
+                    result = run_numa_priority(std::move(startup),
+                        std::move(shutdown), cfg, blocking);
+                }
                 else if (0 == std::string("throttle").find(cfg.queuing_)) {
                     cfg.queuing_ = "throttle";
                     result = run_throttle(std::move(startup),
@@ -56,6 +56,15 @@ namespace hpx { namespace performance_counters
             invocation_count_registry::remote_instance(), ec);
     }
 
+    bool inlined_action_invocation_counter_discoverer(counter_info const& info,
+        discover_counter_func const& f, discover_counters_mode mode,
+        error_code& ec)
+    {
+        using hpx::actions::detail::invocation_count_registry;
+        return action_invocation_counter_discoverer(info, f, mode,
+            invocation_count_registry::inlined_instance(), ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // Creation function for action invocation counter
     naming::gid_type action_invocation_counter_creator(counter_info const& info,
@@ -116,5 +125,13 @@ namespace hpx { namespace performance_counters
         return action_invocation_counter_creator(info,
             invocation_count_registry::remote_instance(), ec);
     }
+
+    naming::gid_type inlined_action_invocation_counter_creator(
+        counter_info const& info, error_code& ec)
+    {
+        using hpx::actions::detail::invocation_count_registry;
+        return action_invocation_counter_creator(info,
+            invocation_count_registry::inlined_instance(), ec);
+    }
 }}
 
@@ -14,6 +14,7 @@
 #include <cstdint>
 #include <string>
 #include <utility>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace performance_counters
@@ -110,6 +111,57 @@ namespace hpx { namespace performance_counters
         return per_action_data_counter_creator(info,
             per_action_data_counter_registry::instance(), f, ec);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Creation function for per-action parcel data histogram counters
+    naming::gid_type per_action_histogram_counter_creator(
+        counter_info const& info,
+        hpx::util::function_nonser<
+            std::vector<std::int64_t>(std::string const&, bool)
+        > const& counter_func,
+        error_code& ec)
+    {
+        switch (info.type_) {
+        case counter_histogram:
+            {
+                counter_path_elements paths;
+                get_counter_path_elements(info.fullname_, paths, ec);
+                if (ec) return naming::invalid_gid;
+
+                if (paths.parentinstance_is_basename_) {
+                    HPX_THROWS_IF(ec, bad_parameter,
+                        "per_action_histogram_counter_creator",
+                        "invalid action histogram counter name (instance name "
+                        "must not be a valid base counter name)");
+                    return naming::invalid_gid;
+                }
+
+                if (paths.parameters_.empty()) {
+                    // if no parameters (action name) is given assume that this
+                    // counter should report the combined data for all actions
+                    using util::placeholders::_1;
+                    hpx::util::function_nonser<std::vector<std::int64_t>(bool)>
+                        f = util::bind(counter_func, paths.parameters_, _1);
+                    return detail::create_raw_counter(info, std::move(f), ec);
+                }
+
+                // ask registry
+                using hpx::parcelset::detail::per_action_data_counter_registry;
+                hpx::util::function_nonser<std::vector<std::int64_t>(bool)> f =
+                    per_action_data_counter_registry::instance().
+                        get_histogram_counter(paths.parameters_, counter_func);
+
+                return detail::create_raw_counter(info, std::move(f), ec);
+            }
+            break;
+
+        default:
+            HPX_THROWS_IF(ec, bad_parameter,
+                "per_action_histogram_counter_creator",
+                "invalid counter type requested");
+            return naming::invalid_gid;
+        }
+    }
 }}
 
 #endif
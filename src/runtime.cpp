@@ -500,6 +500,18 @@ namespace hpx
               &performance_counters::remote_action_invocation_counter_creator,
               &performance_counters::remote_action_invocation_counter_discoverer,
               ""
+            },
+
+            { "/runtime/count/remote-action-inlined",
+              performance_counters::counter_raw,
+              "returns the number of (remote) invocations of a specific action "
+              "on this locality which were executed directly on the thread "
+              "decoding the parcel (the action type has to be specified as the "
+              "counter parameter)",
+              HPX_PERFORMANCE_COUNTER_V1,
+              &performance_counters::inlined_action_invocation_counter_creator,
+              &performance_counters::inlined_action_invocation_counter_discoverer,
+              ""
             }
         };
         performance_counters::install_counter_types(
@@ -1099,7 +1111,13 @@ namespace hpx { namespace threads
     std::ptrdiff_t get_stack_size(threads::thread_stacksize stacksize)
     {
         if (stacksize == threads::thread_stacksize_current)
-            return threads::get_self_stacksize();
+        {
+            // threads created from a stackless thread get a regular stack
+            std::ptrdiff_t size = threads::get_self_stacksize();
+            if (size == 0)
+                return get_runtime().get_config().get_default_stack_size();
+            return size;
+        }
 
         return get_runtime().get_config().get_stack_size(stacksize);
     }
@@ -7,6 +7,8 @@
 #include <hpx/runtime/actions/detail/action_factory.hpp>
 #include <hpx/util/assert.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <unordered_map>
@@ -19,16 +21,18 @@ namespace hpx { namespace actions { namespace detail
       : max_id_(0)
     {}
 
-    void action_registry::register_factory(std::string const& type_name, ctor_t ctor)
+    void action_registry::register_factory(std::string const& type_name,
+        ctor_t ctor, std::uint32_t* id)
     {
         HPX_ASSERT(ctor != nullptr);
 
-        typename_to_ctor_.emplace(std::string(type_name), ctor);
+        factory_t factory(ctor, id);
+        typename_to_ctor_.emplace(std::string(type_name), factory);
 
         // populate cache
         typename_to_id_t::const_iterator it = typename_to_id_.find(type_name);
         if (it != typename_to_id_.end())
-            cache_id(it->second, ctor);
+            cache_id(it->second, factory);
     }
 
     void action_registry::register_typename(
@@ -59,8 +63,13 @@ namespace hpx { namespace actions { namespace detail
     // This makes sure that the registries are consistent.
     void action_registry::fill_missing_typenames()
     {
-        // Register all type-names and ssign missing ids
-        for (std::string const& str : get_unassigned_typenames())
+        // Register all type-names and assign missing ids. The ids are
+        // assigned in the order of the type-names, which makes them depend
+        // only on the set of registered actions.
+        std::vector<std::string> typenames = get_unassigned_typenames();
+        std::sort(typenames.begin(), typenames.end());
+
+        for (std::string const& str : typenames)
             register_typename(str, ++max_id_);
 
         // Go over all registered mappings from type-names to ids and
@@ -94,6 +103,40 @@ namespace hpx { namespace actions { namespace detail
         return it->second;
     }
 
+    std::uint64_t action_registry::get_checksum() const
+    {
+        typedef std::pair<std::uint32_t, std::string const*> entry_type;
+
+        std::vector<entry_type> entries;
+        entries.reserve(typename_to_id_.size());
+        for (typename_to_id_t::value_type const& v : typename_to_id_)
+            entries.push_back(entry_type(v.second, &v.first));
+
+        std::sort(entries.begin(), entries.end(),
+            [](entry_type const& lhs, entry_type const& rhs)
+            {
+                return lhs.first < rhs.first;
+            });
+
+        // 64 bit FNV-1a over all ids and typenames
+        std::uint64_t hash = 14695981039346656037ull;
+        auto combine = [&hash](std::uint8_t c)
+        {
+            hash ^= c;
+            hash *= 1099511628211ull;
+        };
+
+        for (entry_type const& e : entries)
+        {
+            for (std::size_t i = 0; i != sizeof(std::uint32_t); ++i)
+                combine(static_cast<std::uint8_t>(e.first >> (8 * i)));
+            for (char c : *e.second)
+                combine(static_cast<std::uint8_t>(c));
+        }
+
+        return hash;
+    }
+
     std::vector<std::string> action_registry::get_unassigned_typenames() const
     {
         typedef typename_to_ctor_t::value_type value_type;
@@ -152,19 +195,18 @@ namespace hpx { namespace actions { namespace detail
         return this_;
     }
 
-    void action_registry::cache_id(std::uint32_t id, action_registry::ctor_t ctor)
+    void action_registry::cache_id(std::uint32_t id,
+        action_registry::factory_t const& factory)
     {
         if (id >= cache_.size())
-        {
             cache_.resize(id + 1, nullptr);
-            cache_[id] = nullptr;
-            return;
-        }
 
         if (cache_[id] == nullptr)
-        {
-            cache_[id] = ctor;
-        }
+            cache_[id] = factory.first;
+
+        // let the action type know its id
+        if (factory.second != nullptr)
+            *factory.second = id;
     }
 
     std::string action_registry::collect_registered_typenames()
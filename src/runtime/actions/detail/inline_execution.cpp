@@ -0,0 +1,71 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/detail/inline_execution.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstdint>
+#include <utility>
+
+namespace hpx { namespace actions { namespace detail
+{
+    namespace
+    {
+        boost::atomic<bool> inline_execution_enabled_(false);
+        boost::atomic<std::int64_t> inline_execution_threshold_(5000);
+        boost::atomic<std::int64_t> inline_execution_samples_(16);
+
+        struct measured_thread_function_impl
+        {
+            measured_thread_function_impl(inline_execution_data& data,
+                    threads::thread_function_type && f)
+              : data_(&data), f_(std::move(f))
+            {}
+
+            threads::thread_result_type operator()(
+                threads::thread_arg_type state)
+            {
+                threads::thread_result_type result;
+                measure_execution(*data_, [&]() { result = f_(state); });
+                return result;
+            }
+
+            inline_execution_data* data_;
+            threads::thread_function_type f_;
+        };
+    }
+
+    void configure_inline_execution(bool enable, std::int64_t threshold,
+        std::int64_t samples)
+    {
+        inline_execution_threshold_.store(threshold);
+        inline_execution_samples_.store(samples);
+        inline_execution_enabled_.store(enable);
+    }
+
+    bool inline_execution_enabled()
+    {
+        return inline_execution_enabled_.load(boost::memory_order_relaxed);
+    }
+
+    std::int64_t inline_execution_threshold()
+    {
+        return inline_execution_threshold_.load(boost::memory_order_relaxed);
+    }
+
+    std::int64_t inline_execution_samples()
+    {
+        return inline_execution_samples_.load(boost::memory_order_relaxed);
+    }
+
+    threads::thread_function_type measured_thread_function(
+        inline_execution_data& data, threads::thread_function_type && f)
+    {
+        return measured_thread_function_impl(data, std::move(f));
+    }
+}}}
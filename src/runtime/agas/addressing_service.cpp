@@ -41,11 +41,12 @@
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/lcos/local/promise.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/lcos/broadcast.hpp>
 
 #include <boost/format.hpp>
-#include <boost/icl/closed_interval.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -60,68 +61,21 @@
 
 namespace hpx { namespace agas
 {
-struct addressing_service::gva_cache_key
-{ // {{{ gva_cache_key implementation
-  private:
-    typedef boost::icl::closed_interval<naming::gid_type, std::less>
-        key_type;
-
-    key_type key_;
-
-  public:
-    gva_cache_key()
-      : key_()
-    {}
-
-    explicit gva_cache_key(
-        naming::gid_type const& id_
-      , std::uint64_t count_ = 1
-        )
-      : key_(naming::detail::get_stripped_gid(id_)
-           , naming::detail::get_stripped_gid(id_) + (count_ - 1))
-    {
-        HPX_ASSERT(count_);
-    }
-
-    naming::gid_type get_gid() const
-    {
-        return boost::icl::lower(key_);
-    }
-
-    std::uint64_t get_count() const
+struct addressing_service::credit_request_batch
+{ // {{{ credit_request_batch implementation
+    explicit credit_request_batch(bool acknowledge)
+      : acknowledge_(acknowledge)
     {
-        naming::gid_type const size = boost::icl::length(key_);
-        HPX_ASSERT(size.get_msb() == 0);
-        return size.get_lsb();
+        if (acknowledge_)
+            sent_ = promise_.get_future();
     }
 
-    friend bool operator<(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        return boost::icl::exclusive_less(lhs.key_, rhs.key_);
-    }
-
-    friend bool operator==(
-        gva_cache_key const& lhs
-      , gva_cache_key const& rhs
-        )
-    {
-        // Direct hit
-        if(lhs.key_ == rhs.key_)
-            return true;
-
-        // Is lhs in rhs?
-        if (1 == lhs.get_count() && 1 != rhs.get_count())
-            return boost::icl::contains(rhs.key_, lhs.key_);
-
-        // Is rhs in lhs?
-        else if (1 != lhs.get_count() && 1 == rhs.get_count())
-            return boost::icl::contains(lhs.key_, rhs.key_);
+    credit_requests requests_;
 
-        return false;
-    }
+    // Whether some incref is waiting for the requests to be acknowledged
+    bool acknowledge_;
+    lcos::local::promise<void> promise_;
+    hpx::shared_future<void> sent_;
 }; // }}}
 
 addressing_service::addressing_service(
@@ -795,6 +749,82 @@ hpx::future<bool> addressing_service::bind_range_async(
         ));
 }
 
+hpx::future<void> addressing_service::bind_bulk(
+    std::vector<naming::gid_type> const& ids
+  , std::vector<naming::address> const& addrs
+  , naming::gid_type const& locality
+    )
+{
+    if (ids.size() != addrs.size())
+    {
+        return hpx::make_exceptional_future<void>(
+            HPX_GET_EXCEPTION(bad_parameter,
+                "addressing_service::bind_bulk",
+                "number of addresses does not match number of ids"));
+    }
+
+    std::vector<naming::gid_type> stripped_ids;
+    std::vector<gva> gvas;
+    stripped_ids.reserve(ids.size());
+    gvas.reserve(ids.size());
+
+    // group the ids by the primary namespace instance managing them
+    typedef std::map<naming::gid_type, std::vector<std::size_t> >
+        requests_type;
+    requests_type requests;
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        stripped_ids.push_back(
+            naming::detail::get_stripped_gid_except_dont_cache(ids[i]));
+        gvas.push_back(gva(addrs[i].locality_, addrs[i].type_, 1,
+            addrs[i].address_, 0));
+
+        requests[primary_namespace::get_service_instance(stripped_ids[i])]
+            .push_back(i);
+    }
+
+    std::vector<hpx::future<void> > lazy_results;
+    lazy_results.reserve(requests.size());
+
+    for (requests_type::const_reference r : requests)
+    {
+        std::vector<naming::gid_type> request_ids;
+        std::vector<gva> request_gvas;
+        request_ids.reserve(r.second.size());
+        request_gvas.reserve(r.second.size());
+
+        for (std::size_t i : r.second)
+        {
+            request_ids.push_back(stripped_ids[i]);
+            request_gvas.push_back(gvas[i]);
+        }
+
+        lazy_results.push_back(primary_ns_.bind_gid_async(
+            std::move(request_gvas), std::move(request_ids), locality));
+    }
+
+    using util::placeholders::_1;
+    return hpx::when_all(lazy_results).then(util::bind(
+            util::one_shot(&addressing_service::bind_bulk_postproc),
+            this, _1, std::move(stripped_ids), std::move(gvas)
+        ));
+}
+
+void addressing_service::bind_bulk_postproc(
+    future<std::vector<future<void> > > f
+  , std::vector<naming::gid_type> const& ids
+  , std::vector<gva> const& gvas
+    )
+{
+    // re-throw possible errors
+    for (future<void>& r : f.get())
+        r.get();
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+        update_cache_entry(ids[i], gvas[i]);
+}
+
 hpx::future<naming::address> addressing_service::unbind_range_async(
     naming::gid_type const& lower_id
   , std::uint64_t count
@@ -1264,6 +1294,161 @@ hpx::future<naming::address> addressing_service::resolve_full_async(
         ));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+hpx::future<std::vector<naming::address> > addressing_service::resolve_bulk(
+    std::vector<naming::gid_type> const& gids
+    )
+{
+    std::vector<naming::address> addrs(gids.size());
+
+    // group all ids which are not in the cache by the primary namespace
+    // instance managing them
+    typedef std::map<naming::gid_type, std::vector<std::size_t> >
+        requests_type;
+    requests_type requests;
+
+    for (std::size_t i = 0; i != gids.size(); ++i)
+    {
+        if (!gids[i])
+        {
+            return hpx::make_exceptional_future<std::vector<naming::address> >(
+                HPX_GET_EXCEPTION(bad_parameter,
+                    "addressing_service::resolve_bulk",
+                    "invalid reference id"));
+        }
+
+        if (caching_)
+        {
+            error_code ec;
+            if (resolve_cached(gids[i], addrs[i], ec))
+                continue;
+
+            if (ec)
+            {
+                return hpx::make_exceptional_future<
+                        std::vector<naming::address>
+                    >(hpx::detail::access_exception(ec));
+            }
+        }
+
+        requests[primary_namespace::get_service_instance(gids[i])]
+            .push_back(i);
+    }
+
+    if (requests.empty())
+        return hpx::make_ready_future(std::move(addrs));
+
+    // send one request to each of the primary namespace instances
+    std::vector<std::vector<std::size_t> > indices;
+    std::vector<hpx::future<std::vector<primary_namespace::resolved_type> > >
+        lazy_results;
+    indices.reserve(requests.size());
+    lazy_results.reserve(requests.size());
+
+    for (requests_type::reference r : requests)
+    {
+        std::vector<naming::gid_type> request_ids;
+        request_ids.reserve(r.second.size());
+        for (std::size_t i : r.second)
+            request_ids.push_back(gids[i]);
+
+        lazy_results.push_back(
+            primary_ns_.resolve_full(std::move(request_ids)));
+        indices.push_back(std::move(r.second));
+    }
+
+    using util::placeholders::_1;
+    return hpx::when_all(lazy_results).then(util::bind(
+            util::one_shot(&addressing_service::resolve_bulk_postproc),
+            this, _1, gids, std::move(indices), std::move(addrs)
+        ));
+}
+
+hpx::future<std::vector<naming::address> > addressing_service::resolve_bulk(
+    std::vector<naming::id_type> const& ids
+    )
+{
+    std::vector<naming::gid_type> gids;
+    gids.reserve(ids.size());
+    for (naming::id_type const& id : ids)
+    {
+        if (!id)
+        {
+            return hpx::make_exceptional_future<std::vector<naming::address> >(
+                HPX_GET_EXCEPTION(bad_parameter,
+                    "addressing_service::resolve_bulk",
+                    "invalid reference id"));
+        }
+        gids.push_back(id.get_gid());
+    }
+
+    return resolve_bulk(gids);
+}
+
+std::vector<naming::address> addressing_service::resolve_bulk_postproc(
+    future<std::vector<
+        future<std::vector<primary_namespace::resolved_type> >
+    > > f
+  , std::vector<naming::gid_type> const& gids
+  , std::vector<std::vector<std::size_t> > const& indices
+  , std::vector<naming::address> addrs
+    )
+{
+    using hpx::util::get;
+
+    std::vector<future<std::vector<primary_namespace::resolved_type> > >
+        results = f.get();
+    HPX_ASSERT(results.size() == indices.size());
+
+    for (std::size_t j = 0; j != results.size(); ++j)
+    {
+        std::vector<primary_namespace::resolved_type> reps = results[j].get();
+        HPX_ASSERT(reps.size() == indices[j].size());
+
+        for (std::size_t k = 0; k != reps.size(); ++k)
+        {
+            primary_namespace::resolved_type const& rep = reps[k];
+            naming::gid_type const& id = gids[indices[j][k]];
+
+            if (get<0>(rep) == naming::invalid_gid ||
+                get<2>(rep) == naming::invalid_gid)
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "addressing_service::resolve_bulk_postproc",
+                    "could not resolve global id");
+            }
+
+            // Resolve the gva to the real resolved address (which is just a
+            // gva with as fully resolved LVA and and offset of zero).
+            naming::gid_type base_gid = get<0>(rep);
+            gva const base_gva = get<1>(rep);
+
+            gva const g = base_gva.resolve(id, base_gid);
+
+            naming::address& addr = addrs[indices[j][k]];
+            addr.locality_ = g.prefix;
+            addr.type_ = g.type;
+            addr.address_ = g.lva();
+
+            if (naming::detail::store_in_cache(id))
+            {
+                if (range_caching_)
+                {
+                    // Put the range into the cache.
+                    update_cache_entry(base_gid, base_gva);
+                }
+                else
+                {
+                    // Put the fully resolved gva into the cache.
+                    update_cache_entry(id, g);
+                }
+            }
+        }
+    }
+
+    return addrs;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 bool addressing_service::resolve_full_local(
     naming::gid_type const* gids
@@ -1415,6 +1600,17 @@ std::int64_t addressing_service::synchronize_with_async_incref(
     return fut.get() + compensated_credit;
 }
 
+std::int64_t addressing_service::synchronize_with_incref_batch(
+    hpx::shared_future<void> fut
+  , naming::id_type const& id
+  , std::int64_t compensated_credit
+    )
+{
+    // re-throw possible errors
+    fut.get();
+    return compensated_credit;
+}
+
 lcos::future<std::int64_t> addressing_service::incref_async(
     naming::gid_type const& id
   , std::int64_t credit
@@ -1513,18 +1709,168 @@ lcos::future<std::int64_t> addressing_service::incref_async(
     }
 
     naming::gid_type const e_lower = pending_incref.first;
+    naming::gid_type const target =
+        primary_namespace::get_service_instance(e_lower);
+
+    using util::placeholders::_1;
+
+    if (naming::get_locality_from_gid(target) == get_local_locality())
+    {
+        lcos::future<std::int64_t> f = primary_ns_.increment_credit(
+            pending_incref.second, e_lower, e_lower);
+
+        // pass the amount of compensated decrefs to the callback
+        return f.then(util::bind(
+                util::one_shot(&addressing_service::synchronize_with_async_incref),
+                this, _1, keep_alive, pending_decrefs
+            ));
+    }
+
+    // Remote increments are combined with all other credit requests for the
+    // same primary namespace instance which are issued before the thread
+    // sending them gets to run.
+    hpx::shared_future<void> sent;
+    bool send_requests = false;
+
+    {
+        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
 
-    lcos::future<std::int64_t> f =
-        primary_ns_.increment_credit(pending_incref.second, e_lower, e_lower);
+        std::shared_ptr<credit_request_batch>& batch = incref_requests_[target];
+        if (!batch)
+        {
+            batch = std::make_shared<credit_request_batch>(true);
+            send_requests = true;
+        }
+
+        batch->requests_.add(e_lower, pending_incref.second);
+        sent = batch->sent_;
+    }
+
+    if (send_requests)
+    {
+        threads::register_thread_nullary(
+            util::deferred_call(&addressing_service::send_incref_requests,
+                this, target),
+            "addressing_service::send_incref_requests", threads::pending, true,
+            threads::thread_priority_normal, std::size_t(-1),
+            threads::thread_stacksize_default);
+    }
 
     // pass the amount of compensated decrefs to the callback
-    using util::placeholders::_1;
-    return f.then(util::bind(
-            util::one_shot(&addressing_service::synchronize_with_async_incref),
+    return sent.then(util::bind(
+            util::one_shot(&addressing_service::synchronize_with_incref_batch),
             this, _1, keep_alive, pending_decrefs
         ));
 } // }}}
 
+void addressing_service::send_incref_requests(
+    naming::gid_type const& target
+    )
+{
+    std::shared_ptr<credit_request_batch> batch;
+
+    {
+        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
+
+        // the requests may have been sent already by a flush of the pending
+        // decrements
+        credit_request_batches_type::iterator it = incref_requests_.find(target);
+        if (it == incref_requests_.end())
+            return;
+
+        batch = std::move(it->second);
+        incref_requests_.erase(it);
+    }
+
+    LAGAS_(info) << (boost::format(
+        "addressing_service::send_incref_requests, target(%1%), "
+        "requests(%2%)")
+        % target % batch->requests_.size());
+
+    send_credit_requests(target, batch, false);
+}
+
+hpx::future<void> addressing_service::incref_bulk(
+    std::vector<std::pair<naming::gid_type, std::int64_t> > const& requests
+    )
+{
+    if (HPX_UNLIKELY(nullptr == threads::get_self_ptr()))
+    {
+        // reschedule this call as an HPX thread
+        return async(&addressing_service::incref_bulk, this, requests);
+    }
+
+    typedef std::pair<naming::gid_type, std::int64_t> request_type;
+    for (request_type const& r : requests)
+    {
+        if (HPX_UNLIKELY(0 >= r.second))
+        {
+            return hpx::make_exceptional_future<void>(
+                HPX_GET_EXCEPTION(bad_parameter,
+                    "addressing_service::incref_bulk",
+                    boost::str(boost::format("invalid credit count of %1%")
+                        % r.second)));
+        }
+    }
+
+    credit_request_batches_type batches;
+
+    {
+        std::lock_guard<mutex_type> l(refcnt_requests_mtx_);
+
+        typedef refcnt_requests_type::iterator iterator;
+
+        for (request_type const& r : requests)
+        {
+            naming::gid_type raw(naming::detail::get_stripped_gid(r.first));
+            std::int64_t credit = r.second;
+
+            // compensate pending decrefs, see incref_async
+            iterator matches = refcnt_requests_->find(raw);
+            if (matches != refcnt_requests_->end())
+            {
+                matches->second += credit;
+                if (matches->second < 0)
+                    continue;
+
+                credit = matches->second;
+                refcnt_requests_->erase(matches);
+
+                if (credit == 0)
+                    continue;
+            }
+
+            std::shared_ptr<credit_request_batch>& batch =
+                batches[primary_namespace::get_service_instance(raw)];
+            if (!batch)
+                batch = std::make_shared<credit_request_batch>(false);
+
+            batch->requests_.add(raw, credit);
+        }
+    }
+
+    if (batches.empty())
+        return hpx::make_ready_future();
+
+    LAGAS_(info) << (boost::format(
+        "addressing_service::incref_bulk, requests(%1%), targets(%2%)")
+        % requests.size() % batches.size());
+
+    std::vector<hpx::future<void> > lazy_results;
+    lazy_results.reserve(batches.size());
+
+    for (credit_request_batches_type::const_reference e : batches)
+        lazy_results.push_back(send_credit_requests(e.first, e.second, true));
+
+    return hpx::when_all(lazy_results).then(
+        [](hpx::future<std::vector<hpx::future<void> > > f)
+        {
+            // re-throw possible errors
+            for (hpx::future<void>& r : f.get())
+                r.get();
+        });
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void addressing_service::decref(
     naming::gid_type const& gid
@@ -1846,8 +2192,7 @@ void addressing_service::update_cache_entry(
         const gva_cache_key key(gid, count);
 
         {
-            std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-            if (!gva_cache_->update_if(key, g, check_for_collisions))
+            if (!gva_cache_->update_if(key, g, &check_for_collisions))
             {
                 if (LAGAS_ENABLED(warning))
                 {
@@ -1898,7 +2243,6 @@ bool addressing_service::get_cache_entry(
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
-    std::unique_lock<mutex_type> lock(gva_cache_mtx_);
     if(gva_cache_->get_entry(k, idbase_key, gva))
     {
         const std::uint64_t id_msb =
@@ -1906,7 +2250,6 @@ bool addressing_service::get_cache_entry(
 
         if (HPX_UNLIKELY(id_msb != idbase_key.get_gid().get_msb()))
         {
-            lock.unlock();
             HPX_THROWS_IF(ec, internal_server_error
               , "addressing_service::get_cache_entry"
               , "bad entry in cache, MSBs of GID base and GID do not match");
@@ -1935,8 +2278,6 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->clear();
 
         if (&ec != &throws)
@@ -1982,8 +2323,6 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
-        std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-
         gva_cache_->erase(
             [&gid](std::pair<gva_cache_key, gva> const& p)
             {
@@ -2133,81 +2472,68 @@ namespace detail
 // Helper functions to access the current cache statistics
 std::uint64_t addressing_service::get_cache_entries(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
     return gva_cache_->size();
 }
 
 std::uint64_t addressing_service::get_cache_hits(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return gva_cache_->hits(reset);
 }
 
 std::uint64_t addressing_service::get_cache_misses(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    return gva_cache_->misses(reset);
 }
 
 std::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return gva_cache_->evictions(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return gva_cache_->insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 std::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    return gva_cache_->get_get_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    return gva_cache_->get_insert_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    return gva_cache_->get_update_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    return gva_cache_->get_erase_entry_count(reset);
 }
 
 std::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_time(reset);
+    return gva_cache_->get_get_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_insertion_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_time(reset);
+    return gva_cache_->get_insert_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_update_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_time(reset);
+    return gva_cache_->get_update_entry_time(reset);
 }
 
 std::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
 {
-    std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_time(reset);
+    return gva_cache_->get_erase_entry_time(reset);
 }
 
 /// Install performance counter types exposing properties from the local cache.
@@ -2458,144 +2784,146 @@ void addressing_service::send_refcnt_requests(
     }
 #endif
 
-void addressing_service::send_refcnt_requests_non_blocking(
+void addressing_service::collect_credit_requests(
     std::unique_lock<addressing_service::mutex_type>& l
-  , error_code& ec
+  , credit_request_batches_type& batches
     )
 {
     HPX_ASSERT(l.owns_lock());
 
-    try {
-        if (refcnt_requests_->empty())
-        {
-            l.unlock();
-            return;
-        }
-
-        std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
+    std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
 
-        p.swap(refcnt_requests_);
-        refcnt_requests_count_ = 0;
+    p.swap(refcnt_requests_);
+    refcnt_requests_count_ = 0;
 
-        l.unlock();
+    // the pending increments are sent along with the decrements
+    batches.swap(incref_requests_);
 
-        LAGAS_(info) << (boost::format(
-            "addressing_service::send_refcnt_requests_non_blocking, "
-            "requests(%1%)")
-            % p->size());
+    l.unlock();
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-            dump_refcnt_requests(l, *p,
-                "addressing_service::send_refcnt_requests_non_blocking");
+    if (LAGAS_ENABLED(debug))
+        dump_refcnt_requests(l, *p,
+            "addressing_service::collect_credit_requests");
 #endif
 
-        // collect all requests for each locality
-        typedef
-            std::map<
-                naming::id_type,
-                std::vector<
-                    hpx::util::tuple<std::int64_t, naming::gid_type, naming::gid_type>
-                >
-            >
-            requests_type;
-        requests_type requests;
+    // collect all requests for each locality
+    for (refcnt_requests_type::const_reference e : *p)
+    {
+        HPX_ASSERT(e.second < 0);
 
-        for (refcnt_requests_type::const_reference e : *p)
-        {
-            HPX_ASSERT(e.second < 0);
+        naming::gid_type raw(e.first);
 
-            naming::gid_type raw(e.first);
+        std::shared_ptr<credit_request_batch>& batch =
+            batches[primary_namespace::get_service_instance(raw)];
+        if (!batch)
+            batch = std::make_shared<credit_request_batch>(false);
 
-            naming::id_type target(
-                primary_namespace::get_service_instance(raw)
-              , naming::id_type::unmanaged);
+        batch->requests_.add(raw, e.second);
+    }
+}
 
-            requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
-        }
+hpx::future<void> addressing_service::send_credit_requests(
+    naming::gid_type const& target
+  , std::shared_ptr<credit_request_batch> const& batch
+  , bool acknowledge
+    )
+{
+    naming::id_type id(target, naming::id_type::unmanaged);
+    server::primary_namespace::update_credits_action action;
 
-        // send requests to all locality
-        requests_type::iterator end = requests.end();
-        for (requests_type::iterator it = requests.begin(); it != end; ++it)
+    if (!acknowledge && !batch->acknowledge_)
+    {
+        hpx::apply(action, std::move(id), std::move(batch->requests_));
+        return hpx::future<void>();
+    }
+
+    hpx::future<void> f =
+        hpx::async(action, std::move(id), std::move(batch->requests_));
+
+    if (!batch->acknowledge_)
+        return f;
+
+    // notify all increfs waiting for the requests to be acknowledged
+    std::shared_ptr<credit_request_batch> b(batch);
+    return f.then(
+        [b](hpx::future<void> f)
+        {
+            try {
+                f.get();
+                b->promise_.set_value();
+            }
+            catch (...) {
+                b->promise_.set_exception(boost::current_exception());
+                throw;
+            }
+        });
+}
+
+void addressing_service::send_refcnt_requests_non_blocking(
+    std::unique_lock<addressing_service::mutex_type>& l
+  , error_code& ec
+    )
+{
+    HPX_ASSERT(l.owns_lock());
+
+    try {
+        if (refcnt_requests_->empty() && incref_requests_.empty())
         {
-            server::primary_namespace::decrement_credit_action action;
-            hpx::apply(action, std::move(it->first), std::move(it->second));
+            l.unlock();
+            return;
         }
 
+        credit_request_batches_type batches;
+        collect_credit_requests(l, batches);
+
+        LAGAS_(info) << (boost::format(
+            "addressing_service::send_refcnt_requests_non_blocking, "
+            "targets(%1%)")
+            % batches.size());
+
+        // send requests to all locality
+        for (credit_request_batches_type::const_reference e : batches)
+            send_credit_requests(e.first, e.second, false);
+
         if (&ec != &throws)
             ec = make_success_code();
     }
     catch (hpx::exception const& e) {
-        l.unlock();
+        if (l.owns_lock())
+            l.unlock();
         HPX_RETHROWS_IF(ec, e,
             "addressing_service::send_refcnt_requests_non_blocking");
     }
 }
 
-std::vector<hpx::future<std::vector<std::int64_t> > >
+std::vector<hpx::future<void> >
 addressing_service::send_refcnt_requests_async(
     std::unique_lock<addressing_service::mutex_type>& l
     )
 {
     HPX_ASSERT(l.owns_lock());
 
-    if (refcnt_requests_->empty())
+    if (refcnt_requests_->empty() && incref_requests_.empty())
     {
         l.unlock();
-        return std::vector<hpx::future<std::vector<std::int64_t> > >();
+        return std::vector<hpx::future<void> >();
     }
 
-    std::shared_ptr<refcnt_requests_type> p(new refcnt_requests_type);
-
-    p.swap(refcnt_requests_);
-    refcnt_requests_count_ = 0;
-
-    l.unlock();
+    credit_request_batches_type batches;
+    collect_credit_requests(l, batches);
 
     LAGAS_(info) << (boost::format(
         "addressing_service::send_refcnt_requests_async, "
-        "requests(%1%)")
-        % p->size());
-
-#if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    if (LAGAS_ENABLED(debug))
-        dump_refcnt_requests(l, *p,
-            "addressing_service::send_refcnt_requests_sync");
-#endif
-
-    // collect all requests for each locality
-    typedef
-        std::map<
-            naming::id_type,
-            std::vector<
-                hpx::util::tuple<std::int64_t, naming::gid_type, naming::gid_type>
-            >
-        >
-        requests_type;
-    requests_type requests;
-
-    std::vector<hpx::future<std::vector<std::int64_t> > > lazy_results;
-    for (refcnt_requests_type::const_reference e : *p)
-    {
-        HPX_ASSERT(e.second < 0);
-
-        naming::gid_type raw(e.first);
-
-        naming::id_type target(
-            primary_namespace::get_service_instance(raw)
-          , naming::id_type::unmanaged);
-
-        requests[target].push_back(hpx::util::make_tuple(e.second, raw, raw));
-    }
+        "targets(%1%)")
+        % batches.size());
 
     // send requests to all locality
-    requests_type::const_iterator end = requests.end();
-    for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
-    {
-        server::primary_namespace::decrement_credit_action action;
-        lazy_results.push_back(
-            hpx::async(action, std::move(it->first), std::move(it->second)));
-    }
+    std::vector<hpx::future<void> > lazy_results;
+    lazy_results.reserve(batches.size());
+
+    for (credit_request_batches_type::const_reference e : batches)
+        lazy_results.push_back(send_credit_requests(e.first, e.second, true));
 
     return lazy_results;
 }
@@ -2605,7 +2933,7 @@ void addressing_service::send_refcnt_requests_sync(
   , error_code& ec
     )
 {
-    std::vector<hpx::future<std::vector<std::int64_t> > > lazy_results =
+    std::vector<hpx::future<void> > lazy_results =
         send_refcnt_requests_async(l);
 
     // re throw possible errors
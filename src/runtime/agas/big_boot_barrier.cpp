@@ -73,11 +73,25 @@ namespace hpx { namespace agas { namespace detail
 
         serialization_registry.fill_missing_typenames();
 
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
         hpx::actions::detail::action_registry& action_registry =
             hpx::actions::detail::action_registry::instance();
         action_registry.fill_missing_typenames();
+#endif
     }
 
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+    // Every locality assigns the ids of its actions on its own. The ids depend
+    // only on the set of registered actions, the action_table_checksum sent
+    // with the registration of a locality verifies that they are the same
+    // everywhere.
+    void assign_action_ids()
+    {
+        hpx::actions::detail::action_registry::instance().
+            fill_missing_typenames();
+    }
+#endif
+
     ///////////////////////////////////////////////////////////////////////////
     struct unassigned_typename_sequence
     {
@@ -86,14 +100,18 @@ namespace hpx { namespace agas { namespace detail
         unassigned_typename_sequence(bool /*dummy*/)
           : serialization_typenames(hpx::serialization::detail::id_registry::
                 instance().get_unassigned_typenames())
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
           , action_typenames(hpx::actions::detail::action_registry::
                 instance().get_unassigned_typenames())
+#endif
         {}
 
         void save(hpx::serialization::output_archive& ar, unsigned) const
         {
             // part running on worker node
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
             HPX_ASSERT(!action_typenames.empty());
+#endif
             ar << serialization_typenames;
             ar << action_typenames;
         }
@@ -122,7 +140,9 @@ namespace hpx { namespace agas { namespace detail
 
         void save(hpx::serialization::output_archive& ar, unsigned) const
         {
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
             HPX_ASSERT(!action_ids.empty());
+#endif
             ar << serialization_ids;      // part running on locality 0
             ar << action_ids;
         }
@@ -155,6 +175,7 @@ namespace hpx { namespace agas { namespace detail
                     serialization_ids.push_back(id);
                 }
             }
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
             {
                 hpx::actions::detail::action_registry& registry =
                     hpx::actions::detail::action_registry::instance();
@@ -172,6 +193,7 @@ namespace hpx { namespace agas { namespace detail
                     action_ids.push_back(id);
                 }
             }
+#endif
         }
 
     public:
@@ -199,6 +221,7 @@ namespace hpx { namespace agas { namespace detail
                 // order problems
                 registry.fill_missing_typenames();
             }
+#if !defined(HPX_HAVE_STATIC_ACTION_IDS)
             {
                 hpx::actions::detail::action_registry& registry =
                     hpx::actions::detail::action_registry::instance();
@@ -221,6 +244,7 @@ namespace hpx { namespace agas { namespace detail
                 // order problems
                 registry.fill_missing_typenames();
             }
+#endif
         }
 
         std::vector<std::uint32_t> serialization_ids;
@@ -253,6 +277,9 @@ struct registration_header
       , symbol_ns_ptr(0)
       , cores_needed(0)
       , num_threads(0)
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+      , action_table_checksum(0)
+#endif
     {}
 
     // TODO: pass head address as a GVA
@@ -273,6 +300,10 @@ struct registration_header
       , hostname(hostname_)
       , typenames(typenames_)
       , prefix(prefix_)
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+      , action_table_checksum(hpx::actions::detail::action_registry::
+            instance().get_checksum())
+#endif
     {}
 
     parcelset::endpoints_type endpoints;
@@ -283,6 +314,9 @@ struct registration_header
     std::string hostname;           // hostname of locality
     detail::unassigned_typename_sequence typenames;
     naming::gid_type prefix;        // suggested prefix (optional)
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+    std::uint64_t action_table_checksum;
+#endif
 
     template <typename Archive>
     void serialize(Archive & ar, const unsigned int)
@@ -295,6 +329,9 @@ struct registration_header
         ar & hostname;
         ar & typenames;
         ar & prefix;
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+        ar & action_table_checksum;
+#endif
     }
 };
 
@@ -420,6 +457,21 @@ void register_worker(registration_header const& header)
           , "registration parcel received by non-bootstrap locality.");
     }
 
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+    if (header.action_table_checksum !=
+        hpx::actions::detail::action_registry::instance().get_checksum())
+    {
+        HPX_THROW_EXCEPTION(internal_server_error
+            , "agas::register_worker"
+            , boost::str(
+                boost::format("the action ids of worker node (%s) differ from "
+                "the ones of the console, all localities have to run the same "
+                "executable and load the same components") %
+                    header.endpoints));
+        return;
+    }
+#endif
+
     naming::gid_type prefix = header.prefix;
     if (prefix != naming::invalid_gid && naming::get_locality_id_from_gid(prefix) == 0)
     {
@@ -670,6 +722,11 @@ big_boot_barrier::big_boot_barrier(
   , connected(get_number_of_bootstrap_connections(ini_))
   , thunks(32)
 {
+#if defined(HPX_HAVE_STATIC_ACTION_IDS)
+    // all localities assign the action ids on their own
+    detail::assign_action_ids();
+#endif
+
     // register all not registered typenames
     if (service_type == service_mode_bootstrap)
         detail::register_unassigned_typenames();
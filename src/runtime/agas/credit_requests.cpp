@@ -0,0 +1,135 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/credit_requests.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/throw_exception.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace hpx { namespace agas
+{
+    namespace
+    {
+        // Variable length encoding of unsigned values, 7 bits per byte.
+        void encode_varint(std::vector<std::uint8_t>& data, std::uint64_t value)
+        {
+            while (value >= 0x80)
+            {
+                data.push_back(static_cast<std::uint8_t>(value | 0x80));
+                value >>= 7;
+            }
+            data.push_back(static_cast<std::uint8_t>(value));
+        }
+
+        std::uint64_t decode_varint(std::vector<std::uint8_t> const& data,
+            std::size_t& pos)
+        {
+            std::uint64_t value = 0;
+            for (std::size_t shift = 0; shift < 64; shift += 7)
+            {
+                if (pos == data.size())
+                    break;
+
+                std::uint8_t byte = data[pos++];
+                value |= std::uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                    return value;
+            }
+
+            HPX_THROW_EXCEPTION(serialization_error,
+                "credit_requests::decode",
+                "malformed credit request message");
+            return 0;
+        }
+
+        // Map signed values to unsigned ones such that values of small
+        // magnitude stay small.
+        std::uint64_t zigzag(std::int64_t value)
+        {
+            return (static_cast<std::uint64_t>(value) << 1) ^
+                static_cast<std::uint64_t>(value >> 63);
+        }
+
+        std::int64_t unzigzag(std::uint64_t value)
+        {
+            return static_cast<std::int64_t>(value >> 1) ^
+                -static_cast<std::int64_t>(value & 1);
+        }
+    }
+
+    // Each request is stored as the difference of the msb to the msb of the
+    // previous request, followed by the lsb (as a difference to the previous
+    // lsb if both msbs are equal), followed by the credit.
+    std::vector<std::uint8_t> credit_requests::encode() const
+    {
+        std::vector<value_type> requests(requests_);
+        std::sort(requests.begin(), requests.end(),
+            [](value_type const& lhs, value_type const& rhs)
+            {
+                return lhs.first < rhs.first;
+            });
+
+        std::vector<std::uint8_t> data;
+        data.reserve(4 * requests.size() + 8);
+
+        encode_varint(data, requests.size());
+
+        std::uint64_t msb = 0;
+        std::uint64_t lsb = 0;
+        for (value_type const& r : requests)
+        {
+            std::uint64_t const next_msb = r.first.get_msb();
+            std::uint64_t const next_lsb = r.first.get_lsb();
+
+            encode_varint(data, next_msb - msb);
+            encode_varint(data, next_msb == msb ? next_lsb - lsb : next_lsb);
+            encode_varint(data, zigzag(r.second));
+
+            msb = next_msb;
+            lsb = next_lsb;
+        }
+
+        return data;
+    }
+
+    void credit_requests::decode(std::vector<std::uint8_t> const& data)
+    {
+        std::size_t pos = 0;
+        std::uint64_t count = decode_varint(data, pos);
+
+        // every request needs at least three bytes
+        if (count > data.size() / 3)
+        {
+            HPX_THROW_EXCEPTION(serialization_error,
+                "credit_requests::decode",
+                "malformed credit request message");
+            return;
+        }
+
+        requests_.clear();
+        requests_.reserve(count);
+
+        std::uint64_t msb = 0;
+        std::uint64_t lsb = 0;
+        for (std::uint64_t i = 0; i != count; ++i)
+        {
+            std::uint64_t const msb_delta = decode_varint(data, pos);
+            std::uint64_t const lsb_value = decode_varint(data, pos);
+
+            lsb = msb_delta == 0 ? lsb + lsb_value : lsb_value;
+            msb += msb_delta;
+
+            requests_.push_back(value_type(naming::gid_type(msb, lsb),
+                unzigzag(decode_varint(data, pos))));
+        }
+    }
+}}
@@ -0,0 +1,571 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/shared_spinlock.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace agas
+{
+    namespace
+    {
+        typedef lcos::local::shared_spinlock mutex_type;
+
+        // number of shards ids are mapped to, has to be a power of two
+        // smaller than 64
+        const std::size_t num_shards = 32;
+        const std::uint64_t all_shards = (std::uint64_t(1) << num_shards) - 1;
+
+        // the additional shard holding the ranges spanning several groups
+        const std::size_t spanning_shard = num_shards;
+        const std::uint64_t spanning_shard_bit =
+            std::uint64_t(1) << spanning_shard;
+
+        // this many consecutive ids are stored in the same shard
+        const std::size_t granularity_bits = 4;
+
+        std::uint64_t mix_msb(std::uint64_t msb)
+        {
+            msb ^= msb >> 32;
+            return (msb * 0x9e3779b97f4a7c15ull) >> 32;
+        }
+
+        std::size_t shard_index(std::uint64_t mixed_msb, std::uint64_t lsb)
+        {
+            return static_cast<std::size_t>(
+                ((lsb >> granularity_bits) ^ mixed_msb) & (num_shards - 1));
+        }
+
+        std::size_t shard_index(naming::gid_type const& gid)
+        {
+            return shard_index(mix_msb(gid.get_msb()), gid.get_lsb());
+        }
+
+        // Lock the shard selected by 'exclusive' exclusively and all shards
+        // selected by the 'shared' mask in shared mode, always in the same
+        // order to avoid deadlocks.
+        template <typename Shard>
+        struct update_locks
+        {
+            update_locks(Shard* shards, std::size_t exclusive,
+                    std::uint64_t shared)
+              : shards_(shards), exclusive_(exclusive),
+                shared_(shared & ~(std::uint64_t(1) << exclusive))
+            {
+                for (std::size_t i = 0; i != num_shards + 1; ++i)
+                {
+                    if (i == exclusive_)
+                        shards_[i].mtx_.lock();
+                    else if (shared_ & (std::uint64_t(1) << i))
+                        shards_[i].mtx_.lock_shared();
+                }
+            }
+
+            ~update_locks()
+            {
+                for (std::size_t i = num_shards + 1; i != 0; --i)
+                {
+                    if (i - 1 == exclusive_)
+                        shards_[i - 1].mtx_.unlock();
+                    else if (shared_ & (std::uint64_t(1) << (i - 1)))
+                        shards_[i - 1].mtx_.unlock_shared();
+                }
+            }
+
+            Shard* shards_;
+            std::size_t exclusive_;
+            std::uint64_t shared_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct api_counter_data
+        {
+            api_counter_data()
+              : count_(0), time_(0)
+            {}
+
+            boost::atomic<std::int64_t> count_;
+            boost::atomic<std::int64_t> time_;
+        };
+
+        // Helper class to update timings and counts on function exit
+        struct update_on_exit
+        {
+            explicit update_on_exit(api_counter_data& data)
+              : started_at_(util::high_resolution_clock::now()),
+                data_(data)
+            {}
+
+            ~update_on_exit()
+            {
+                data_.time_.fetch_add(static_cast<std::int64_t>(
+                        util::high_resolution_clock::now() - started_at_),
+                    boost::memory_order_relaxed);
+                data_.count_.fetch_add(1, boost::memory_order_relaxed);
+            }
+
+            std::uint64_t started_at_;
+            api_counter_data& data_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct gva_cache::shard
+    {
+        struct entry
+        {
+            explicit entry(gva const& g)
+              : gva_(g), referenced_(true)
+            {}
+
+            gva gva_;
+
+            // set on every hit, cleared by the CLOCK hand
+            boost::atomic<bool> referenced_;
+        };
+
+        typedef std::map<key_type, entry> map_type;
+
+        shard()
+          : hand_(entries_.end()),
+            hits_(0), misses_(0), evictions_(0), insertions_(0)
+        {}
+
+        // The functions below need the exclusive lock to be held.
+        void insert(key_type const& key, gva const& g,
+            boost::atomic<size_type>& size, size_type max_size)
+        {
+            entries_.emplace(key, g);
+            ++size;
+
+            // only this shard is locked, it keeps at least the new entry
+            while (max_size != 0 && size.load() > max_size &&
+                entries_.size() > 1)
+            {
+                evict();
+                --size;
+            }
+        }
+
+        void evict()
+        {
+            HPX_ASSERT(!entries_.empty());
+            for (;;)
+            {
+                if (hand_ == entries_.end())
+                    hand_ = entries_.begin();
+
+                // give recently used entries a second chance
+                if (hand_->second.referenced_.exchange(
+                        false, boost::memory_order_relaxed))
+                {
+                    ++hand_;
+                    continue;
+                }
+
+                hand_ = entries_.erase(hand_);
+                ++evictions_;
+                return;
+            }
+        }
+
+        map_type::iterator erase(map_type::iterator it)
+        {
+            bool const at_hand = (it == hand_);
+            it = entries_.erase(it);
+            if (at_hand)
+                hand_ = it;
+            return it;
+        }
+
+        mutable mutex_type mtx_;
+
+        map_type entries_;
+        map_type::iterator hand_;
+
+        boost::atomic<std::int64_t> hits_;
+        boost::atomic<std::int64_t> misses_;
+        boost::atomic<std::int64_t> evictions_;
+        boost::atomic<std::int64_t> insertions_;
+
+        api_counter_data get_entry_;
+        api_counter_data insert_entry_;
+        api_counter_data update_entry_;
+        api_counter_data erase_entry_;
+
+        // keep the locks of neighboring shards in different cache lines
+        char padding_[64];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    gva_cache::gva_cache(size_type max_size)
+      : max_size_(0), size_(0), shards_(new shard[num_shards + 1])
+    {
+        reserve(max_size);
+    }
+
+    gva_cache::~gva_cache()
+    {
+    }
+
+    gva_cache::size_type gva_cache::size() const
+    {
+        return size_.load();
+    }
+
+    gva_cache::size_type gva_cache::capacity() const
+    {
+        return max_size_.load();
+    }
+
+    void gva_cache::reserve(size_type max_size)
+    {
+        max_size_.store(max_size);
+        if (max_size == 0)
+            return;
+
+        // shrink every shard towards its share of the new size
+        size_type const shard_size =
+            (max_size + num_shards) / (num_shards + 1);
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            while (size_.load() > max_size && s.entries_.size() > shard_size)
+            {
+                s.evict();
+                --size_;
+            }
+        }
+    }
+
+    // Return the shard holding the given range of ids.
+    std::size_t gva_cache::shard_for(key_type const& key) const
+    {
+        naming::gid_type const gid = key.get_gid();
+        std::uint64_t const first = gid.get_lsb();
+        std::uint64_t const last = first + (key.get_count() - 1);
+
+        if (last < first ||
+            (last >> granularity_bits) != (first >> granularity_bits))
+        {
+            return spanning_shard;
+        }
+        return shard_index(gid);
+    }
+
+    // Return the set of shards the ids of the given range map to.
+    std::uint64_t gva_cache::shards_for(key_type const& key) const
+    {
+        naming::gid_type const gid = key.get_gid();
+        std::uint64_t const first = gid.get_lsb();
+        std::uint64_t const last = first + (key.get_count() - 1);
+
+        if (last < first ||
+            (last >> granularity_bits) - (first >> granularity_bits) >=
+                num_shards)
+        {
+            return all_shards;
+        }
+
+        std::uint64_t const mixed_msb = mix_msb(gid.get_msb());
+
+        std::uint64_t mask = 0;
+        for (std::uint64_t lsb = first >> granularity_bits;
+             lsb <= (last >> granularity_bits); ++lsb)
+        {
+            mask |= std::uint64_t(1) <<
+                shard_index(mixed_msb, lsb << granularity_bits);
+        }
+        return mask;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool gva_cache::find_entry(shard& s, key_type const& key,
+        key_type& realkey, entry_type& entry)
+    {
+        boost::shared_lock<mutex_type> l(s.mtx_);
+
+        shard::map_type::iterator it = s.entries_.find(key);
+        if (it == s.entries_.end())
+            return false;
+
+        // avoid writing to the entry if it was referenced already
+        if (!it->second.referenced_.load(boost::memory_order_relaxed))
+            it->second.referenced_.store(true, boost::memory_order_relaxed);
+
+        realkey = it->first;
+        entry = it->second.gva_;
+        return true;
+    }
+
+    bool gva_cache::get_entry(key_type const& key, key_type& realkey,
+        entry_type& entry)
+    {
+        std::size_t const index = shard_for(key);
+
+        // statistics are kept by the shard holding the given range
+        shard& primary = shards_[index];
+        update_on_exit update(primary.get_entry_);
+
+        bool found = false;
+        if (index != spanning_shard)
+        {
+            found = find_entry(primary, key, realkey, entry) ||
+                find_entry(shards_[spanning_shard], key, realkey, entry);
+        }
+        else
+        {
+            // a range spanning several groups may overlap with entries in
+            // any of the shards its ids map to
+            found = find_entry(primary, key, realkey, entry);
+
+            std::uint64_t const mask = shards_for(key);
+            for (std::size_t i = 0; !found && i != num_shards; ++i)
+            {
+                if (mask & (std::uint64_t(1) << i))
+                    found = find_entry(shards_[i], key, realkey, entry);
+            }
+        }
+
+        if (!found)
+        {
+            ++primary.misses_;
+            return false;
+        }
+
+        ++primary.hits_;
+        return true;
+    }
+
+    bool gva_cache::update_if(key_type const& key, entry_type const& entry,
+        collision_function_type const& f)
+    {
+        std::size_t const index = shard_for(key);
+
+        shard& target = shards_[index];
+        update_on_exit update(target.update_entry_);
+
+        // Overlapping entries may be held by the shard of the range's group
+        // and by the shard of the spanning ranges.
+        std::uint64_t const mask = (index == spanning_shard) ?
+            (shards_for(key) | spanning_shard_bit) :
+            ((std::uint64_t(1) << index) | spanning_shard_bit);
+        update_locks<shard> l(shards_.get(), index, mask);
+
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            if (!(mask & (std::uint64_t(1) << i)))
+                continue;
+
+            shard::map_type::iterator it = shards_[i].entries_.find(key);
+            if (it != shards_[i].entries_.end() && f(key, it->first))
+                return false;
+        }
+
+        shard::map_type::iterator it = target.entries_.find(key);
+        if (it == target.entries_.end())
+        {
+            ++target.misses_;
+            ++target.insertions_;
+
+            update_on_exit update_insert(target.insert_entry_);
+            target.insert(key, entry, size_, max_size_.load());
+        }
+        else
+        {
+            ++target.hits_;
+
+            it->second.gva_ = entry;
+            it->second.referenced_.store(true, boost::memory_order_relaxed);
+        }
+
+        return true;
+    }
+
+    gva_cache::size_type gva_cache::erase(erase_function_type const& ep)
+    {
+        // erasing visits all shards, it is accounted for by the first one
+        update_on_exit update(shards_[0].erase_entry_);
+
+        size_type erased = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            for (shard::map_type::iterator it = s.entries_.begin();
+                 it != s.entries_.end(); /**/)
+            {
+                if (ep(entry_pair(it->first, it->second.gva_)))
+                {
+                    it = s.erase(it);
+                    --size_;
+                    ++erased;
+                    ++s.evictions_;
+                }
+                else
+                {
+                    ++it;
+                }
+            }
+        }
+        return erased;
+    }
+
+    gva_cache::size_type gva_cache::clear()
+    {
+        size_type erased = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> l(s.mtx_);
+
+            size_ -= s.entries_.size();
+            erased += s.entries_.size();
+            s.entries_.clear();
+            s.hand_ = s.entries_.end();
+        }
+        return erased;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t gva_cache::hits(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+            result += util::get_and_reset_value(shards_[i].hits_, reset);
+        return result;
+    }
+
+    std::int64_t gva_cache::misses(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+            result += util::get_and_reset_value(shards_[i].misses_, reset);
+        return result;
+    }
+
+    std::int64_t gva_cache::evictions(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+            result += util::get_and_reset_value(shards_[i].evictions_, reset);
+        return result;
+    }
+
+    std::int64_t gva_cache::insertions(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+            result += util::get_and_reset_value(shards_[i].insertions_, reset);
+        return result;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::int64_t gva_cache::get_get_entry_count(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].get_entry_.count_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_insert_entry_count(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].insert_entry_.count_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_update_entry_count(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].update_entry_.count_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_erase_entry_count(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].erase_entry_.count_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_get_entry_time(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].get_entry_.time_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_insert_entry_time(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].insert_entry_.time_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_update_entry_time(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].update_entry_.time_, reset);
+        }
+        return result;
+    }
+
+    std::int64_t gva_cache::get_erase_entry_time(bool reset)
+    {
+        std::int64_t result = 0;
+        for (std::size_t i = 0; i != num_shards + 1; ++i)
+        {
+            result += util::get_and_reset_value(
+                shards_[i].erase_entry_.time_, reset);
+        }
+        return result;
+    }
+}}
@@ -248,6 +248,14 @@ naming::address resolve(
     return agas_.resolve_async(id).get(ec);
 }
 
+hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_bulk(ids);
+}
+
 hpx::future<bool> bind(
     naming::gid_type const& gid
   , naming::address const& addr
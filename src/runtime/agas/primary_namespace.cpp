@@ -15,6 +15,7 @@
 #include <hpx/runtime/applier/apply_callback.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
 #include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/assert.hpp>
 
 #include <boost/format.hpp>
 
@@ -43,6 +44,11 @@ HPX_REGISTER_ACTION_ID(
     primary_namespace_bind_gid_action,
     hpx::actions::primary_namespace_bind_gid_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    primary_namespace::bind_gids_action,
+    primary_namespace_bind_gids_action,
+    hpx::actions::primary_namespace_bind_gids_action_id)
+
 HPX_REGISTER_ACTION_ID(
     primary_namespace::begin_migration_action,
     primary_namespace_begin_migration_action,
@@ -68,6 +74,11 @@ HPX_REGISTER_ACTION_ID(
     primary_namespace_resolve_gid_action,
     hpx::actions::primary_namespace_resolve_gid_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    primary_namespace::resolve_gids_action,
+    primary_namespace_resolve_gids_action,
+    hpx::actions::primary_namespace_resolve_gids_action_id)
+
 HPX_REGISTER_ACTION_ID(
     primary_namespace::colocate_action,
     primary_namespace_colocate_action,
@@ -78,6 +89,11 @@ HPX_REGISTER_ACTION_ID(
     primary_namespace_unbind_gid_action,
     hpx::actions::primary_namespace_unbind_gid_action_id)
 
+HPX_REGISTER_ACTION_ID(
+    primary_namespace::update_credits_action,
+    primary_namespace_update_credits_action,
+    hpx::actions::primary_namespace_update_credits_action_id)
+
 HPX_REGISTER_ACTION_ID(
     primary_namespace::route_action,
     primary_namespace_route_action,
@@ -96,6 +112,10 @@ HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
     gva_tuple_type, gva_tuple,
     hpx::actions::base_lco_with_value_gva_tuple_get,
     hpx::actions::base_lco_with_value_gva_tuple_set)
+HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
+    vector_gva_tuple_type, vector_gva_tuple,
+    hpx::actions::base_lco_with_value_vector_gva_tuple_get,
+    hpx::actions::base_lco_with_value_vector_gva_tuple_set)
 HPX_REGISTER_BASE_LCO_WITH_VALUE_ID(
     std_pair_address_id_type, std_pair_address_id_type,
     hpx::actions::base_lco_with_value_std_pair_address_id_type_get,
@@ -212,6 +232,22 @@ namespace hpx { namespace agas {
         return hpx::async(action, std::move(dest), g, id, locality);
     }
 
+    future<void> primary_namespace::bind_gid_async(std::vector<gva> gvas,
+        std::vector<naming::gid_type> ids, naming::gid_type locality)
+    {
+        HPX_ASSERT(!ids.empty());
+        naming::id_type dest = naming::id_type(get_service_instance(ids[0]),
+            naming::id_type::unmanaged);
+        if (naming::get_locality_from_gid(dest.get_gid()) == hpx::get_locality())
+        {
+            server_->bind_gids(std::move(gvas), std::move(ids), locality);
+            return hpx::make_ready_future();
+        }
+        server::primary_namespace::bind_gids_action action;
+        return hpx::async(action, std::move(dest), std::move(gvas),
+            std::move(ids), locality);
+    }
+
     void primary_namespace::route(parcelset::parcel && p,
         util::function_nonser<void(boost::system::error_code const&,
         parcelset::parcel const&)> && f)
@@ -254,6 +290,20 @@ namespace hpx { namespace agas {
         return hpx::async(action, std::move(dest), id);
     }
 
+    future<std::vector<primary_namespace::resolved_type> >
+    primary_namespace::resolve_full(std::vector<naming::gid_type> ids)
+    {
+        HPX_ASSERT(!ids.empty());
+        naming::id_type dest = naming::id_type(get_service_instance(ids[0]),
+            naming::id_type::unmanaged);
+        if (naming::get_locality_from_gid(dest.get_gid()) == hpx::get_locality())
+        {
+            return hpx::make_ready_future(server_->resolve_gids(std::move(ids)));
+        }
+        server::primary_namespace::resolve_gids_action action;
+        return hpx::async(action, std::move(dest), std::move(ids));
+    }
+
     hpx::future<id_type> primary_namespace::colocate(naming::gid_type id)
     {
         naming::id_type dest = naming::id_type(get_service_instance(id),
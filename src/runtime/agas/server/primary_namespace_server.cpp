@@ -32,6 +32,7 @@
 
 #include <boost/atomic.hpp>
 #include <boost/format.hpp>
+#include <boost/thread/locks.hpp>
 
 #include <cstddef>
 #include <cstdint>
@@ -60,6 +61,98 @@ naming::id_type bootstrap_primary_namespace_id()
 namespace server
 {
 
+namespace
+{
+    // this many consecutive ids are stored in the same GVA table stripe
+    const std::size_t gva_granularity_bits = 4;
+
+    std::uint64_t mix_msb(std::uint64_t msb)
+    {
+        msb ^= msb >> 32;
+        return (msb * 0x9e3779b97f4a7c15ull) >> 32;
+    }
+
+    std::size_t gva_stripe_index(std::uint64_t mixed_msb, std::uint64_t lsb)
+    {
+        return static_cast<std::size_t>(
+            ((lsb >> gva_granularity_bits) ^ mixed_msb) &
+                (primary_namespace::num_gva_stripes - 1));
+    }
+
+    std::size_t gva_stripe_index(naming::gid_type const& id)
+    {
+        return gva_stripe_index(mix_msb(id.get_msb()), id.get_lsb());
+    }
+
+    std::size_t refcnt_stripe_index(naming::gid_type const& id)
+    {
+        return static_cast<std::size_t>((id.get_lsb() ^ mix_msb(id.get_msb())) &
+            (primary_namespace::num_refcnt_stripes - 1));
+    }
+
+    // Lock all stripes selected by the given mask, always in the same order
+    // to avoid deadlocks.
+    template <typename Stripe>
+    struct stripe_locks
+    {
+        stripe_locks(Stripe* stripes, std::uint64_t mask)
+          : stripes_(stripes), mask_(mask)
+        {
+            for (std::size_t i = 0; i != primary_namespace::num_gva_stripes; ++i)
+            {
+                if (mask_ & (std::uint64_t(1) << i))
+                    stripes_[i].mtx_.lock();
+            }
+        }
+
+        ~stripe_locks()
+        {
+            unlock();
+        }
+
+        void unlock()
+        {
+            for (std::size_t i = primary_namespace::num_gva_stripes; i != 0; --i)
+            {
+                if (mask_ & (std::uint64_t(1) << (i - 1)))
+                    stripes_[i - 1].mtx_.unlock();
+            }
+            mask_ = 0;
+        }
+
+        Stripe* stripes_;
+        std::uint64_t mask_;
+    };
+}
+
+std::uint64_t primary_namespace::gva_stripes_for(
+    naming::gid_type const& id
+  , std::uint64_t count
+    )
+{
+    // The entry for a locality's RTS component has a count of 0
+    std::uint64_t const first = id.get_lsb();
+    std::uint64_t const last = first + (count ? count - 1 : 0);
+
+    if (last < first ||
+        (last >> gva_granularity_bits) - (first >> gva_granularity_bits) >=
+            num_gva_stripes)
+    {
+        return (std::uint64_t(1) << num_gva_stripes) - 1;
+    }
+
+    std::uint64_t const mixed_msb = mix_msb(id.get_msb());
+
+    std::uint64_t mask = 0;
+    for (std::uint64_t lsb = first >> gva_granularity_bits;
+         lsb <= (last >> gva_granularity_bits); ++lsb)
+    {
+        mask |= std::uint64_t(1) <<
+            gva_stripe_index(mixed_msb, lsb << gva_granularity_bits);
+    }
+    return mask;
+}
+
 // register all performance counter types exposed by this component
 void primary_namespace::register_counter_types(
     error_code& ec
@@ -233,7 +326,7 @@ primary_namespace::begin_migration(naming::gid_type id)
 
     std::unique_lock<mutex_type> l(mutex_);
 
-    resolved_type r = resolve_gid_locked(l, id, hpx::throws);
+    resolved_type r = resolve_gid_impl(id, hpx::throws);
     if (get<0>(r) == naming::invalid_gid)
     {
         l.unlock();
@@ -256,7 +349,11 @@ primary_namespace::begin_migration(naming::gid_type id)
     }
 
     // flag this id as being migrated
-    hpx::util::get<0>(it->second) = true; //-V601
+    if (!hpx::util::get<0>(it->second))
+    {
+        hpx::util::get<0>(it->second) = true; //-V601
+        ++migrating_count_;
+    }
 
     gva const& g(hpx::util::get<1>(r));
     naming::address addr(g.prefix, g.type, g.lva());
@@ -288,6 +385,7 @@ bool primary_namespace::end_migration(naming::gid_type id)
 
     // flag this id as not being migrated anymore
     get<0>(it->second) = false;
+    --migrating_count_;
 
     return true;
 }
@@ -314,6 +412,32 @@ void primary_namespace::wait_for_migration_locked(
     }
 }
 
+primary_namespace::resolved_type
+primary_namespace::resolve_gid_after_migration(
+    naming::gid_type id
+  , error_code& ec)
+{
+    // Avoid taking the lock if no object is being migrated. A migration
+    // which has begun while resolving could have been missed, in this case
+    // resolve again while holding the lock.
+    if (migrating_count_.load(boost::memory_order_acquire) == 0)
+    {
+        resolved_type r = resolve_gid_impl(id, ec);
+        if (migrating_count_.load() == 0)
+            return r;
+
+        if (&ec != &throws)
+            ec = make_success_code();
+    }
+
+    std::unique_lock<mutex_type> l(mutex_);
+    wait_for_migration_locked(l, id, ec);
+    if (ec)
+        return resolved_type(naming::invalid_gid, gva(), naming::invalid_gid);
+
+    return resolve_gid_impl(id, ec);
+}
+
 bool primary_namespace::bind_gid(
     gva g
   , naming::gid_type id
@@ -328,11 +452,16 @@ bool primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    // An existing binding for this id has to have the same count, so it is
+    // stored in the same stripes.
+    std::uint64_t const stripes = gva_stripes_for(id, g.count);
+    stripe_locks<gva_table_stripe> l(gva_stripes_, stripes);
+
+    gva_table_type& gvas = gva_stripes_[gva_stripe_index(id)].gvas_;
 
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    gva_table_type::iterator it = gvas.lower_bound(id)
+                           , begin = gvas.begin()
+                           , end = gvas.end();
 
     if (it != end)
     {
@@ -340,8 +469,7 @@ bool primary_namespace::bind_gid(
         // binding (e.g. move semantics).
         if (it->first == id)
         {
-            gva& gaddr = it->second.first;
-            naming::gid_type& loc = it->second.second;
+            gva const& gaddr = it->second.first;
 
             // Check for count mismatch (we can't change block sizes of
             // existing bindings).
@@ -379,12 +507,22 @@ bool primary_namespace::bind_gid(
                         % id % g % locality));
             }
 
-            // Store the new endpoint and offset
-            gaddr.prefix = g.prefix;
-            gaddr.type   = g.type;
-            gaddr.lva(g.lva());
-            gaddr.offset = g.offset;
-            loc = locality;
+            // Store the new endpoint and offset in all stripes
+            for (std::size_t i = 0; i != num_gva_stripes; ++i)
+            {
+                if (!(stripes & (std::uint64_t(1) << i)))
+                    continue;
+
+                gva_table_type::iterator jt = gva_stripes_[i].gvas_.find(id);
+                HPX_ASSERT(jt != gva_stripes_[i].gvas_.end());
+
+                gva& stored = jt->second.first;
+                stored.prefix = g.prefix;
+                stored.type   = g.type;
+                stored.lva(g.lva());
+                stored.offset = g.offset;
+                jt->second.second = locality;
+            }
 
             l.unlock();
 
@@ -415,7 +553,7 @@ bool primary_namespace::bind_gid(
         }
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    else if (HPX_LIKELY(!gvas.empty()))
     {
         --it;
 
@@ -454,18 +592,24 @@ bool primary_namespace::bind_gid(
                 % id % g % locality));
     }
 
-    // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
-            std::make_pair(id, std::make_pair(g, locality))))))
+    // Insert a GID -> GVA entry into all stripes of the GVA table.
+    for (std::size_t i = 0; i != num_gva_stripes; ++i)
     {
-        l.unlock();
+        if (!(stripes & (std::uint64_t(1) << i)))
+            continue;
 
-        HPX_THROW_EXCEPTION(lock_error
-          , "primary_namespace::bind_gid"
-          , boost::str(boost::format(
-                "GVA table insertion failed due to a locking error or "
-                "memory corruption, gid(%1%), gva(%2%)")
-                % id % g % locality));
+        if (HPX_UNLIKELY(!util::insert_checked(gva_stripes_[i].gvas_.insert(
+                std::make_pair(id, std::make_pair(g, locality))))))
+        {
+            l.unlock();
+
+            HPX_THROW_EXCEPTION(lock_error
+              , "primary_namespace::bind_gid"
+              , boost::str(boost::format(
+                    "GVA table insertion failed due to a locking error or "
+                    "memory corruption, gid(%1%), gva(%2%)")
+                    % id % g % locality));
+        }
     }
 
     l.unlock();
@@ -477,6 +621,25 @@ bool primary_namespace::bind_gid(
     return true;
 } // }}}
 
+void primary_namespace::bind_gids(
+    std::vector<gva> gvas
+  , std::vector<naming::gid_type> ids
+  , naming::gid_type locality
+    )
+{ // {{{ bind_gids implementation
+    if (HPX_UNLIKELY(gvas.size() != ids.size()))
+    {
+        HPX_THROW_EXCEPTION(bad_parameter
+          , "primary_namespace::bind_gids"
+          , boost::str(boost::format(
+                "number of GVAs (%1%) does not match number of ids (%2%)")
+                % gvas.size() % ids.size()));
+    }
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+        bind_gid(gvas[i], ids[i], locality);
+} // }}}
+
 primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type id)
 { // {{{ resolve_gid implementation
     util::scoped_timer<boost::atomic<std::int64_t> > update(
@@ -485,17 +648,8 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
     counter_data_.increment_resolve_gid_count();
     using hpx::util::get;
 
-    resolved_type r;
-
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
-        // wait for any migration to be completed
-        wait_for_migration_locked(l, id, hpx::throws);
-
-        // now, resolve the id
-        r = resolve_gid_locked(l, id, hpx::throws);
-    }
+    // wait for any migration to be completed, then resolve the id
+    resolved_type r = resolve_gid_after_migration(id, hpx::throws);
 
     if (get<0>(r) == naming::invalid_gid)
     {
@@ -514,6 +668,19 @@ primary_namespace::resolved_type primary_namespace::resolve_gid(naming::gid_type
     return r;
 } // }}}
 
+std::vector<primary_namespace::resolved_type> primary_namespace::resolve_gids(
+    std::vector<naming::gid_type> ids
+    )
+{ // {{{ resolve_gids implementation
+    std::vector<resolved_type> result;
+    result.reserve(ids.size());
+
+    for (naming::gid_type const& id : ids)
+        result.push_back(resolve_gid(id));
+
+    return result;
+} // }}}
+
 naming::id_type primary_namespace::colocate(naming::gid_type id)
 {
     return naming::id_type(
@@ -532,10 +699,13 @@ naming::address primary_namespace::unbind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    std::uint64_t const stripes = gva_stripes_for(id, count);
+    stripe_locks<gva_table_stripe> l(gva_stripes_, stripes);
+
+    gva_table_type& gvas = gva_stripes_[gva_stripe_index(id)].gvas_;
 
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    gva_table_type::iterator it = gvas.find(id)
+                           , end = gvas.end();
 
     if (it != end)
     {
@@ -550,7 +720,12 @@ naming::address primary_namespace::unbind_gid(
 
         gva_table_data_type data = it->second;
 
-        gvas_.erase(it);
+        // remove the entry from all stripes
+        for (std::size_t i = 0; i != num_gva_stripes; ++i)
+        {
+            if (stripes & (std::uint64_t(1) << i))
+                gva_stripes_[i].gvas_.erase(id);
+        }
 
         l.unlock();
         LAGAS_(info) << (boost::format(
@@ -652,6 +827,29 @@ std::vector<std::int64_t> primary_namespace::decrement_credit(
     return res_credits;
 }
 
+void primary_namespace::update_credits(
+    credit_requests requests
+    )
+{ // update_credits implementation
+    // All increments have to be applied first, otherwise a decrement which
+    // was issued after an increment of the same id could free the object.
+    std::vector<
+        hpx::util::tuple<std::int64_t, naming::gid_type, naming::gid_type>
+    > decrements;
+
+    for (credit_requests::value_type const& req : requests)
+    {
+        if (req.second > 0)
+            increment_credit(req.second, req.first, req.first);
+        else
+            decrements.push_back(
+                hpx::util::make_tuple(req.second, req.first, req.first));
+    }
+
+    if (!decrements.empty())
+        decrement_credit(std::move(decrements));
+}
+
 std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
     std::uint64_t count
     )
@@ -717,37 +915,40 @@ std::pair<naming::gid_type, naming::gid_type> primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         ss << (boost::format(
               "%1%, dumping server-side refcnt table matches, lower(%2%), "
               "upper(%3%):")
               % func_name % lower % upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        bool found = false;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            refcnt_table_stripe& stripe =
+                refcnt_stripes_[refcnt_stripe_index(raw)];
+            std::lock_guard<mutex_type> l(stripe.mtx_);
+
+            refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+            if (it == stripe.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             ss << (boost::format(
                    "\n  [server] lower(%1%), credits(%2%)")
-                   % lower_it->first
-                   % lower_it->second);
+                   % it->first
+                   % it->second);
+            found = true;
         }
 
-        LAGAS_(debug) << ss.str();
+        // We got nothing, bail - our caller is probably about to throw.
+        if (found)
+            LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
 
@@ -759,28 +960,10 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -796,14 +979,18 @@ void primary_namespace::increment(
 
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        refcnt_table_stripe& stripe = refcnt_stripes_[refcnt_stripe_index(raw)];
+        std::unique_lock<mutex_type> l(stripe.mtx_);
+
+        refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+        if (it == stripe.refcnts_.end())
         {
             std::int64_t count =
                 std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
             std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                stripe.refcnts_.insert(
+                    refcnt_table_type::value_type(raw, count));
             if (!p.second)
             {
                 l.unlock();
@@ -835,39 +1022,24 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+    std::list<naming::gid_type> const& free_list
   , std::list<free_entry>& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
   , error_code& ec
     )
 {
-    HPX_ASSERT_OWNS_LOCK(l);
-
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
-
-        // wait for any migration to be completed
-        wait_for_migration_locked(l, gid, ec);
-
-        // Resolve the query GID.
-        resolved_type r = resolve_gid_locked(l, gid, ec);
+        // Wait for any migration to be completed and resolve the query GID.
+        resolved_type r = resolve_gid_after_migration(gid, ec);
         if (ec) return;
 
         naming::gid_type& raw = get<0>(r);
         if (raw == naming::invalid_gid)
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , boost::str(boost::format(
@@ -883,8 +1055,6 @@ void primary_namespace::resolve_free_list(
         // REVIEW: Should we do more to make sure the GVA is valid?
         if (HPX_UNLIKELY(components::component_invalid == g.type))
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , boost::str(boost::format(
@@ -895,8 +1065,6 @@ void primary_namespace::resolve_free_list(
         }
         else if (HPX_UNLIKELY(0 == g.count))
         {
-            l.unlock();
-
             HPX_THROWS_IF(ec, internal_server_error
                 , "primary_namespace::resolve_free_list"
                 , boost::str(boost::format(
@@ -911,15 +1079,34 @@ void primary_namespace::resolve_free_list(
             "gid(%1%), gva(%2%)")
             % gid % g);
 
+        // Remove this entry from the refcnt table. The stripe was unlocked
+        // after the credits were decremented to zero: if they were
+        // incremented again in the meantime the component is still alive,
+        // if the entry is gone it has been handed to another free list.
+        // Destroy the component only if we remove the entry.
+        {
+            refcnt_table_stripe& stripe =
+                refcnt_stripes_[refcnt_stripe_index(gid)];
+            std::lock_guard<mutex_type> l(stripe.mtx_);
+
+            refcnt_table_type::iterator it = stripe.refcnts_.find(gid);
+            if (it == stripe.refcnts_.end() || it->second != 0)
+            {
+                LAGAS_(info) << (boost::format(
+                    "primary_namespace::resolve_free_list, credits changed "
+                    "concurrently, not freeing gid(%1%)")
+                    % gid);
+                continue;
+            }
+            stripe.refcnts_.erase(it);
+        }
+
         // Fully resolve the range.
         gva const resolved = g.resolve(gid, raw);
 
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
     }
 }
 
@@ -939,109 +1126,93 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+    if (LAGAS_ENABLED(debug))
+    {
+        dump_refcnt_matches(lower, upper, "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
 
-        std::list<refcnt_table_type::iterator> free_list;
-        for (naming::gid_type raw = lower; raw != upper; ++raw)
+    std::list<naming::gid_type> free_list;
+    for (naming::gid_type raw = lower; raw != upper; ++raw)
+    {
+        refcnt_table_stripe& stripe = refcnt_stripes_[refcnt_stripe_index(raw)];
+        std::unique_lock<mutex_type> l(stripe.mtx_);
+
+        refcnt_table_type::iterator it = stripe.refcnts_.find(raw);
+        if (it == stripe.refcnts_.end())
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
             {
-                if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , boost::str(boost::format(
-                            "negative entry in reference count table, raw(%1%), "
-                            "refcount(%2%)")
-                            % raw
-                            % (std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits)));
-                    return;
-                }
-
-                std::int64_t count =
-                    std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
-
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, invalid_data
-                      , "primary_namespace::decrement_sweep"
-                      , boost::str(boost::format(
-                            "couldn't create entry in reference count table, "
-                            "raw(%1%), ref-count(%3%)")
-                            % raw % count));
-                    return;
-                }
+                l.unlock();
 
-                it = p.first;
-            }
-            else
-            {
-                it->second -= credits;
+                HPX_THROWS_IF(ec, invalid_data
+                  , "primary_namespace::decrement_sweep"
+                  , boost::str(boost::format(
+                        "negative entry in reference count table, raw(%1%), "
+                        "refcount(%2%)")
+                        % raw
+                        % (std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits)));
+                return;
             }
 
-            // Sanity check.
-            if (it->second < 0)
+            std::int64_t count =
+                std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
+
+            std::pair<refcnt_table_type::iterator, bool> p =
+                stripe.refcnts_.insert(
+                    refcnt_table_type::value_type(raw, count));
+            if (!p.second)
             {
                 l.unlock();
 
                 HPX_THROWS_IF(ec, invalid_data
                   , "primary_namespace::decrement_sweep"
                   , boost::str(boost::format(
-                        "negative entry in reference count table, raw(%1%), "
-                        "refcount(%2%)")
-                        % raw % it->second));
+                        "couldn't create entry in reference count table, "
+                        "raw(%1%), ref-count(%3%)")
+                        % raw % count));
                 return;
             }
 
-            // this objects needs to be deleted
-            if (it->second == 0)
-                free_list.push_back(it);
+            it = p.first;
+        }
+        else
+        {
+            it->second -= credits;
+        }
+
+        // Sanity check.
+        if (it->second < 0)
+        {
+            std::int64_t const count = it->second;
+            l.unlock();
+
+            HPX_THROWS_IF(ec, invalid_data
+              , "primary_namespace::decrement_sweep"
+              , boost::str(boost::format(
+                    "negative entry in reference count table, raw(%1%), "
+                    "refcount(%2%)")
+                    % raw % count));
+            return;
         }
 
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
+        // this objects needs to be deleted
+        if (it->second == 0)
+            free_list.push_back(raw);
+    }
 
-    } // Unlock the mutex.
+    // Resolve the objects which have to be deleted.
+    resolve_free_list(free_list, free_entry_list, lower, upper, ec);
 
     if (&ec != &throws)
         ec = make_success_code();
@@ -1108,21 +1279,23 @@ void primary_namespace::free_components_sync(
         ec = make_success_code();
 } // }}}
 
-primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
-    std::unique_lock<mutex_type>& l
-  , naming::gid_type const& gid
+primary_namespace::resolved_type primary_namespace::resolve_gid_impl(
+    naming::gid_type const& gid
   , error_code& ec
     )
-{ // {{{ resolve_gid_locked implementation
-    HPX_ASSERT_OWNS_LOCK(l);
-
+{ // {{{ resolve_gid_impl implementation
     // parameters
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
+    // any range containing the id is stored in the stripe of the id itself
+    gva_table_stripe& stripe = gva_stripes_[gva_stripe_index(id)];
+    boost::shared_lock<gva_table_mutex_type> l(stripe.mtx_);
+
+    gva_table_type const& gvas = stripe.gvas_;
+    gva_table_type::const_iterator it = gvas.lower_bound(id)
+                                 , begin = gvas.begin()
+                                 , end = gvas.end();
 
     if (it != end)
     {
@@ -1151,7 +1324,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
                     l.unlock();
 
                     HPX_THROWS_IF(ec, internal_server_error
-                      , "primary_namespace::resolve_gid_locked"
+                      , "primary_namespace::resolve_gid_impl"
                       , "MSBs of lower and upper range bound do not match");
                     return resolved_type(naming::invalid_gid, gva(),
                         naming::invalid_gid);
@@ -1165,7 +1338,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
         }
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    else if (HPX_LIKELY(!gvas.empty()))
     {
         --it;
 
@@ -1178,7 +1351,7 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
                 l.unlock();
 
                 HPX_THROWS_IF(ec, internal_server_error
-                  , "primary_namespace::resolve_gid_locked"
+                  , "primary_namespace::resolve_gid_impl"
                   , "MSBs of lower and upper range bound do not match");
                 return resolved_type(naming::invalid_gid, gva(),
                     naming::invalid_gid);
@@ -252,6 +252,55 @@ namespace hpx { namespace applier
         app->get_thread_manager().register_work(data, state, ec);
     }
 
+    void register_work_bulk(
+        std::vector<threads::thread_init_data>& data,
+        threads::thread_state_enum state, error_code& ec)
+    {
+        hpx::applier::applier* app = hpx::applier::get_applier_ptr();
+        if (nullptr == app)
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "hpx::applier::register_work_bulk",
+                "global applier object is not accessible");
+            return;
+        }
+
+        app->get_thread_manager().register_work_bulk(data, state, ec);
+    }
+
+    void register_work_nullary_bulk(
+        std::vector<util::unique_function_nonser<void()> > && funcs,
+        util::thread_description const& desc,
+        threads::thread_state_enum state, threads::thread_priority priority,
+        threads::thread_stacksize stacksize, error_code& ec)
+    {
+        hpx::applier::applier* app = hpx::applier::get_applier_ptr();
+        if (nullptr == app)
+        {
+            HPX_THROWS_IF(ec, invalid_status,
+                "hpx::applier::register_work_nullary_bulk",
+                "global applier object is not accessible");
+            return;
+        }
+
+        std::ptrdiff_t stack_size = threads::get_stack_size(stacksize);
+
+        std::vector<threads::thread_init_data> data;
+        data.reserve(funcs.size());
+        for (util::unique_function_nonser<void()>& func : funcs)
+        {
+            util::thread_description d = desc ? desc :
+                util::thread_description(func, "register_work_nullary_bulk");
+
+            data.emplace_back(
+                util::bind(util::one_shot(&thread_function_nullary),
+                    std::move(func)),
+                d, 0, priority, std::size_t(-1), stack_size);
+        }
+
+        app->get_thread_manager().register_work_bulk(data, state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::util::thread_specific_ptr<applier*, applier::tls_tag> applier::applier_;
 
@@ -13,6 +13,7 @@
 #include <map>
 #include <mutex>
 #include <string>
+#include <vector>
 
 namespace hpx { namespace parcelset { namespace detail
 {
@@ -22,7 +23,17 @@ namespace hpx { namespace parcelset { namespace detail
         performance_counters::parcels::data_point const& data)
     {
         std::lock_guard<mutex_type> l(mtx_);
-        data_[std::string(action)].add_data(data);
+        action_data& d = data_[std::string(action)];
+        d.data_.add_data(data);
+        d.bytes_.add(static_cast<std::int64_t>(data.bytes_));
+        d.serialization_time_.add(data.serialization_time_);
+    }
+
+    void per_action_data_counter::add_queue_time(
+        char const* action, std::int64_t time)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        data_[std::string(action)].queue_time_.add(time);
     }
 
     // retrieve counter data
@@ -32,7 +43,7 @@ namespace hpx { namespace parcelset { namespace detail
         std::string const& action, bool reset)
     {
         std::lock_guard<mutex_type> l(mtx_);
-        return data_[action].num_parcels(reset);
+        return data_[action].data_.num_parcels(reset);
     }
 
     // the total time serialization took (nanoseconds)
@@ -40,7 +51,7 @@ namespace hpx { namespace parcelset { namespace detail
         std::string const& action, bool reset)
     {
         std::lock_guard<mutex_type> l(mtx_);
-        return data_[action].total_serialization_time(reset);
+        return data_[action].data_.total_serialization_time(reset);
     }
 
     // total data managed (bytes)
@@ -48,7 +59,47 @@ namespace hpx { namespace parcelset { namespace detail
         std::string const& action, bool reset)
     {
         std::lock_guard<mutex_type> l(mtx_);
-        return data_[action].total_bytes(reset);
+        return data_[action].data_.total_bytes(reset);
+    }
+
+    // histograms
+    std::vector<std::int64_t> per_action_data_counter::bytes_histogram(
+        std::string const& action, bool reset)
+    {
+        return get_histogram(action, &action_data::bytes_, reset);
+    }
+
+    std::vector<std::int64_t>
+        per_action_data_counter::serialization_time_histogram(
+            std::string const& action, bool reset)
+    {
+        return get_histogram(action, &action_data::serialization_time_, reset);
+    }
+
+    std::vector<std::int64_t> per_action_data_counter::queue_time_histogram(
+        std::string const& action, bool reset)
+    {
+        return get_histogram(action, &action_data::queue_time_, reset);
+    }
+
+    std::vector<std::int64_t> per_action_data_counter::get_histogram(
+        std::string const& action, histogram_type action_data::* histogram,
+        bool reset)
+    {
+        std::lock_guard<mutex_type> l(mtx_);
+        if (!action.empty())
+            return (data_[action].*histogram).get(reset);
+
+        // combine the data collected for all actions
+        histogram_type result;
+        for (counter_data_map::value_type& d : data_)
+        {
+            histogram_type& h = d.second.*histogram;
+            result.merge(h);
+            if (reset)
+                h.clear();
+        }
+        return result.get(false);
     }
 }}}
 
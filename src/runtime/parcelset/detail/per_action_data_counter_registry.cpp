@@ -15,6 +15,7 @@
 #include <string>
 #include <unordered_set>
 #include <utility>
+#include <vector>
 
 #include <boost/format.hpp>
 #include <boost/regex.hpp>
@@ -61,6 +62,24 @@ namespace hpx { namespace parcelset { namespace detail
         return util::bind(f, name, util::placeholders::_1);
     }
 
+    per_action_data_counter_registry::counter_values_function_type
+        per_action_data_counter_registry::get_histogram_counter(
+            std::string const& name,
+            hpx::util::function_nonser<
+                std::vector<std::int64_t>(std::string const&, bool)
+            > const& f) const
+    {
+        map_type::const_iterator it = map_.find(name);
+        if (it == map_.end())
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "per_action_data_counter_registry::get_histogram_counter",
+                "unknown action type");
+            return nullptr;
+        }
+        return util::bind(f, name, util::placeholders::_1);
+    }
+
     bool per_action_data_counter_registry::counter_discoverer(
         performance_counters::counter_info const& info,
         performance_counters::counter_path_elements& p,
@@ -512,12 +512,12 @@ namespace hpx { namespace parcelset
 
         ar & data_;
 #if !defined(HPX_DEBUG)
-        const std::uint32_t id =
-            action_registry::get_id(action_->get_action_name());
+        const std::uint32_t id = action_->get_action_id();
         ar << id;
 #else
         std::string const name(action_->get_action_name());
-        const std::uint32_t id = action_registry::get_id(name);
+        const std::uint32_t id = action_->get_action_id();
+        HPX_ASSERT(id == action_registry::get_id(name));
         ar << id;
         ar << name;
 #endif
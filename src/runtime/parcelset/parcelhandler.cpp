@@ -17,6 +17,7 @@
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/unlock_guard.hpp>
 #include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/actions/detail/inline_execution.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/message_handler_fwd.hpp>
@@ -112,6 +113,13 @@ namespace hpx { namespace parcelset
     {
         LPROGRESS_;
 
+        actions::detail::configure_inline_execution(
+            util::get_entry_as<int>(cfg, "hpx.parcel.inline_actions", "0") != 0,
+            util::get_entry_as<std::int64_t>(
+                cfg, "hpx.parcel.inline_actions_threshold", "5000"),
+            util::get_entry_as<std::int64_t>(
+                cfg, "hpx.parcel.inline_actions_samples", "16"));
+
 #if defined(HPX_HAVE_NETWORKING)
         if (cfg.get_entry("hpx.parcel.enable", "1") != "0")
         {
@@ -1035,6 +1043,15 @@ namespace hpx { namespace parcelset
         parcelport* pp = find_parcelport(pp_type, ec);
         return pp ? pp->get_action_data_received(action, reset) : 0;
     }
+
+    std::vector<std::int64_t> parcelhandler::get_action_histogram(
+        std::string const& pp_type, action_histogram_type histogram,
+        std::string const& action, bool reset) const
+    {
+        error_code ec(lightweight);
+        parcelport* pp = find_parcelport(pp_type, ec);
+        return pp ? (pp->*histogram)(action, reset) : std::vector<std::int64_t>();
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -1422,8 +1439,122 @@ namespace hpx { namespace parcelset
         };
         performance_counters::install_counter_types(
             counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+        register_histogram_counter_types(pp_type);
 #endif
+#endif
+    }
+
+#if defined(HPX_HAVE_PARCELPORT_ACTION_COUNTERS)
+    // register connection specific performance counters exposing histograms
+    // of the per-action parcel statistics
+    void parcelhandler::register_histogram_counter_types(
+        std::string const& pp_type)
+    {
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        typedef util::function_nonser<
+                std::vector<std::int64_t>(std::string const&, bool)
+            > histogram_function_type;
+
+        histogram_function_type data_sent(util::bind(
+            &parcelhandler::get_action_histogram, this, pp_type,
+            &parcelport::get_action_data_sent_histogram, _1, _2));
+        histogram_function_type data_received(util::bind(
+            &parcelhandler::get_action_histogram, this, pp_type,
+            &parcelport::get_action_data_received_histogram, _1, _2));
+        histogram_function_type sending_serialization_time(util::bind(
+            &parcelhandler::get_action_histogram, this, pp_type,
+            &parcelport::get_action_sending_serialization_time_histogram,
+            _1, _2));
+        histogram_function_type receiving_serialization_time(util::bind(
+            &parcelhandler::get_action_histogram, this, pp_type,
+            &parcelport::get_action_receiving_serialization_time_histogram,
+            _1, _2));
+        histogram_function_type queue_time(util::bind(
+            &parcelhandler::get_action_histogram, this, pp_type,
+            &parcelport::get_action_queue_time_histogram, _1, _2));
+
+        performance_counters::generic_counter_type_data const counter_types[] =
+        {
+            { boost::str(boost::format(
+                  "/parcels/histogram/%s/size/sent") % pp_type),
+              performance_counters::counter_histogram,
+              boost::str(boost::format(
+                  "returns a histogram of the sizes of the parcels sent using "
+                  "the %s connection type by the referenced locality "
+                  "(logarithmic buckets)") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(
+                  &performance_counters::per_action_histogram_counter_creator,
+                  _1, std::move(data_sent), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+              "bytes"
+            },
+            { boost::str(boost::format(
+                  "/parcels/histogram/%s/size/received") % pp_type),
+              performance_counters::counter_histogram,
+              boost::str(boost::format(
+                  "returns a histogram of the sizes of the parcels received "
+                  "using the %s connection type by the referenced locality "
+                  "(logarithmic buckets)") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(
+                  &performance_counters::per_action_histogram_counter_creator,
+                  _1, std::move(data_received), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+              "bytes"
+            },
+            { boost::str(boost::format(
+                  "/parcels/histogram/%s/serialization_time/sent") % pp_type),
+              performance_counters::counter_histogram,
+              boost::str(boost::format(
+                  "returns a histogram of the times required to serialize "
+                  "the parcels sent using the %s connection type by the "
+                  "referenced locality (logarithmic buckets)") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(
+                  &performance_counters::per_action_histogram_counter_creator,
+                  _1, std::move(sending_serialization_time), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+              "ns"
+            },
+            { boost::str(boost::format(
+                  "/parcels/histogram/%s/serialization_time/received") %
+                      pp_type),
+              performance_counters::counter_histogram,
+              boost::str(boost::format(
+                  "returns a histogram of the times required to de-serialize "
+                  "the parcels received using the %s connection type by the "
+                  "referenced locality (logarithmic buckets)") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(
+                  &performance_counters::per_action_histogram_counter_creator,
+                  _1, std::move(receiving_serialization_time), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+              "ns"
+            },
+            { boost::str(boost::format(
+                  "/parcels/histogram/%s/queue_time/sent") % pp_type),
+              performance_counters::counter_histogram,
+              boost::str(boost::format(
+                  "returns a histogram of the times the parcels sent using "
+                  "the %s connection type by the referenced locality were "
+                  "waiting to be sent (logarithmic buckets)") % pp_type),
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(
+                  &performance_counters::per_action_histogram_counter_creator,
+                  _1, std::move(queue_time), _2),
+              &performance_counters::per_action_data_counter_discoverer,
+              "ns"
+            }
+        };
+        performance_counters::install_counter_types(
+            counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
     }
+#endif
 
     // register connection specific performance counters related to connection
     // caches
@@ -1585,6 +1716,9 @@ namespace hpx { namespace parcelset
                 "$[hpx.parcel.array_optimization]}",
             "enable_security = ${HPX_PARCEL_ENABLE_SECURITY:0}",
             "async_serialization = ${HPX_PARCEL_ASYNC_SERIALIZATION:1}",
+            "inline_actions = ${HPX_PARCEL_INLINE_ACTIONS:0}",
+            "inline_actions_threshold = ${HPX_PARCEL_INLINE_ACTIONS_THRESHOLD:5000}",
+            "inline_actions_samples = ${HPX_PARCEL_INLINE_ACTIONS_SAMPLES:16}",
 #if defined(HPX_HAVE_PARCEL_COALESCING)
             "message_handlers = ${HPX_PARCEL_MESSAGE_HANDLERS:1}"
 #else
@@ -33,7 +33,6 @@ namespace hpx { namespace parcelset
     parcelport::parcelport(util::runtime_configuration const& ini,
             locality const & here, std::string const& type)
       : applier_(nullptr),
-        num_parcel_destinations_(0),
         here_(here),
         max_inbound_message_size_(ini.get_max_inbound_message_size()),
         max_outbound_message_size_(ini.get_max_outbound_message_size()),
@@ -102,6 +101,11 @@ namespace hpx { namespace parcelset
     {
         action_parcels_sent_.add_data(action, data);
     }
+
+    void parcelport::add_sent_queue_time(char const* action, std::int64_t time)
+    {
+        action_parcels_sent_.add_queue_time(action, time);
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -193,23 +197,7 @@ namespace hpx { namespace parcelset
 
     std::int64_t parcelport::get_pending_parcels_count(bool /*reset*/)
     {
-        std::lock_guard<lcos::local::spinlock> l(mtx_);
-        std::int64_t count = 0;
-        for (auto && p : pending_parcels_)
-        {
-#if defined(HPX_PARCELSET_PENDING_PARCELS_WORKAROUND)
-            count += hpx::util::get<0>(p.second)->size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second)->size() ==
-                hpx::util::get<1>(p.second).size());
-#else
-            count += hpx::util::get<0>(p.second).size();
-            HPX_ASSERT(
-                hpx::util::get<0>(p.second).size() ==
-                hpx::util::get<1>(p.second).size());
-#endif
-        }
-        return count;
+        return pending_parcels_.size();
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -270,6 +258,43 @@ namespace hpx { namespace parcelset
             return parcels_received_.total_bytes(reset);
         return action_parcels_received_.total_bytes(action, reset);
     }
+
+    // histograms of the sizes of the parcels sent and received (bytes)
+    std::vector<std::int64_t> parcelport::get_action_data_sent_histogram(
+        std::string const& action, bool reset)
+    {
+        return action_parcels_sent_.bytes_histogram(action, reset);
+    }
+
+    std::vector<std::int64_t> parcelport::get_action_data_received_histogram(
+        std::string const& action, bool reset)
+    {
+        return action_parcels_received_.bytes_histogram(action, reset);
+    }
+
+    // histograms of the times needed for (de-)serializing parcels
+    // (nanoseconds)
+    std::vector<std::int64_t>
+        parcelport::get_action_sending_serialization_time_histogram(
+            std::string const& action, bool reset)
+    {
+        return action_parcels_sent_.serialization_time_histogram(action, reset);
+    }
+
+    std::vector<std::int64_t>
+        parcelport::get_action_receiving_serialization_time_histogram(
+            std::string const& action, bool reset)
+    {
+        return action_parcels_received_.serialization_time_histogram(
+            action, reset);
+    }
+
+    // histogram of the times parcels were waiting to be sent (nanoseconds)
+    std::vector<std::int64_t> parcelport::get_action_queue_time_histogram(
+        std::string const& action, bool reset)
+    {
+        return action_parcels_sent_.queue_time_histogram(action, reset);
+    }
 #endif
 
     ///////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,78 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/parcelset/receive_chunk.hpp>
+#include <hpx/util/static.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace parcelset
+{
+    namespace detail
+    {
+        struct receive_chunk_allocator
+        {
+            typedef lcos::local::spinlock mutex_type;
+
+            mutex_type mtx_;
+            std::shared_ptr<receive_chunk_allocator_type> alloc_;
+        };
+
+        struct receive_chunk_allocator_tag {};
+
+        receive_chunk_allocator& get_receive_chunk_allocator()
+        {
+            util::static_<
+                    receive_chunk_allocator, receive_chunk_allocator_tag
+                > allocator;
+            return allocator.get();
+        }
+    }
+
+    receive_chunk_allocator_type set_receive_chunk_allocator(
+        receive_chunk_allocator_type const& f)
+    {
+        std::shared_ptr<receive_chunk_allocator_type> alloc;
+        if (!f.empty())
+            alloc = std::make_shared<receive_chunk_allocator_type>(f);
+
+        detail::receive_chunk_allocator& a =
+            detail::get_receive_chunk_allocator();
+        {
+            std::lock_guard<detail::receive_chunk_allocator::mutex_type>
+                l(a.mtx_);
+            std::swap(a.alloc_, alloc);
+        }
+
+        if (!alloc)
+            return receive_chunk_allocator_type();
+        return *alloc;
+    }
+
+    std::shared_ptr<char> allocate_receive_chunk(std::size_t size)
+    {
+        std::shared_ptr<receive_chunk_allocator_type> alloc;
+        {
+            detail::receive_chunk_allocator& a =
+                detail::get_receive_chunk_allocator();
+            std::lock_guard<detail::receive_chunk_allocator::mutex_type>
+                l(a.mtx_);
+            alloc = a.alloc_;
+        }
+
+        if (alloc)
+            return (*alloc)(size);
+
+        // operator new[] returns memory suitably aligned for all
+        // fundamental types
+        return std::shared_ptr<char>(new char[size],
+            std::default_delete<char[]>());
+    }
+}}
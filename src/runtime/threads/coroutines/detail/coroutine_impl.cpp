@@ -29,17 +29,23 @@
 
 #include <hpx/config.hpp>
 
+#include <hpx/runtime/config_entry.hpp>
 #include <hpx/runtime/threads/coroutines/coroutine.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_impl.hpp>
 #include <hpx/runtime/threads/coroutines/detail/coroutine_self.hpp>
+#include <hpx/runtime/threads/detail/thread_num_tss.hpp>
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/reinitializable_static.hpp>
 
+#include <boost/atomic.hpp>
 #include <boost/exception_ptr.hpp>
+#include <boost/lexical_cast.hpp>
 #include <boost/lockfree/stack.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <utility>
 
 namespace hpx { namespace threads { namespace coroutines { namespace detail
@@ -65,12 +71,33 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         };
     }
 
-#if defined(HPX_DEBUG)
     coroutine_impl::~coroutine_impl()
     {
+        // a stackless coroutine which was never invoked can't be exited by
+        // switching to it (see context_base::~context_base)
+        if (m_stackless && !this->exited())
+            exit();
+
         HPX_ASSERT(!m_fun);   // functor should have been reset by now
     }
-#endif
+
+    // Stackless coroutines don't have a stack to switch to, exiting one
+    // which is ready just drops the bound function.
+    void coroutine_impl::exit() HPX_NOEXCEPT
+    {
+        if (!m_stackless)
+        {
+            this->super_type::exit();
+            return;
+        }
+
+        HPX_ASSERT(!this->pending());
+        HPX_ASSERT(this->is_ready());
+
+        this->reset();
+        this->m_state = super_type::ctx_exited;
+        this->m_exit_status = super_type::ctx_exited_exit;
+    }
 
     void coroutine_impl::operator()()
     {
@@ -132,12 +159,105 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         HPX_ASSERT(this->m_state == super_type::ctx_running);
     }
 
+    // Stackless coroutines don't switch contexts, the bound function is
+    // invoked directly and the coroutine is left in the same state as if it
+    // had returned through do_return().
+    void coroutine_impl::invoke_stackless()
+    {
+        typedef super_type::context_exit_status context_exit_status;
+
+        HPX_ASSERT(m_stackless);
+        HPX_ASSERT(this->is_ready());
+
+#if defined(HPX_HAVE_THREAD_PHASE_INFORMATION)
+        ++this->m_phase;
+#endif
+        this->m_state = super_type::ctx_running;
+
+        context_exit_status status = super_type::ctx_exited_return;
+        boost::exception_ptr tinfo;
+        try
+        {
+            this->check_exit_state();
+
+            HPX_ASSERT(this->count() > 0);
+
+            {
+                coroutine_self* old_self = coroutine_self::get_self();
+                coroutine_self self(this, old_self);
+                reset_self_on_exit on_exit(&self, old_self);
+
+                this->m_result_last = m_fun(*this->args());
+
+                // if this thread returned 'terminated' we need to reset
+                // the functor and the bound arguments
+                if (this->m_result_last.first == terminated)
+                    this->reset();
+            }
+
+            // return value to the caller
+            this->bind_result(&this->m_result_last);
+        }
+        catch (exit_exception const&) {
+            status = super_type::ctx_exited_exit;
+            tinfo = boost::current_exception();
+            this->reset();            // reset functor
+        }
+#ifndef HPX_WITH_DISABLED_SIGNAL_EXCEPTION_HANDLERS
+        catch (boost::exception const&) {
+            status = super_type::ctx_exited_abnormally;
+            tinfo = boost::current_exception();
+            this->reset();
+        } catch (std::exception const&) {
+            status = super_type::ctx_exited_abnormally;
+            tinfo = boost::current_exception();
+            this->reset();
+        } catch (...) {
+            status = super_type::ctx_exited_abnormally;
+            tinfo = boost::current_exception();
+            this->reset();
+        }
+#endif
+
+        this->m_type_info = std::move(tinfo);
+        this->m_state = super_type::ctx_exited;
+        this->m_exit_status = status;
+
+        if (status == super_type::ctx_exited_abnormally)
+            boost::rethrow_exception(this->m_type_info);
+        else if (status == super_type::ctx_exited_exit)
+            boost::throw_exception(coroutine_exited());
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // maximum size (in bytes) of the stacks kept alive by each of the
+        // coroutine heaps, coroutine objects returned to a full heap are
+        // released. This counts the reserved size of the stacks, the memory
+        // actually resident is usually much smaller.
+        std::size_t get_stack_pool_max_reserved_size()
+        {
+            static std::size_t stack_pool_max_reserved_size =
+                boost::lexical_cast<std::size_t>(hpx::get_config_entry(
+                    "hpx.stacks.pool_max_reserved_size", "67108864"));
+            return stack_pool_max_reserved_size;
+        }
+
+        typedef boost::atomic<std::int64_t> counter_type;
+
+        counter_type stack_pool_hits(0);
+        counter_type stack_pool_misses(0);
+        counter_type stack_pool_releases(0);
+        counter_type stack_pool_reserved_bytes(0);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // the memory for the threads is managed by a lockfree caching_freelist
     struct coroutine_heap
     {
         coroutine_heap()
-          : heap_(128)
+          : heap_(128), size_(0)
         {}
 
         ~coroutine_heap()
@@ -148,16 +268,44 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
         coroutine_impl* allocate()
         {
-            return get_locked();
+            coroutine_impl* p = get_locked();
+            if (p)
+            {
+                std::int64_t stacksize = pooled_size(p);
+                size_ -= stacksize;
+                stack_pool_reserved_bytes -= stacksize;
+            }
+            return p;
         }
 
-        void deallocate(coroutine_impl* p)
+        bool deallocate(coroutine_impl* p)
         {
-            //p->reset();          // reset bound function
+            // reserve the space for this stack, give up if the heap is full
+            std::int64_t const stacksize = pooled_size(p);
+            std::int64_t const max_size =
+                static_cast<std::int64_t>(get_stack_pool_max_reserved_size());
+
+            std::int64_t size = size_.load(boost::memory_order_relaxed);
+            do {
+                if (size + stacksize > max_size)
+                    return false;
+            } while (!size_.compare_exchange_weak(size, size + stacksize));
+
+            stack_pool_reserved_bytes += stacksize;
             heap_.push(p);
+            return true;
         }
 
     private:
+        // stackless coroutines don't own a stack, account for the size of
+        // the object itself to keep their number bounded
+        static std::int64_t pooled_size(coroutine_impl* p)
+        {
+            return p->is_stackless() ?
+                static_cast<std::int64_t>(sizeof(coroutine_impl)) :
+                static_cast<std::int64_t>(p->get_stacksize());
+        }
+
         coroutine_impl* get_locked()
         {
             coroutine_impl* result = nullptr;
@@ -166,6 +314,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         }
 
         boost::lockfree::stack<coroutine_impl*> heap_;
+        counter_type size_;
     };
 
     ///////////////////////////////////////////////////////////////////////////
@@ -173,6 +322,7 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
     struct heap_tag_medium {};
     struct heap_tag_large {};
     struct heap_tag_huge {};
+    struct heap_tag_nostack {};
 
     template <std::size_t NumHeaps, typename Tag>
     static coroutine_heap& get_heap(std::size_t i)
@@ -184,6 +334,12 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
 
     static coroutine_heap& get_heap(std::size_t i, std::ptrdiff_t stacksize)
     {
+        // stackless coroutines are kept separate as they don't own a stack
+        // which could be used for regular threads
+        if (stacksize == thread_stacksize_nostack)
+            return get_heap<HPX_COROUTINE_NUM_HEAPS,
+                heap_tag_nostack>(i % HPX_COROUTINE_NUM_HEAPS);
+
         // FIXME: This should check the sizes in runtime_configuration, not the
         // default macro sizes
         if (stacksize > HPX_MEDIUM_STACK_SIZE)
@@ -215,11 +371,25 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
         return HPX_COROUTINE_NUM_HEAPS;
     }
 
+    // Worker threads prefer the heap associated with their own number. As
+    // worker threads are pinned to their cores, this keeps the stacks (which
+    // were faulted in by the worker first touching them) close to the NUMA
+    // domain they are used on. All other threads pick a heap based on the
+    // thread id.
+    static std::size_t get_heap_num(coroutine_impl::thread_id_repr_type id)
+    {
+        std::size_t num_thread =
+            threads::detail::thread_num_tss_.get_worker_thread_num();
+        if (num_thread != std::size_t(-1))
+            return num_thread;
+        return std::size_t(id) / 32; //-V112
+    }
+
     coroutine_impl* coroutine_impl::allocate(
         thread_id_repr_type id, std::ptrdiff_t stacksize)
     {
         // start looking at the matching heap
-        std::size_t const heap_num = std::size_t(id) / 32; //-V112
+        std::size_t const heap_num = get_heap_num(id);
         std::size_t const heap_count = get_heap_count(stacksize);
 
         // look through all heaps to find an available coroutine object
@@ -231,14 +401,47 @@ namespace hpx { namespace threads { namespace coroutines { namespace detail
                 p = get_heap(heap_num + i, stacksize).allocate();
             }
         }
+
+        if (p)
+            ++stack_pool_hits;
+        else
+            ++stack_pool_misses;
+
         return p;
     }
 
     void coroutine_impl::deallocate(coroutine_impl* p)
     {
-        std::size_t const heap_num = std::size_t(p->get_thread_id()) / 32; //-V112
-        std::ptrdiff_t const stacksize = p->get_stacksize();
+        std::size_t const heap_num = get_heap_num(p->get_thread_id());
+        std::ptrdiff_t const stacksize = p->is_stackless() ?
+            std::ptrdiff_t(thread_stacksize_nostack) : p->get_stacksize();
 
-        get_heap(heap_num, stacksize).deallocate(p);
+        if (!get_heap(heap_num, stacksize).deallocate(p))
+        {
+            // the heap holds already as much stack memory as allowed
+            ++stack_pool_releases;
+            delete p;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    std::uint64_t coroutine_impl::get_stack_pool_hit_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_pool_hits, reset);
+    }
+
+    std::uint64_t coroutine_impl::get_stack_pool_miss_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_pool_misses, reset);
+    }
+
+    std::uint64_t coroutine_impl::get_stack_pool_release_count(bool reset)
+    {
+        return util::get_and_reset_value(stack_pool_releases, reset);
+    }
+
+    std::uint64_t coroutine_impl::get_stack_pool_reserved_bytes(bool /*reset*/)
+    {
+        return static_cast<std::uint64_t>(stack_pool_reserved_bytes.load());
     }
 }}}}
@@ -202,6 +202,24 @@ namespace hpx { namespace threads { namespace detail
         detail::create_work(&sched_, data, initial_state, ec); //-V601
     }
 
+    template <typename Scheduler>
+    void thread_pool<Scheduler>::create_work_bulk(
+        std::vector<thread_init_data>& data, thread_state_enum initial_state,
+        error_code& ec)
+    {
+        // verify state
+        if (thread_count_ == 0 && !sched_.is_state(state_running))
+        {
+            // thread-manager is not currently running
+            HPX_THROWS_IF(ec, invalid_status,
+                "thread_pool<Scheduler>::create_work_bulk",
+                "invalid state: thread pool is not running");
+            return;
+        }
+
+        detail::create_work_bulk(&sched_, data, initial_state, ec); //-V601
+    }
+
     template <typename Scheduler>
     thread_state thread_pool<Scheduler>::set_state(
         thread_id_type const& id, thread_state_enum new_state,
@@ -496,7 +514,7 @@ namespace hpx { namespace threads { namespace detail
             sched_.set_all_states(state_stopping);
 
             // make sure we're not waiting
-            sched_.Scheduler::do_some_work(std::size_t(-1));
+            sched_.Scheduler::do_all_work();
 
             if (blocking) {
                 for (std::size_t i = 0; i != threads_.size(); ++i)
@@ -506,7 +524,7 @@ namespace hpx { namespace threads { namespace detail
                         << "thread_pool::stop: " << pool_name_
                         << " notify_all";
 
-                    sched_.Scheduler::do_some_work(std::size_t(-1));
+                    sched_.Scheduler::do_all_work();
 
                     LTM_(info) //-V128
                         << "thread_pool::stop: " << pool_name_
@@ -630,12 +648,9 @@ namespace hpx { namespace threads { namespace detail
                         idle_loop_counts_[num_thread], busy_loop_counts_[num_thread],
                         tasks_active_[num_thread]);
 
-                    detail::scheduling_callbacks callbacks(
-                        util::bind( //-V107
-                            &policies::scheduler_base::idle_callback,
-                            &sched_, num_thread
-                        ),
-                        detail::scheduling_callbacks::callback_type());
+                    // idle OS threads back off inside the scheduling loop
+                    detail::scheduling_callbacks callbacks{
+                        detail::scheduling_callbacks::callback_type()};
 
                     if (mode_ & policies::do_background_work)
                     {
@@ -1407,6 +1422,50 @@ namespace hpx { namespace threads { namespace detail
     {
         return sched_.Scheduler::get_num_stolen_to_staged(num, reset);
     }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_local(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_local(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_numa_local(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_numa_local(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_stolen_remote(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_stolen_remote(num, reset);
+    }
+#endif
+
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_parks(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_parks(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_num_unparks(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_num_unparks(num, reset);
+    }
+
+    template <typename Scheduler>
+    std::int64_t thread_pool<Scheduler>::
+        get_average_wakeup_time(std::size_t num, bool reset)
+    {
+        return sched_.Scheduler::get_average_wakeup_time(num, reset);
+    }
 #endif
 
     template <typename Scheduler>
@@ -1467,6 +1526,10 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::detail::thread_pool<
@@ -1487,3 +1550,9 @@ template class HPX_EXPORT hpx::threads::detail::thread_pool<
     hpx::threads::policies::periodic_priority_queue_scheduler<> >;
 #endif
 
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_priority_queue_scheduler.hpp>
+template class HPX_EXPORT hpx::threads::detail::thread_pool<
+    hpx::threads::policies::numa_priority_queue_scheduler<> >;
+#endif
+
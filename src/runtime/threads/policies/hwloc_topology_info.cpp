@@ -88,6 +88,20 @@ namespace hpx { namespace threads
 
             return static_cast<std::size_t>(obj->logical_index);
         }
+
+        // data (or unified) caches of level 2 and 3 are considered to be
+        // shared between the processing units underneath
+        bool is_shared_cache(hwloc_obj_t obj)
+        {
+#if HWLOC_API_VERSION >= 0x00020000
+            return obj->type == HWLOC_OBJ_L2CACHE ||
+                obj->type == HWLOC_OBJ_L3CACHE;
+#else
+            return obj->type == HWLOC_OBJ_CACHE &&
+                obj->attr->cache.type != HWLOC_OBJ_CACHE_INSTRUCTION &&
+                (obj->attr->cache.depth == 2 || obj->attr->cache.depth == 3);
+#endif
+        }
     }
 
     ///////////////////////////////////////////////////////////////////////////
@@ -173,10 +187,18 @@ namespace hpx { namespace threads
             core_affinity_masks_.push_back(init_core_affinity_mask(i));
         }
 
+        cache_affinity_masks_.reserve(num_of_pus_);
+        for (std::size_t i = 0; i < num_of_pus_; ++i)
+        {
+            cache_affinity_masks_.push_back(init_cache_affinity_mask(i));
+        }
+
         for (std::size_t i = 0; i < num_of_pus_; ++i)
         {
             thread_affinity_masks_.push_back(init_thread_affinity_mask(i));
         }
+
+        init_numa_node_distances();
     } // }}}
 
     void hwloc_topology_info::write_to_log() const
@@ -205,6 +227,8 @@ namespace hpx { namespace threads
         detail::write_to_log_mask("socket_affinity_mask", socket_affinity_masks_);
         detail::write_to_log_mask("numa_node_affinity_mask", numa_node_affinity_masks_);
         detail::write_to_log_mask("core_affinity_mask", core_affinity_masks_);
+        detail::write_to_log_mask("cache_affinity_mask", cache_affinity_masks_);
+        detail::write_to_log("numa_node_distance", numa_node_distances_);
         detail::write_to_log_mask("thread_affinity_mask", thread_affinity_masks_);
     }
 
@@ -305,6 +329,44 @@ namespace hpx { namespace threads
         return empty_mask;
     } // }}}
 
+    mask_cref_type hwloc_topology_info::get_cache_affinity_mask(
+        std::size_t num_thread
+      , bool numa_sensitive
+      , error_code& ec
+        ) const
+    {
+        std::size_t num_pu = num_thread % num_of_pus_;
+
+        if (num_pu < cache_affinity_masks_.size())
+        {
+            if (&ec != &throws)
+                ec = make_success_code();
+
+            return cache_affinity_masks_[num_pu];
+        }
+
+        HPX_THROWS_IF(ec, bad_parameter
+          , "hpx::threads::hwloc_topology_info::get_cache_affinity_mask"
+          , boost::str(boost::format(
+                "thread number %1% is out of range")
+                % num_thread));
+        return empty_mask;
+    }
+
+    std::size_t hwloc_topology_info::get_numa_node_distance(
+        std::size_t numa_node1
+      , std::size_t numa_node2
+        ) const
+    {
+        std::size_t num_of_nodes = get_number_of_numa_nodes();
+        if (numa_node1 < num_of_nodes && numa_node2 < num_of_nodes &&
+            numa_node_distances_.size() == num_of_nodes * num_of_nodes)
+        {
+            return numa_node_distances_[numa_node1 * num_of_nodes + numa_node2];
+        }
+        return this->topology::get_numa_node_distance(numa_node1, numa_node2);
+    }
+
     mask_cref_type hwloc_topology_info::get_core_affinity_mask(
         std::size_t num_thread
       , bool numa_sensitive
@@ -923,6 +985,97 @@ namespace hpx { namespace threads
         return default_mask;
     } // }}}
 
+    mask_type hwloc_topology_info::init_cache_affinity_mask(
+        std::size_t num_thread
+        ) const
+    { // {{{
+        std::size_t num_pu = (num_thread + pu_offset) % num_of_pus_;
+
+        hwloc_obj_t obj = nullptr;
+        {
+            std::unique_lock<hpx::util::spinlock> lk(topo_mtx);
+            obj = hwloc_get_obj_by_type(topo, HWLOC_OBJ_PU,
+                static_cast<unsigned>(num_pu));
+        }
+
+        // find the outermost (last level) L2/L3 cache above this PU
+        hwloc_obj_t cache_obj = nullptr;
+        for (/**/; obj != nullptr; obj = obj->parent)
+        {
+            if (detail::is_shared_cache(obj))
+                cache_obj = obj;
+        }
+
+        if (cache_obj)
+        {
+            mask_type cache_affinity_mask = mask_type();
+            resize(cache_affinity_mask, get_number_of_pus());
+
+            extract_node_mask(cache_obj, cache_affinity_mask);
+            return cache_affinity_mask;
+        }
+
+        return core_affinity_masks_[num_thread % num_of_pus_];
+    } // }}}
+
+    void hwloc_topology_info::init_numa_node_distances()
+    { // {{{
+        std::size_t num_of_nodes = get_number_of_numa_nodes();
+        if (num_of_nodes == 0) num_of_nodes = 1;
+
+        // start off with the default distances
+        numa_node_distances_.assign(num_of_nodes * num_of_nodes, 20);
+        for (std::size_t i = 0; i != num_of_nodes; ++i)
+            numa_node_distances_[i * num_of_nodes + i] = 10;
+
+        std::unique_lock<hpx::util::spinlock> lk(topo_mtx);
+
+#if HWLOC_API_VERSION >= 0x00020000
+        unsigned nr = 1;
+        hwloc_distances_s* distances = nullptr;
+        if (0 != hwloc_distances_get_by_type(topo, HWLOC_OBJ_NUMANODE, &nr,
+                &distances, HWLOC_DISTANCES_KIND_MEANS_LATENCY, 0) ||
+            nr == 0 || distances == nullptr)
+        {
+            return;     // no distance information available
+        }
+
+        unsigned const nbobjs = distances->nbobjs;
+        for (unsigned i = 0; i != nbobjs; ++i)
+        {
+            std::size_t node1 = detail::get_index(distances->objs[i]);
+            for (unsigned j = 0; j != nbobjs; ++j)
+            {
+                std::size_t node2 = detail::get_index(distances->objs[j]);
+                if (node1 < num_of_nodes && node2 < num_of_nodes)
+                {
+                    numa_node_distances_[node1 * num_of_nodes + node2] =
+                        static_cast<std::size_t>(
+                            distances->values[i * nbobjs + j]);
+                }
+            }
+        }
+        hwloc_distances_release(topo, distances);
+#else
+        hwloc_distances_s const* distances =
+            hwloc_get_whole_distance_matrix_by_type(topo, HWLOC_OBJ_NODE);
+        if (distances == nullptr || distances->latency == nullptr)
+            return;     // no distance information available
+
+        // latencies are normalized such that the smallest one is 1.0
+        unsigned const nbobjs = distances->nbobjs;
+        for (unsigned i = 0; i != nbobjs && i < num_of_nodes; ++i)
+        {
+            for (unsigned j = 0; j != nbobjs && j < num_of_nodes; ++j)
+            {
+                numa_node_distances_[i * num_of_nodes + j] =
+                    static_cast<std::size_t>(
+                        10.0f * distances->latency[i * nbobjs + j] + 0.5f);
+            }
+        }
+#endif
+    } // }}}
+
     mask_type hwloc_topology_info::init_thread_affinity_mask(
         std::size_t num_thread
         ) const
@@ -183,6 +183,12 @@ namespace hpx { namespace threads
         return id ? id->get_stack_size() : 0;
     }
 
+    bool is_self_suspendable()
+    {
+        thread_self* self = get_self_ptr();
+        return nullptr != self && !self->is_stackless();
+    }
+
 #ifndef HPX_HAVE_THREAD_PARENT_REFERENCE
     thread_id_repr_type get_parent_id()
     {
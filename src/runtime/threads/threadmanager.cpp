@@ -11,6 +11,7 @@
 #include <hpx/performance_counters/counters.hpp>
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/runtime_fwd.hpp>
 #include <hpx/runtime/threads/topology.hpp>
 #include <hpx/runtime/threads/threadmanager_impl.hpp>
 #include <hpx/runtime/threads/thread_data.hpp>
@@ -133,6 +134,8 @@ namespace hpx { namespace threads
     {
         if (size == thread_stacksize_unknown)
             return "unknown";
+        if (size == thread_stacksize_nostack)
+            return "nostack";
 
         util::runtime_configuration const& rtcfg = hpx::get_config();
         if (rtcfg.get_stack_size(thread_stacksize_small) == size)
@@ -165,7 +168,7 @@ namespace hpx { namespace threads
         pool_(scheduler, notifier, "main_thread_scheduling_pool",
             policies::scheduler_mode(
                 policies::do_background_work | policies::reduce_thread_priority |
-                policies::delay_exit)),
+                policies::delay_exit | policies::enable_idle_backoff)),
         notifier_(notifier)
     {}
 
@@ -246,6 +249,15 @@ namespace hpx { namespace threads
         pool_.create_work(data, initial_state, ec);
     }
 
+    template <typename SchedulingPolicy>
+    void threadmanager_impl<SchedulingPolicy>::register_work_bulk(
+        std::vector<thread_init_data>& data, thread_state_enum initial_state,
+        error_code& ec)
+    {
+        util::block_profiler_wrapper<register_work_tag> bp(work_logger_);
+        pool_.create_work_bulk(data, initial_state, ec);
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     // counter creator and discovery functions
 
@@ -828,6 +840,33 @@ namespace hpx { namespace threads
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
             },
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            // /threads{locality#%d/total}/count/parked
+            // /threads{locality#%d/worker-thread%d}/count/parked
+            { "count/parked",
+              util::bind(&spt::get_num_parks, &pool_, std::size_t(-1), _1),
+              util::bind(&spt::get_num_parks, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/unparked
+            // /threads{locality#%d/worker-thread%d}/count/unparked
+            { "count/unparked",
+              util::bind(&spt::get_num_unparks, &pool_, std::size_t(-1), _1),
+              util::bind(&spt::get_num_unparks, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/time/average-wakeup
+            // /threads{locality#%d/worker-thread%d}/time/average-wakeup
+            { "time/average-wakeup",
+              util::bind(&spt::get_average_wakeup_time, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_average_wakeup_time, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+#endif
             // /threads{locality#%d/total}/count/instantaneous/all
             // /threads{locality#%d/worker-thread%d}/count/instantaneous/all
             { "count/instantaneous/all",
@@ -900,6 +939,28 @@ namespace hpx { namespace threads
               util::function_nonser<std::uint64_t(bool)>(), "", 0
             },
 #endif
+            // /threads{locality#%d/total}/count/stack-pool-hits
+            { "count/stack-pool-hits",
+              util::bind(&coroutine_type::impl_type::get_stack_pool_hit_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-pool-misses
+            { "count/stack-pool-misses",
+              util::bind(&coroutine_type::impl_type::get_stack_pool_miss_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-pool-releases
+            { "count/stack-pool-releases",
+              util::bind(&coroutine_type::impl_type::get_stack_pool_release_count, _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
+            // /threads{locality#%d/total}/count/stack-pool-reserved-bytes
+            { "count/stack-pool-reserved-bytes",
+              util::bind(
+                  &coroutine_type::impl_type::get_stack_pool_reserved_bytes,
+                  _1),
+              util::function_nonser<std::uint64_t(bool)>(), "", 0
+            },
             // /threads{locality#%d/total}/count/objects
             // /threads{locality#%d/allocator%d}/count/objects
             { "count/objects",
@@ -962,6 +1023,33 @@ namespace hpx { namespace threads
               util::bind(&spt::get_num_stolen_to_staged, &pool_,
                   static_cast<std::size_t>(paths.instanceindex_), _1),
               "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-local
+            // /threads{locality#%d/worker-thread%d}/count/stolen-local
+            { "count/stolen-local",
+              util::bind(&spt::get_num_stolen_local, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_local, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-numa-local
+            // /threads{locality#%d/worker-thread%d}/count/stolen-numa-local
+            { "count/stolen-numa-local",
+              util::bind(&spt::get_num_stolen_numa_local, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_numa_local, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
+            },
+            // /threads{locality#%d/total}/count/stolen-remote
+            // /threads{locality#%d/worker-thread%d}/count/stolen-remote
+            { "count/stolen-remote",
+              util::bind(&spt::get_num_stolen_remote, &pool_,
+                  std::size_t(-1), _1),
+              util::bind(&spt::get_num_stolen_remote, &pool_,
+                  static_cast<std::size_t>(paths.instanceindex_), _1),
+              "worker-thread", shepherd_count
             }
 #endif
         };
@@ -1107,6 +1195,29 @@ namespace hpx { namespace threads
               &performance_counters::locality_thread_counter_discoverer,
               "ns"
             },
+#if defined(HPX_HAVE_THREAD_MANAGER_IDLE_BACKOFF)
+            { "/threads/count/parked", performance_counters::counter_raw,
+              "returns the number of times idle worker threads were put to "
+              "sleep for the referenced locality", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/unparked", performance_counters::counter_raw,
+              "returns the number of times sleeping worker threads were woken "
+              "up because of new work for the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/time/average-wakeup", performance_counters::counter_raw,
+              "returns the average time between new work being scheduled for "
+              "a sleeping worker thread and that thread resuming execution",
+              HPX_PERFORMANCE_COUNTER_V1, counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              "ns"
+            },
+#endif
             { "/threads/count/instantaneous/all", performance_counters::counter_raw,
               "returns the overall current number of HPX-threads instantiated at the "
               "referenced locality", HPX_PERFORMANCE_COUNTER_V1, counts_creator,
@@ -1164,6 +1275,35 @@ namespace hpx { namespace threads
               ""
             },
 #endif
+            { "/threads/count/stack-pool-hits", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks which were taken "
+              "from the stack pools of the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-pool-misses", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks which had to be "
+              "newly allocated as the stack pools of the referenced locality "
+              "were empty", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-pool-releases", performance_counters::counter_raw,
+              "returns the total number of HPX-thread stacks which were released "
+              "as the stack pools of the referenced locality were full",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stack-pool-reserved-bytes",
+              performance_counters::counter_raw,
+              "returns the current reserved size of the stacks held by the "
+              "stack pools of the referenced locality",
+              HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator, &performance_counters::locality_counter_discoverer,
+              "bytes"
+            },
             { "/threads/count/objects", performance_counters::counter_raw,
               "returns the overall number of created HPX-thread objects for "
               "the referenced locality", HPX_PERFORMANCE_COUNTER_V1,
@@ -1216,6 +1356,30 @@ namespace hpx { namespace threads
               &performance_counters::locality_thread_counter_discoverer,
               ""
             },
+            { "/threads/count/stolen-local", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen from cores sharing a cache with the stealing core (for "
+              "topology aware schedulers only)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-numa-local", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen from cores in the NUMA domain of the stealing core (for "
+              "topology aware schedulers only)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
+            { "/threads/count/stolen-remote", performance_counters::counter_raw,
+              "returns the overall number of HPX-threads and task descriptions "
+              "stolen from cores in other NUMA domains (for topology aware "
+              "schedulers only)", HPX_PERFORMANCE_COUNTER_V1,
+              counts_creator,
+              &performance_counters::locality_thread_counter_discoverer,
+              ""
+            },
 #endif
             // scheduler utilization
             { "/scheduler/utilization/instantaneous", performance_counters::counter_raw,
@@ -1429,6 +1593,10 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::threads::threadmanager_impl<
@@ -1449,3 +1617,9 @@ template class HPX_EXPORT hpx::threads::threadmanager_impl<
     hpx::threads::policies::periodic_priority_queue_scheduler<> >;
 #endif
 
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_priority_queue_scheduler.hpp>
+template class HPX_EXPORT hpx::threads::threadmanager_impl<
+    hpx::threads::policies::numa_priority_queue_scheduler<> >;
+#endif
+
@@ -69,6 +69,20 @@ namespace hpx { namespace threads
         return (!any(res)) ? machine_mask : res;
     }
 
+    mask_cref_type topology::get_cache_affinity_mask(std::size_t num_thread,
+        bool numa_sensitive, error_code& ec) const
+    {
+        // without any further knowledge, assume that only the processing
+        // units of a core share their caches
+        return this->get_core_affinity_mask(num_thread, numa_sensitive, ec);
+    }
+
+    std::size_t topology::get_numa_node_distance(std::size_t numa_node1,
+        std::size_t numa_node2) const
+    {
+        return (numa_node1 == numa_node2) ? 10 : 20;
+    }
+
     bool topology::reduce_thread_priority(error_code& ec) const
     {
 #ifdef HPX_HAVE_NICE_THREADLEVEL
@@ -876,6 +876,10 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::local_priority_queue_scheduler<
         boost::mutex, hpx::threads::policies::lockfree_lifo
     > >;
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::local_priority_queue_scheduler<
+        boost::mutex, hpx::threads::policies::lockfree_chase_lev
+    > >;
 
 #if defined(HPX_HAVE_ABP_SCHEDULER)
 template class HPX_EXPORT hpx::runtime_impl<
@@ -896,3 +900,9 @@ template class HPX_EXPORT hpx::runtime_impl<
     hpx::threads::policies::periodic_priority_queue_scheduler<> >;
 #endif
 
+#if defined(HPX_HAVE_NUMA_PRIORITY_SCHEDULER)
+#include <hpx/runtime/threads/policies/numa_priority_queue_scheduler.hpp>
+template class HPX_EXPORT hpx::runtime_impl<
+    hpx::threads::policies::numa_priority_queue_scheduler<> >;
+#endif
+
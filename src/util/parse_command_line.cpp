@@ -450,9 +450,11 @@ namespace hpx { namespace util
                 ("hpx:queuing", value<std::string>(),
                   "the queue scheduling policy to use, options are "
                   "'local', 'local-priority-fifo','local-priority-lifo', "
+                  "'local-priority-chase-lev', "
                   "'abp-priority', "
-                  "'hierarchy', 'static', 'static-priority', and "
-                  "'periodic-priority' (default: 'local-priority'; "
+                  "'hierarchy', 'static', 'static-priority', "
+                  "'periodic-priority', and 'numa-priority' "
+                  "(default: 'local-priority'; "
                   "all option values can be abbreviated)")
                 ("hpx:hierarchy-arity", value<std::size_t>(),
                   "the arity of the of the thread queue tree, valid for "
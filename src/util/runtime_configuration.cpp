@@ -193,6 +193,12 @@ namespace hpx { namespace util
                 BOOST_STRINGIZE(HPX_IDLE_LOOP_COUNT_MAX) "}",
             "max_busy_loop_count = ${HPX_MAX_BUSY_LOOP_COUNT:"
                 BOOST_STRINGIZE(HPX_BUSY_LOOP_COUNT_MAX) "}",
+            "idle_spin_count = ${HPX_IDLE_SPIN_COUNT:"
+                BOOST_STRINGIZE(HPX_IDLE_BACKOFF_SPIN_COUNT) "}",
+            "idle_yield_count = ${HPX_IDLE_YIELD_COUNT:"
+                BOOST_STRINGIZE(HPX_IDLE_BACKOFF_YIELD_COUNT) "}",
+            "max_idle_backoff_time = ${HPX_MAX_IDLE_BACKOFF_TIME:"
+                BOOST_STRINGIZE(HPX_IDLE_BACKOFF_TIME_MAX) "}",
 
             // arity for collective operations implemented in a tree fashion
             "[hpx.lcos.collectives]",
@@ -221,6 +227,8 @@ namespace hpx { namespace util
 #if defined(__linux) || defined(linux) || defined(__linux__) || defined(__FreeBSD__)
             "use_guard_pages = ${HPX_USE_GUARD_PAGES:1}",
 #endif
+            "pool_max_reserved_size = "
+                "${HPX_STACKS_POOL_MAX_RESERVED_SIZE:67108864}",
 
             "[hpx.threadpools]",
             "io_pool_size = ${HPX_NUM_IO_POOL_SIZE:"
@@ -238,6 +246,8 @@ namespace hpx { namespace util
             "min_add_new_count = ${HPX_THREAD_QUEUE_MIN_ADD_NEW_COUNT:10}",
             "max_add_new_count = ${HPX_THREAD_QUEUE_MAX_ADD_NEW_COUNT:10}",
             "max_delete_count = ${HPX_THREAD_QUEUE_MAX_DELETE_COUNT:1000}",
+            "thread_map_shards = ${HPX_THREAD_QUEUE_THREAD_MAP_SHARDS:16}",
+            "numa_steal_delay = ${HPX_THREAD_QUEUE_NUMA_STEAL_DELAY:16}",
 
             "[hpx.commandline]",
             // enable aliasing
@@ -1021,6 +1031,11 @@ namespace hpx { namespace util
         case threads::thread_stacksize_huge:
             return huge_stacksize;
 
+        // stackless threads do not have a stack size of their own, the enum
+        // value is used as a marker instead
+        case threads::thread_stacksize_nostack:
+            return threads::thread_stacksize_nostack;
+
         default:
         case threads::thread_stacksize_small:
             break;
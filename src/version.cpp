@@ -160,6 +160,11 @@ namespace hpx
 #else
         strm << "  HPX_HAVE_COMPRESSION_BZIP2=OFF\n";
 #endif
+#if defined(HPX_HAVE_COMPRESSION_LZ4)
+        strm << "  HPX_HAVE_COMPRESSION_LZ4=ON\n";
+#else
+        strm << "  HPX_HAVE_COMPRESSION_LZ4=OFF\n";
+#endif
 #if defined(HPX_HAVE_COMPRESSION_SNAPPY)
         strm << "  HPX_HAVE_COMPRESSION_SNAPPY=ON\n";
 #else
@@ -11,6 +11,8 @@
 #include <hpx/hpx.hpp>
 #include <hpx/hpx_init.hpp>
 
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/gva_cache.hpp>
 #include <hpx/util/cache/entries/lfu_entry.hpp>
 #include <hpx/util/cache/local_cache.hpp>
 #include <hpx/util/cache/statistics/local_full_statistics.hpp>
@@ -25,6 +27,7 @@
 #include <cstdint>
 #include <iostream>
 #include <map>
+#include <mutex>
 #include <string>
 #include <utility>
 #include <vector>
@@ -214,6 +217,101 @@ void test_update(gva_cache_type& cache, hpx::naming::gid_type first_key)
     calculate_histogram("update", timings);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Measure the throughput of cache hits while all worker threads look up
+// entries concurrently, once for the original cache protected by a single
+// lock and once for the sharded cache used by AGAS today.
+template <typename Lookup>
+double measure_concurrent_hits(Lookup lookup, hpx::naming::gid_type first_key,
+    std::size_t num_entries, std::size_t num_lookups)
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+
+    std::vector<hpx::future<void> > lookups;
+    lookups.reserve(num_threads);
+
+    std::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        lookups.push_back(hpx::async(
+            [=]()
+            {
+                for (std::size_t j = 0; j != num_lookups; ++j)
+                {
+                    // every thread walks through all entries, starting at
+                    // a different one
+                    std::size_t const n = (i * num_entries / num_threads + j)
+                        % num_entries;
+                    lookup(gva_cache_key(first_key + (n + 1), 1));
+                }
+            }));
+    }
+    hpx::wait_all(lookups);
+
+    std::uint64_t const elapsed = hpx::util::high_resolution_clock::now() - t;
+    return double(num_threads * num_lookups) / (elapsed * 1e-9);
+}
+
+void test_concurrent_hits(hpx::naming::gid_type first_key,
+    std::size_t cache_size, std::size_t num_entries, std::size_t num_lookups)
+{
+    hpx::naming::gid_type locality = hpx::get_locality();
+    std::uint32_t ct = hpx::components::component_invalid;
+
+    // the original cache, all accesses are serialized
+    typedef hpx::lcos::local::spinlock mutex_type;
+
+    gva_cache_type cache;
+    cache.reserve(cache_size);
+    mutex_type mtx;
+
+    // the sharded cache
+    hpx::agas::gva_cache sharded_cache(cache_size);
+
+    hpx::naming::gid_type key = first_key;
+    for (std::size_t i = 0; i != num_entries; ++i)
+    {
+        hpx::agas::gva value(locality, ct, 1, std::uint64_t(0), 0);
+
+        ++key;
+        cache.insert(gva_cache_key(key, 1), value);
+        sharded_cache.update_if(hpx::agas::gva_cache_key(key), value,
+            [](hpx::agas::gva_cache_key const&,
+                hpx::agas::gva_cache_key const&)
+            {
+                return false;
+            });
+    }
+
+    double locked = measure_concurrent_hits(
+        [&](gva_cache_key const& k)
+        {
+            gva_cache_key idbase;
+            gva_cache_type::entry_type e;
+
+            std::lock_guard<mutex_type> l(mtx);
+            cache.get_entry(k, idbase, e);
+        },
+        first_key, num_entries, num_lookups);
+
+    double sharded = measure_concurrent_hits(
+        [&](gva_cache_key const& k)
+        {
+            hpx::agas::gva_cache_key idbase;
+            hpx::agas::gva e;
+
+            sharded_cache.get_entry(
+                hpx::agas::gva_cache_key(k.get_gid()), idbase, e);
+        },
+        first_key, num_entries, num_lookups);
+
+    std::cout << "concurrent hits (" << hpx::get_os_thread_count()
+              << " threads): single lock: " << locked
+              << " lookups/s, sharded: " << sharded << " lookups/s"
+              << std::endl;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -225,6 +323,10 @@ int hpx_main(boost::program_options::variables_map& vm)
     if (vm.count("num_entries"))
         num_entries = vm["num_entries"].as<std::size_t>();
 
+    std::size_t num_lookups = 100000;
+    if (vm.count("num_lookups"))
+        num_lookups = vm["num_lookups"].as<std::size_t>();
+
     gva_cache_type cache;
     cache.reserve(cache_size);
 
@@ -234,6 +336,9 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_get(cache, first_key);
     test_update(cache, first_key);
 
+    test_concurrent_hits(hpx::detail::get_next_id(), cache_size,
+        num_entries, num_lookups);
+
     return hpx::finalize();
 }
 
@@ -249,6 +354,8 @@ int main(int argc, char* argv[])
          BOOST_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE_PER_THREAD) ")")
         ("num_entries,n", value<std::size_t>(),
          "number of items to insert into cache (default: 1000)")
+        ("num_lookups", value<std::size_t>(),
+         "number of concurrent lookups per thread (default: 100000)")
         ;
 
     // Initialize and run HPX
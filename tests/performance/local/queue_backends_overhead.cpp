@@ -0,0 +1,286 @@
+////////////////////////////////////////////////////////////////////////////////
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+////////////////////////////////////////////////////////////////////////////////
+
+// Compares the queue backends usable as the PendingQueuing policy of the
+// thread queues. Each backend is measured twice: the owner pushing and
+// popping blocks of items on its own, and the owner doing the same while all
+// other threads are concurrently trying to steal from the queue.
+
+// Makes HPX use BOOST_ASSERT, so that I can use high_resolution_timer without
+// depending on the rest of HPX.
+#define HPX_USE_BOOST_ASSERT
+
+#include <hpx/runtime/threads/policies/lockfree_queue_backends.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/thread/thread.hpp>
+
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+char const* benchmark_name = "Thread Queue Backend Overhead";
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+using boost::program_options::store;
+using boost::program_options::command_line_parser;
+using boost::program_options::notify;
+
+using hpx::util::high_resolution_timer;
+
+namespace policies = hpx::threads::policies;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t threads = 1;
+std::uint64_t blocksize = 10000;
+std::uint64_t iterations = 2000000;
+bool header = true;
+
+///////////////////////////////////////////////////////////////////////////////
+struct results
+{
+    results()
+      : push_(0.0), pop_(0.0), contended_push_(0.0), contended_pop_(0.0),
+        stolen_(0)
+    {}
+
+    double push_;
+    double pop_;
+    double contended_push_;
+    double contended_pop_;
+    std::uint64_t stolen_;
+};
+
+void print_header()
+{
+    std::cout << "# BENCHMARK: " << benchmark_name << "\n"
+              << "#\n";
+
+    std::cout <<
+        "## 0:BACKEND:Queue backend - Independent Variable\n"
+        "## 1:ITER:Iterations - Independent Variable\n"
+        "## 2:BSIZE:Maximum Queue Depth - Independent Variable\n"
+        "## 3:OSTHRDS:OS-threads (owner plus thieves) - Independent Variable\n"
+        "## 4:WTIME_PUSH:Walltime/Push, uncontended [nanoseconds]\n"
+        "## 5:WTIME_POP:Walltime/Pop, uncontended [nanoseconds]\n"
+        "## 6:WTIME_PUSH_STEAL:Walltime/Push, with thieves [nanoseconds]\n"
+        "## 7:WTIME_POP_STEAL:Walltime/Pop, with thieves [nanoseconds]\n"
+        "## 8:STOLEN:Items stolen by thieves [percent]\n"
+        ;
+}
+
+void print_results(char const* name, results const& r)
+{
+    std::cout << ( boost::format("%s %lu %lu %lu %.14g %.14g %.14g %.14g %.4g\n")
+            % name
+            % iterations
+            % blocksize
+            % threads
+            % ((r.push_ / iterations) * 1e9)
+            % ((r.pop_ / iterations) * 1e9)
+            % ((r.contended_push_ / iterations) * 1e9)
+            % ((r.contended_pop_ / iterations) * 1e9)
+            % ((100.0 * r.stolen_) / iterations)
+            );
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The owner pushes a block of items and pops them again (without stealing)
+// until the queue has run empty.
+template <typename Queue>
+std::pair<double, double>
+bench_owner(Queue& q, std::uint64_t local_iterations)
+{
+    std::pair<double, double> elapsed(0.0, 0.0);
+    std::uint64_t seed = 42;
+
+    high_resolution_timer t;
+
+    for ( std::uint64_t block = 0
+        ; block < (local_iterations / blocksize)
+        ; ++block)
+    {
+        t.restart();
+
+        for (std::uint64_t i = 0; i < blocksize; ++i)
+        {
+            q.push(seed);
+        }
+
+        elapsed.first += t.elapsed();
+
+        t.restart();
+
+        std::uint64_t val = 0;
+        while (q.pop(val, false))
+            ;
+
+        elapsed.second += t.elapsed();
+    }
+
+    return elapsed;
+}
+
+template <typename Queue>
+void steal_from(Queue& q, boost::barrier& b, boost::atomic<bool>& done,
+    boost::atomic<std::uint64_t>& stolen)
+{
+    b.wait();
+
+    std::uint64_t count = 0;
+    std::uint64_t val = 0;
+    while (!done.load(boost::memory_order_relaxed))
+    {
+        if (q.pop(val, true))
+            ++count;
+    }
+
+    stolen += count;
+}
+
+template <typename Policy>
+results bench_backend()
+{
+    typedef typename Policy::template apply<std::uint64_t>::type queue_type;
+
+    results r;
+
+    {
+        queue_type q(blocksize);
+
+        // the owner of a queue is the first thread popping without stealing
+        std::uint64_t val = 0;
+        q.pop(val, false);
+
+        // Warmup.
+        bench_owner(q, blocksize);
+
+        std::pair<double, double> elapsed = bench_owner(q, iterations);
+        r.push_ = elapsed.first;
+        r.pop_ = elapsed.second;
+    }
+
+    {
+        queue_type q(blocksize);
+
+        std::uint64_t val = 0;
+        q.pop(val, false);
+
+        boost::atomic<bool> done(false);
+        boost::atomic<std::uint64_t> stolen(0);
+        boost::barrier b(threads);
+
+        boost::thread_group thieves;
+        for (std::uint64_t i = 1; i < threads; ++i)
+        {
+            thieves.add_thread(new boost::thread(
+                steal_from<queue_type>, std::ref(q), std::ref(b),
+                std::ref(done), std::ref(stolen)));
+        }
+
+        b.wait();
+
+        std::pair<double, double> elapsed = bench_owner(q, iterations);
+        r.contended_push_ = elapsed.first;
+        r.contended_pop_ = elapsed.second;
+
+        done.store(true);
+        thieves.join_all();
+
+        r.stolen_ = stolen.load();
+    }
+
+    return r;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int app_main(variables_map& vm)
+{
+    if (header)
+        print_header();
+
+    print_results("lockfree_fifo", bench_backend<policies::lockfree_fifo>());
+    print_results("lockfree_lifo", bench_backend<policies::lockfree_lifo>());
+#if defined(HPX_HAVE_ABP_SCHEDULER)
+    print_results("lockfree_abp_fifo",
+        bench_backend<policies::lockfree_abp_fifo>());
+    print_results("lockfree_abp_lifo",
+        bench_backend<policies::lockfree_abp_lifo>());
+#endif
+    print_results("lockfree_chase_lev",
+        bench_backend<policies::lockfree_chase_lev>());
+    print_results("lockfree_staged_ring",
+        bench_backend<policies::lockfree_staged_ring>());
+
+    return 0;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Parse command line.
+    variables_map vm;
+
+    options_description cmdline("Usage: queue_backends_overhead [options]");
+
+    cmdline.add_options()
+        ( "help,h"
+        , "print out program usage (this message)")
+
+        ( "threads,t"
+        , value<std::uint64_t>(&threads)->default_value(1)
+        , "number of threads to use (one owner, all others are stealing)")
+
+        ( "iterations"
+        , value<std::uint64_t>(&iterations)->default_value(2000000)
+        , "number of iterations to perform (most be divisible by block size)")
+
+        ( "blocksize"
+        , value<std::uint64_t>(&blocksize)->default_value(10000)
+        , "size of each block")
+
+        ( "no-header"
+        , "do not print out the header")
+        ;
+
+    store(command_line_parser(argc, argv).options(cmdline).run(), vm);
+
+    notify(vm);
+
+    // Print help screen.
+    if (vm.count("help"))
+    {
+        std::cout << cmdline;
+        return 0;
+    }
+
+    if (iterations % blocksize)
+        throw std::invalid_argument(
+            "iterations must be cleanly divisable by blocksize\n");
+
+    if (threads == 0)
+        throw std::invalid_argument("at least one thread is required\n");
+
+    if (vm.count("no-header"))
+        header = false;
+
+    return app_main(vm);
+}
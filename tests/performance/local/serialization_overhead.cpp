@@ -31,6 +31,15 @@ int test_function(hpx::serialization::serialize_buffer<double> const& b)
 }
 HPX_PLAIN_ACTION(test_function, test_action)
 
+// This function will never be called either, its arguments are bitwise
+// serializable and are saved with a single copy (unless the array
+// optimization is disabled: --hpx:ini=hpx.parcel.array_optimization=0)
+int small_test_function(double d, std::int64_t i, float f, std::uint32_t u)
+{
+    return 42;
+}
+HPX_PLAIN_ACTION(small_test_function, small_test_action)
+
 std::size_t get_archive_size(hpx::parcelset::parcel const& p,
     std::uint32_t flags,
     std::vector<hpx::serialization::serialization_chunk>* chunks)
@@ -44,13 +53,40 @@ std::size_t get_archive_size(hpx::parcelset::parcel const& p,
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-double benchmark_serialization(std::size_t data_size, std::size_t iterations,
-    bool continuation, bool zerocopy)
+template <typename Action, typename F, typename ...Ts>
+hpx::parcelset::parcel create_parcel(bool continuation, F* f, Ts const&... vs)
 {
     hpx::naming::id_type const here = hpx::find_here();
     hpx::naming::address addr(hpx::get_locality(),
         hpx::components::component_invalid,
-        reinterpret_cast<std::uint64_t>(&test_function));
+        reinterpret_cast<std::uint64_t>(f));
+
+    // create a parcel with/without continuation
+    hpx::parcelset::parcel p;
+    hpx::naming::gid_type dest = here.get_gid();
+    if (continuation) {
+        p = hpx::parcelset::parcel(hpx::parcelset::detail::create_parcel::call(
+            std::true_type(),
+            std::move(dest), std::move(addr),
+            hpx::actions::typed_continuation<int>(here),
+            Action(), hpx::threads::thread_priority_normal, vs...
+            ));
+    }
+    else {
+        p = hpx::parcelset::parcel(hpx::parcelset::detail::create_parcel::call(
+            std::false_type(),
+            std::move(dest), std::move(addr),
+            Action(), hpx::threads::thread_priority_normal, vs...));
+    }
+
+    p.set_source_id(here);
+    return p;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+double benchmark_serialization(std::size_t data_size, std::size_t iterations,
+    bool continuation, bool zerocopy, bool small_args)
+{
 
     // compose archive flags
 #ifdef BOOST_BIG_ENDIAN
@@ -97,24 +133,14 @@ double benchmark_serialization(std::size_t data_size, std::size_t iterations,
 
     // create a parcel with/without continuation
     hpx::parcelset::parcel outp;
-    hpx::naming::gid_type dest = here.get_gid();
-    if (continuation) {
-        outp = hpx::parcelset::parcel(hpx::parcelset::detail::create_parcel::call(
-            std::true_type(),
-            std::move(dest), std::move(addr),
-            hpx::actions::typed_continuation<int>(here),
-            test_action(), hpx::threads::thread_priority_normal, buffer
-            ));
+    if (small_args) {
+        outp = create_parcel<small_test_action>(continuation,
+            &small_test_function, 1.0, std::int64_t(2), 3.0f, std::uint32_t(4));
     }
     else {
-        outp = hpx::parcelset::parcel(hpx::parcelset::detail::create_parcel::call(
-            std::false_type(),
-            std::move(dest), std::move(addr),
-            test_action(), hpx::threads::thread_priority_normal, buffer));
+        outp = create_parcel<test_action>(continuation, &test_function, buffer);
     }
 
-    outp.set_source_id(here);
-
     std::vector<hpx::serialization::serialization_chunk>* chunks = nullptr;
     if (zerocopy)
         chunks = new std::vector<hpx::serialization::serialization_chunk>();
@@ -164,13 +190,14 @@ int hpx_main(boost::program_options::variables_map& vm)
     bool print_header = vm.count("no-header") == 0;
     bool continuation = vm.count("continuation") != 0;
     bool zerocopy = vm.count("zerocopy") != 0;
+    bool small_args = vm.count("small") != 0;
 
     std::vector<hpx::future<double> > timings;
     for (std::size_t i = 0; i != concurrency; ++i)
     {
         timings.push_back(hpx::async(
             &benchmark_serialization, data_size, iterations,
-            continuation, zerocopy));
+            continuation, zerocopy, small_args));
     }
 
     double overall_time = 0;
@@ -211,6 +238,10 @@ int main(int argc, char* argv[])
         ( "zerocopy"
         , "use zero copy serialization of bitwise copyable arguments")
 
+        ( "small"
+        , "serialize an action taking a few scalar arguments instead of "
+          "the data buffer (--data_size is ignored)")
+
         ( "no-header"
         , "do not print out the csv header row")
         ;
@@ -8,6 +8,7 @@
 #include <hpx/include/actions.hpp>
 #include <hpx/components/iostreams/standard_streams.hpp>
 #include <hpx/lcos/local/detail/sliding_semaphore.hpp>
+#include <hpx/runtime/parcelset/receive_chunk.hpp>
 
 #include <boost/assert.hpp>
 #include <boost/atomic.hpp>
@@ -41,6 +42,9 @@
 //    2 Copy data into parcelport for transmission. (1 copy)
 //    3 Transmit data into remote parcelport buffer
 //    4 Copy data from parcelport into serialize_buffer (2 copy)
+//      (not needed anymore for parcelports which receive the zero-copy
+//      chunks into memory which the serialize_buffer can take over, the
+//      parcelport buffer can be taken from a pool, see --receive-pool)
 //    5 Copy data from serialize buffer into remote host storage (3 copy ?)
 //
 // Get data from remote memory
@@ -162,6 +166,60 @@ typedef struct {
     bool          nolocal;
 } test_options;
 
+//----------------------------------------------------------------------------
+// A pool of buffers the parcelport receives the zero-copy chunks into (see
+// hpx::parcelset::set_receive_chunk_allocator). The serialize_buffer argument
+// of CopyToStorage takes over the received buffer, which returns to the pool
+// once the action has finished.
+class receive_buffer_pool
+{
+public:
+    explicit receive_buffer_pool(std::size_t size)
+      : size_(size)
+    {}
+
+    ~receive_buffer_pool()
+    {
+        for (char* p : buffers_)
+            delete[] p;
+    }
+
+    std::shared_ptr<char> allocate(std::size_t size)
+    {
+        if (size != size_)
+            return std::shared_ptr<char>(new char[size],
+                std::default_delete<char[]>());
+
+        char* p = nullptr;
+        {
+            std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+            if (!buffers_.empty()) {
+                p = buffers_.back();
+                buffers_.pop_back();
+            }
+        }
+        if (p == nullptr)
+            p = new char[size_];
+
+        return std::shared_ptr<char>(p,
+            [this](char* p) { release(p); });
+    }
+
+private:
+    void release(char* p)
+    {
+        std::lock_guard<hpx::lcos::local::spinlock> l(mtx_);
+        buffers_.push_back(p);
+    }
+
+    hpx::lcos::local::spinlock mtx_;
+    std::vector<char*> buffers_;
+    std::size_t size_;
+};
+
+// outstanding buffers might be returned until the very end
+std::unique_ptr<receive_buffer_pool> receive_pool;
+
 //----------------------------------------------------------------------------
 void allocate_local_storage(uint64_t local_storage_bytes)
 {
@@ -918,6 +976,13 @@ int hpx_main(boost::program_options::variables_map& vm)
     options.semaphore         = vm["semaphore"].as<std::uint64_t>();
     options.warmup            = false;
 
+    if (vm["receive-pool"].as<bool>()) {
+        receive_pool.reset(new receive_buffer_pool(options.transfer_size_B));
+        hpx::parcelset::set_receive_chunk_allocator(
+            hpx::util::bind(&receive_buffer_pool::allocate,
+                receive_pool.get(), hpx::util::placeholders::_1));
+    }
+
     //
     if (options.global_storage_MB>0) {
       options.local_storage_MB = options.global_storage_MB/nranks;
@@ -958,6 +1023,8 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_read (rank, nranks, num_transfer_slots, gen, random_rank, random_slot, options);
     //
     delete_local_storage();
+    hpx::parcelset::set_receive_chunk_allocator(
+        hpx::parcelset::receive_chunk_allocator_type());
 
     DEBUG_OUTPUT(3, "Calling finalize " << rank);
     if (rank==0)
@@ -1021,6 +1088,13 @@ int main(int argc, char* argv[])
           "ranks send to the others but not to themselves.\n")
         ;
 
+    desc_commandline.add_options()
+        ( "receive-pool",
+          boost::program_options::value<bool>()->default_value(false),
+          "When set, the parcelport receives the transferred blocks into "
+          "buffers taken from a pool.\n")
+        ;
+
     // if the user does not set parceltype on the command line,
     // we use a default of unknowm so we don't mistake plots
     desc_commandline.add_options()
@@ -0,0 +1,117 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the ids of actions are assigned in the order of
+// their type-names (as relied upon by HPX_WITH_STATIC_ACTION_IDS) and that
+// the checksum of the action table identifies the assigned ids.
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/detail/action_factory.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using hpx::actions::detail::action_registry;
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::actions::base_action* create_action(bool)
+{
+    return nullptr;
+}
+
+void register_actions(action_registry& registry,
+    std::vector<std::string> const& typenames,
+    std::vector<std::uint32_t>& ids)
+{
+    ids.resize(typenames.size(), action_registry::invalid_id);
+    for (std::size_t i = 0; i != typenames.size(); ++i)
+        registry.register_factory(typenames[i], &create_action, &ids[i]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_ordering()
+{
+    action_registry registry1;
+    std::vector<std::uint32_t> ids1;
+    register_actions(registry1, {"c_action", "a_action", "b_action"}, ids1);
+
+    action_registry registry2;
+    std::vector<std::uint32_t> ids2;
+    register_actions(registry2, {"b_action", "c_action", "a_action"}, ids2);
+
+    registry1.fill_missing_typenames();
+    registry2.fill_missing_typenames();
+
+    // the ids depend only on the set of registered actions
+    HPX_TEST_EQ(registry1.try_get_id("a_action"), std::uint32_t(1));
+    HPX_TEST_EQ(registry1.try_get_id("b_action"), std::uint32_t(2));
+    HPX_TEST_EQ(registry1.try_get_id("c_action"), std::uint32_t(3));
+
+    HPX_TEST_EQ(registry2.try_get_id("a_action"), std::uint32_t(1));
+    HPX_TEST_EQ(registry2.try_get_id("b_action"), std::uint32_t(2));
+    HPX_TEST_EQ(registry2.try_get_id("c_action"), std::uint32_t(3));
+
+    HPX_TEST_EQ(registry1.try_get_id("d_action"), action_registry::invalid_id);
+
+    // the ids are cached for each registered action type
+    HPX_TEST_EQ(ids1[0], std::uint32_t(3));
+    HPX_TEST_EQ(ids1[1], std::uint32_t(1));
+    HPX_TEST_EQ(ids1[2], std::uint32_t(2));
+
+    HPX_TEST_EQ(ids2[0], std::uint32_t(2));
+    HPX_TEST_EQ(ids2[1], std::uint32_t(3));
+    HPX_TEST_EQ(ids2[2], std::uint32_t(1));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_checksum()
+{
+    action_registry registry1;
+    std::vector<std::uint32_t> ids1;
+    register_actions(registry1, {"a_action", "b_action", "c_action"}, ids1);
+    registry1.fill_missing_typenames();
+
+    // the same actions registered in a different order
+    action_registry registry2;
+    std::vector<std::uint32_t> ids2;
+    register_actions(registry2, {"c_action", "b_action", "a_action"}, ids2);
+    registry2.fill_missing_typenames();
+
+    HPX_TEST_EQ(registry1.get_checksum(), registry2.get_checksum());
+
+    // a different set of actions
+    action_registry registry3;
+    std::vector<std::uint32_t> ids3;
+    register_actions(registry3, {"a_action", "b_action", "d_action"}, ids3);
+    registry3.fill_missing_typenames();
+
+    HPX_TEST_NEQ(registry1.get_checksum(), registry3.get_checksum());
+
+    // the same actions with different ids
+    action_registry registry4;
+    registry4.register_typename("b_action", 1);
+
+    std::vector<std::uint32_t> ids4;
+    register_actions(registry4, {"a_action", "b_action", "c_action"}, ids4);
+    registry4.fill_missing_typenames();
+
+    HPX_TEST_EQ(ids4[0], std::uint32_t(2));
+    HPX_TEST_EQ(ids4[1], std::uint32_t(1));
+    HPX_TEST_EQ(ids4[2], std::uint32_t(3));
+
+    HPX_TEST_NEQ(registry1.get_checksum(), registry4.get_checksum());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_ordering();
+    test_checksum();
+
+    return hpx::util::report_errors();
+}
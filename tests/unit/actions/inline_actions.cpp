@@ -0,0 +1,186 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies the execution of (remote) actions directly on the thread
+// decoding the parcel (hpx.parcel.inline_actions).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/runtime/actions/detail/inline_execution.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using hpx::actions::detail::inline_execution_data;
+using hpx::actions::detail::measure_execution;
+
+///////////////////////////////////////////////////////////////////////////////
+int fast(int i)
+{
+    return i + 1;
+}
+HPX_PLAIN_ACTION(fast, fast_action);
+
+int suspending(int i)
+{
+    hpx::this_thread::yield();
+    return hpx::async(&fast, i).get();
+}
+HPX_PLAIN_ACTION(suspending, suspending_action);
+
+int throwing(int)
+{
+    throw std::runtime_error("throwing");
+    return 0;
+}
+HPX_PLAIN_ACTION(throwing, throwing_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void busy_wait(std::uint64_t nanoseconds)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+    while (hpx::util::high_resolution_clock::now() - start < nanoseconds)
+        /**/;
+}
+
+void test_classification()
+{
+    std::int64_t const samples =
+        hpx::actions::detail::inline_execution_samples();
+    std::int64_t const threshold =
+        hpx::actions::detail::inline_execution_threshold();
+
+    // an action qualifies after enough fast invocations
+    {
+        inline_execution_data data;
+        for (std::int64_t i = 0; i != samples; ++i)
+        {
+            HPX_TEST(!data.is_inline_safe());
+            measure_execution(data, [](){});
+        }
+        HPX_TEST(data.is_inline_safe());
+    }
+
+    // a slow invocation restarts the classification
+    {
+        inline_execution_data data;
+        for (std::int64_t i = 0; i != samples - 1; ++i)
+            measure_execution(data, [](){});
+
+        measure_execution(data,
+            [threshold]() { busy_wait(std::uint64_t(2 * threshold)); });
+        HPX_TEST(!data.is_inline_safe());
+
+        for (std::int64_t i = 0; i != samples; ++i)
+            measure_execution(data, [](){});
+        HPX_TEST(data.is_inline_safe());
+    }
+
+    // an action which suspends is never run inline again
+    {
+        inline_execution_data data;
+        for (std::int64_t i = 0; i != samples; ++i)
+            measure_execution(data, [](){});
+        HPX_TEST(data.is_inline_safe());
+
+        measure_execution(data, []() { hpx::this_thread::yield(); });
+        HPX_TEST(!data.is_inline_safe());
+
+        for (std::int64_t i = 0; i != samples; ++i)
+            measure_execution(data, [](){});
+        HPX_TEST(!data.is_inline_safe());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_remote(hpx::id_type const& id)
+{
+    std::size_t const count = 100;
+
+    // fast actions are run inline once they are classified
+    {
+        std::vector<hpx::future<int> > results;
+        results.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+            results.push_back(hpx::async<fast_action>(id, int(i)));
+
+        for (std::size_t i = 0; i != count; ++i)
+            HPX_TEST_EQ(results[i].get(), int(i) + 1);
+    }
+
+    // actions which suspend still complete
+    {
+        std::vector<hpx::future<int> > results;
+        results.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+            results.push_back(hpx::async<suspending_action>(id, int(i)));
+
+        for (std::size_t i = 0; i != count; ++i)
+            HPX_TEST_EQ(results[i].get(), int(i) + 1);
+    }
+
+    // exceptions are delivered to the caller
+    {
+        std::vector<hpx::future<int> > results;
+        results.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+            results.push_back(hpx::async<throwing_action>(id, int(i)));
+
+        std::size_t exceptions = 0;
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            try {
+                results[i].get();
+            }
+            catch (std::exception const&) {
+                ++exceptions;
+            }
+        }
+        HPX_TEST_EQ(exceptions, count);
+    }
+
+    // the decoding thread is not blocked by actions applied without a
+    // continuation
+    for (std::size_t i = 0; i != count; ++i)
+        hpx::apply<suspending_action>(id, int(i));
+
+    HPX_TEST_EQ(hpx::async<fast_action>(id, 41).get(), 42);
+}
+
+int hpx_main()
+{
+    test_classification();
+
+    for (hpx::id_type const& id : hpx::find_remote_localities())
+        test_remote(id);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Classify actions after a few invocations only, allow for slow
+    // machines when deciding whether an action is fast.
+    std::vector<std::string> const cfg = {
+        "hpx.parcel.inline_actions! = 1",
+        "hpx.parcel.inline_actions_samples! = 4",
+        "hpx.parcel.inline_actions_threshold! = 1000000"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
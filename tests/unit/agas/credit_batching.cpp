@@ -0,0 +1,197 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that credit increments for remote ids, which are
+// combined with each other and with flushed decrements before being sent to
+// the primary namespace, keep objects alive and release them afterwards.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/plain_actions.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <tests/unit/agas/components/simple_refcnt_checker.hpp>
+#include <tests/unit/agas/components/managed_refcnt_checker.hpp>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using std::chrono::milliseconds;
+
+using hpx::naming::id_type;
+using hpx::naming::gid_type;
+
+using hpx::components::get_component_type;
+
+using hpx::agas::garbage_collect;
+
+using hpx::test::simple_refcnt_monitor;
+using hpx::test::managed_refcnt_monitor;
+
+///////////////////////////////////////////////////////////////////////////////
+// Helper functions.
+std::vector<hpx::future<std::int64_t> > incref(id_type const& id,
+    std::size_t count)
+{
+    std::vector<hpx::future<std::int64_t> > increfs;
+    increfs.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        increfs.push_back(hpx::agas::incref(id.get_gid(), 1, id));
+    return increfs;
+}
+
+void decref(id_type const& id, std::size_t count)
+{
+    for (std::size_t i = 0; i != count; ++i)
+        hpx::agas::decref(id.get_gid(), 1);
+}
+
+// Returns the sum of the credits compensated by pending decrements.
+std::int64_t wait_for(std::vector<hpx::future<std::int64_t> >& increfs)
+{
+    std::int64_t compensated = 0;
+    for (hpx::future<std::int64_t>& f : increfs)
+        compensated += f.get();
+    return compensated;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// All increments are issued before the thread sending them runs, they are
+// sent as a single message.
+std::int64_t incref_decref(id_type const& id, std::size_t count)
+{
+    std::vector<hpx::future<std::int64_t> > increfs = incref(id, count);
+    std::int64_t compensated = wait_for(increfs);
+
+    decref(id, count);
+    garbage_collect();
+
+    return compensated;
+}
+HPX_PLAIN_ACTION(incref_decref);
+
+// Pending increments are sent along with the decrements flushed by the
+// garbage collection.
+std::int64_t incref_with_decref(id_type const& incref_id,
+    id_type const& decref_id, std::size_t count)
+{
+    std::vector<hpx::future<std::int64_t> > increfs = incref(decref_id, count);
+    std::int64_t compensated = wait_for(increfs);
+
+    increfs = incref(incref_id, count);
+    decref(decref_id, count);
+    garbage_collect();
+
+    compensated += wait_for(increfs);
+
+    decref(incref_id, count);
+    garbage_collect();
+
+    return compensated;
+}
+HPX_PLAIN_ACTION(incref_with_decref);
+
+///////////////////////////////////////////////////////////////////////////////
+template <
+    typename Client
+>
+void hpx_test_main(
+    variables_map& vm
+    )
+{
+    std::uint64_t const delay = vm["delay"].as<std::uint64_t>();
+    std::size_t const count = vm["count"].as<std::size_t>();
+
+    typedef typename Client::server_type server_type;
+
+    std::vector<id_type> remote_localities =
+        hpx::find_remote_localities(get_component_type<server_type>());
+
+    if (remote_localities.empty())
+        throw std::logic_error("this test cannot be run on one locality");
+
+    id_type const here = hpx::find_here();
+
+    Client monitor0(here);
+    Client monitor1(here);
+
+    {
+        id_type id0 = monitor0.detach().get();
+        id_type id1 = monitor1.detach().get();
+
+        // none of the increments was compensated by a pending decrement
+        HPX_TEST_EQ(hpx::async<incref_decref_action>(
+            remote_localities[0], id0, count).get(), 0);
+        HPX_TEST_EQ(hpx::async<incref_with_decref_action>(
+            remote_localities[0], id0, id1, count).get(), 0);
+
+        // Flush pending reference counting operations.
+        garbage_collect();
+        garbage_collect(remote_localities[0]);
+
+        // The components are still referenced.
+        HPX_TEST_EQ(false, monitor0.is_ready(milliseconds(delay)));
+        HPX_TEST_EQ(false, monitor1.is_ready(milliseconds(delay)));
+    }
+
+    // Flush pending reference counting operations.
+    garbage_collect();
+    garbage_collect(remote_localities[0]);
+    garbage_collect();
+    garbage_collect(remote_localities[0]);
+
+    // The components should be out of scope now.
+    HPX_TEST_EQ(true, monitor0.is_ready(milliseconds(delay)));
+    HPX_TEST_EQ(true, monitor1.is_ready(milliseconds(delay)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(
+    variables_map& vm
+    )
+{
+    hpx_test_main<simple_refcnt_monitor>(vm);
+    hpx_test_main<managed_refcnt_monitor>(vm);
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main(
+    int argc
+  , char* argv[]
+    )
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "delay"
+        , value<std::uint64_t>()->default_value(1000)
+        , "number of milliseconds to wait for object destruction")
+        ( "count"
+        , value<std::size_t>()->default_value(100)
+        , "number of credit increments to combine")
+        ;
+
+    // We need to explicitly enable the test components used by this test.
+    std::vector<std::string> const cfg = {
+        "hpx.components.simple_refcnt_checker.enabled! = 1",
+        "hpx.components.managed_refcnt_checker.enabled! = 1"
+    };
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv, cfg);
+}
@@ -0,0 +1,169 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that combined credit requests survive the delta and
+// variable length encoding used on the wire, and that malformed messages are
+// rejected.
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/runtime/agas/credit_requests.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+using hpx::agas::credit_requests;
+using hpx::naming::gid_type;
+
+typedef std::vector<std::pair<gid_type, std::int64_t> > requests_type;
+
+///////////////////////////////////////////////////////////////////////////////
+requests_type round_trip(requests_type const& in)
+{
+    credit_requests requests;
+    for (requests_type::const_reference r : in)
+        requests.add(r.first, r.second);
+
+    std::vector<char> buffer;
+    {
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << requests;
+    }
+
+    credit_requests result;
+    {
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> result;
+    }
+
+    return requests_type(result.begin(), result.end());
+}
+
+void test_round_trip(requests_type in)
+{
+    requests_type out = round_trip(in);
+
+    // the requests are sorted by id on the wire
+    std::sort(in.begin(), in.end());
+    std::sort(out.begin(), out.end());
+
+    HPX_TEST(in == out);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_ids()
+{
+    std::uint64_t const max_value = (std::numeric_limits<std::uint64_t>::max)();
+
+    test_round_trip(requests_type());
+
+    // ids allocated close to each other
+    {
+        requests_type in;
+        for (std::uint64_t i = 0; i != 100; ++i)
+            in.push_back(std::make_pair(gid_type(1, 1000 + 3 * i), 1));
+        test_round_trip(in);
+    }
+
+    // the lsb decreases when the msb changes, the same id is given twice
+    test_round_trip({
+        std::make_pair(gid_type(1, max_value), 1),
+        std::make_pair(gid_type(2, 0), 1),
+        std::make_pair(gid_type(2, 0), 2),
+        std::make_pair(gid_type(2, 127), 1),
+        std::make_pair(gid_type(2, 128), 1),
+        std::make_pair(gid_type(3, 1), 1),
+        std::make_pair(gid_type(gid_type::locality_id_mask, max_value), 1)
+    });
+
+    // the order of the requests doesn't matter
+    test_round_trip({
+        std::make_pair(gid_type(7, 5), 1),
+        std::make_pair(gid_type(1, 9), 1),
+        std::make_pair(gid_type(7, 2), 1),
+        std::make_pair(gid_type(0, 3), 1)
+    });
+}
+
+void test_credits()
+{
+    std::int64_t const max_credit = (std::numeric_limits<std::int64_t>::max)();
+    std::int64_t const min_credit = (std::numeric_limits<std::int64_t>::min)();
+
+    // values at the boundaries of the encoded byte counts
+    std::int64_t const credits[] = {
+        1, -1, 63, -64, 64, -65, 8191, -8192, 8192, -8193,
+        std::int64_t(1) << 32, -(std::int64_t(1) << 32),
+        max_credit, min_credit
+    };
+
+    requests_type in;
+    std::uint64_t lsb = 0;
+    for (std::int64_t credit : credits)
+    {
+        in.push_back(std::make_pair(gid_type(1, ++lsb), credit));
+        test_round_trip(requests_type(1, in.back()));
+    }
+    test_round_trip(in);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Deserializing the given encoded message should fail.
+void test_malformed(std::vector<std::uint8_t> const& data)
+{
+    std::vector<char> buffer;
+    {
+        hpx::serialization::output_archive oarchive(buffer);
+        oarchive << data;
+    }
+
+    bool caught_exception = false;
+    try {
+        credit_requests result;
+        hpx::serialization::input_archive iarchive(buffer);
+        iarchive >> result;
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::serialization_error);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_malformed()
+{
+    // empty message
+    test_malformed(std::vector<std::uint8_t>());
+
+    // more requests than could have been encoded
+    test_malformed({ 0x05, 0x00, 0x01, 0x02 });
+
+    // a truncated value
+    test_malformed({ 0x01, 0x00, 0x01, 0x80 });
+
+    // a value exceeding 64 bits
+    test_malformed({ 0x01, 0x80, 0x80, 0x80, 0x80, 0x80,
+        0x80, 0x80, 0x80, 0x80, 0x80, 0x01, 0x01, 0x02 });
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_ids();
+    test_credits();
+    test_malformed();
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,231 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/plain_actions.hpp>
+#include <hpx/runtime/agas/addressing_service.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <tests/unit/agas/components/simple_refcnt_checker.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<hpx::naming::address> resolve_gids(
+    std::vector<hpx::naming::gid_type> const& gids)
+{
+    return hpx::naming::get_agas_client().resolve_bulk(gids).get();
+}
+HPX_PLAIN_ACTION(resolve_gids, resolve_gids_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_resolve_bulk(std::vector<hpx::id_type> const& localities)
+{
+    std::vector<hpx::id_type> ids;
+    for (hpx::id_type const& locality : localities)
+    {
+        for (std::size_t i = 0; i != 10; ++i)
+            ids.push_back(hpx::new_<test_server>(locality).get());
+    }
+
+    // resolve all at once (this populates the local cache)
+    std::vector<hpx::naming::address> addrs = hpx::agas::resolve(ids).get();
+    HPX_TEST_EQ(addrs.size(), ids.size());
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        hpx::naming::address addr =
+            hpx::agas::resolve(hpx::launch::sync, ids[i]);
+
+        HPX_TEST(addrs[i]);
+        HPX_TEST_EQ(addrs[i].locality_, addr.locality_);
+        HPX_TEST_EQ(addrs[i].type_, addr.type_);
+        HPX_TEST_EQ(addrs[i].address_, addr.address_);
+    }
+
+    // resolving again is served from the cache
+    std::vector<hpx::naming::address> cached = hpx::agas::resolve(ids).get();
+    HPX_TEST(cached == addrs);
+
+    // nothing to resolve
+    HPX_TEST(hpx::agas::resolve(std::vector<hpx::id_type>()).get().empty());
+}
+
+void test_resolve_bulk_invalid()
+{
+    std::vector<hpx::id_type> ids(1, hpx::invalid_id);
+
+    bool caught_exception = false;
+    try {
+        hpx::agas::resolve(ids).get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_bind_bulk(std::vector<hpx::id_type> const& localities)
+{
+    std::size_t const count = 10;
+
+    // the bound addresses are never dereferenced
+    std::vector<int> objects(count);
+
+    hpx::naming::gid_type const here = hpx::get_locality();
+    hpx::naming::gid_type const lower = hpx::agas::get_next_id(count);
+
+    std::vector<hpx::naming::gid_type> gids;
+    std::vector<hpx::naming::address> addrs;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        gids.push_back(lower + i);
+        addrs.push_back(hpx::naming::address(here,
+            hpx::components::get_component_type<server_type>(), &objects[i]));
+    }
+
+    hpx::naming::get_agas_client().bind_bulk(gids, addrs, here).get();
+
+    // all localities (including the ones which do not have the ids in their
+    // cache) have to see the new bindings
+    for (hpx::id_type const& locality : localities)
+    {
+        std::vector<hpx::naming::address> resolved =
+            hpx::async<resolve_gids_action>(locality, gids).get();
+
+        HPX_TEST_EQ(resolved.size(), addrs.size());
+        for (std::size_t i = 0; i != resolved.size(); ++i)
+        {
+            HPX_TEST_EQ(resolved[i].locality_, addrs[i].locality_);
+            HPX_TEST_EQ(resolved[i].type_, addrs[i].type_);
+            HPX_TEST_EQ(resolved[i].address_, addrs[i].address_);
+        }
+    }
+
+    for (hpx::naming::gid_type const& gid : gids)
+        hpx::agas::unbind(hpx::launch::sync, gid);
+
+    // the number of addresses has to match the number of ids
+    bool caught_exception = false;
+    try {
+        hpx::naming::get_agas_client().bind_bulk(
+            gids, std::vector<hpx::naming::address>(), here).get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_incref_bulk(std::vector<hpx::id_type> const& localities)
+{
+    std::int64_t const credit = 3;
+    std::chrono::milliseconds const delay(500);
+
+    typedef hpx::test::simple_refcnt_monitor monitor_type;
+
+    std::vector<std::unique_ptr<monitor_type> > monitors;
+    std::vector<std::pair<hpx::naming::gid_type, std::int64_t> > requests;
+
+    for (hpx::id_type const& locality : localities)
+    {
+        monitors.push_back(
+            std::unique_ptr<monitor_type>(new monitor_type(locality)));
+        requests.push_back(std::make_pair(
+            hpx::naming::detail::get_stripped_gid(
+                monitors.back()->get_id().get_gid()),
+            credit));
+    }
+
+    hpx::naming::get_agas_client().incref_bulk(requests).get();
+
+    // drop all references held by the monitors
+    for (std::unique_ptr<monitor_type>& monitor : monitors)
+        monitor->detach().get();
+
+    hpx::agas::garbage_collect();
+    hpx::agas::garbage_collect();
+
+    // the additional credits keep the components alive
+    for (std::unique_ptr<monitor_type>& monitor : monitors)
+        HPX_TEST(!monitor->is_ready(delay));
+
+    // give back the additional credits
+    typedef std::pair<hpx::naming::gid_type, std::int64_t> request_type;
+    for (request_type const& r : requests)
+        hpx::agas::decref(r.first, r.second);
+
+    hpx::agas::garbage_collect();
+    hpx::agas::garbage_collect();
+
+    for (std::unique_ptr<monitor_type>& monitor : monitors)
+        HPX_TEST(monitor->is_ready(delay));
+
+    // nothing to do
+    hpx::naming::get_agas_client().incref_bulk(
+        std::vector<request_type>()).get();
+
+    // invalid credits are rejected
+    requests.clear();
+    requests.push_back(std::make_pair(hpx::get_locality(), std::int64_t(0)));
+
+    bool caught_exception = false;
+    try {
+        hpx::naming::get_agas_client().incref_bulk(requests).get();
+        HPX_TEST(false);
+    }
+    catch (hpx::exception const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+int hpx_main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    test_resolve_bulk(localities);
+    test_resolve_bulk_invalid();
+    test_bind_bulk(localities);
+    test_incref_bulk(localities);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // We need to explicitly enable the test components used by this test.
+    std::vector<std::string> const cfg = {
+        "hpx.components.simple_refcnt_checker.enabled! = 1"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
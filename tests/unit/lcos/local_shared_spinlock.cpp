@@ -0,0 +1,121 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/shared_spinlock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/thread/locks.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+typedef hpx::lcos::local::shared_spinlock mutex_type;
+
+///////////////////////////////////////////////////////////////////////////////
+void test_exclusive_excludes_shared()
+{
+    mutex_type mtx;
+
+    {
+        std::unique_lock<mutex_type> l(mtx);
+        HPX_TEST(!mtx.try_lock());
+        HPX_TEST(!mtx.try_lock_shared());
+    }
+
+    {
+        boost::shared_lock<mutex_type> l1(mtx);
+        HPX_TEST(!mtx.try_lock());
+
+        // any number of readers may hold the lock at the same time
+        HPX_TEST(mtx.try_lock_shared());
+        mtx.unlock_shared();
+    }
+
+    HPX_TEST(mtx.try_lock());
+    mtx.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent_access(std::size_t num_tasks, std::size_t num_iterations)
+{
+    mutex_type mtx;
+
+    // both values are only ever changed together under the exclusive lock
+    std::size_t first = 0;
+    std::size_t second = 0;
+    boost::atomic<std::size_t> inconsistent(0);
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        tasks.push_back(hpx::async(
+            [&, i]()
+            {
+                for (std::size_t j = 0; j != num_iterations; ++j)
+                {
+                    if ((i + j) % 4 == 0)
+                    {
+                        std::lock_guard<mutex_type> l(mtx);
+                        ++first;
+                        ++second;
+                    }
+                    else
+                    {
+                        boost::shared_lock<mutex_type> l(mtx);
+                        if (first != second)
+                            ++inconsistent;
+                    }
+                }
+            }));
+    }
+    hpx::wait_all(tasks);
+
+    std::size_t writes = 0;
+    for (std::size_t i = 0; i != num_tasks; ++i)
+    {
+        for (std::size_t j = 0; j != num_iterations; ++j)
+        {
+            if ((i + j) % 4 == 0)
+                ++writes;
+        }
+    }
+
+    HPX_TEST_EQ(first, writes);
+    HPX_TEST_EQ(second, writes);
+    HPX_TEST_EQ(inconsistent.load(), std::size_t(0));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map&)
+{
+    test_exclusive_excludes_shared();
+    test_concurrent_access(4 * hpx::get_os_thread_count(), 10000);
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    boost::program_options::options_description cmdline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    // We force this test to use several threads by default.
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ(hpx::init(cmdline, argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
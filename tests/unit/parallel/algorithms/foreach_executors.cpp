@@ -45,6 +45,20 @@ void for_each_executors_test()
         test_executors_async(execution::par(execution::task).on(exec));
     }
 
+    {
+        fork_join_executor exec;
+
+        test_executors(execution::par.on(exec));
+        test_executors_async(execution::par(execution::task).on(exec));
+    }
+
+    {
+        fork_join_executor exec(fork_join_executor::work_first);
+
+        test_executors(execution::par.on(exec));
+        test_executors_async(execution::par(execution::task).on(exec));
+    }
+
     {
         sequential_executor exec;
 
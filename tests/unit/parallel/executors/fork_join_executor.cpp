@@ -0,0 +1,145 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/range/functions.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <numeric>
+#include <string>
+#include <vector>
+
+typedef hpx::parallel::fork_join_executor executor;
+typedef hpx::parallel::executor_traits<executor> traits;
+
+///////////////////////////////////////////////////////////////////////////////
+int test(int passed_through)
+{
+    HPX_TEST_EQ(passed_through, 42);
+    return passed_through;
+}
+
+void test_sync(executor exec)
+{
+    HPX_TEST_EQ(traits::execute(exec, &test, 42), 42);
+}
+
+void test_async(executor exec)
+{
+    HPX_TEST_EQ(traits::async_execute(exec, &test, 42).get(), 42);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> count(0);
+
+hpx::thread::id bulk_test(int value, int passed_through) //-V813
+{
+    HPX_TEST_EQ(passed_through, 42);
+    ++count;
+    return hpx::this_thread::get_id();
+}
+
+void test_bulk_async(executor exec)
+{
+    hpx::thread::id tid = hpx::this_thread::get_id();
+
+    std::vector<int> v(107);
+    std::iota(boost::begin(v), boost::end(v), std::rand());
+
+    count.store(0);
+
+    std::vector<hpx::future<hpx::thread::id> > results =
+        traits::bulk_async_execute(exec, &bulk_test, v, 42);
+    HPX_TEST_EQ(results.size(), v.size());
+
+    // the first element is always executed by the calling thread
+    HPX_TEST(results[0].is_ready());
+    HPX_TEST(results[0].get() == tid);
+
+    // the remaining elements are executed exactly once, either by a worker
+    // thread or inline while waiting for them
+    hpx::wait_all(results);
+    HPX_TEST_EQ(count.load(), v.size());
+}
+
+void test_bulk_sync(executor exec)
+{
+    std::vector<int> v(107);
+    std::iota(boost::begin(v), boost::end(v), std::rand());
+
+    count.store(0);
+    traits::bulk_execute(exec, &bulk_test, v, 42);
+    HPX_TEST_EQ(count.load(), v.size());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_nested(executor exec)
+{
+    using namespace hpx::parallel;
+
+    std::vector<std::size_t> outer(64);
+    std::iota(boost::begin(outer), boost::end(outer), std::size_t(0));
+
+    std::vector<std::vector<std::size_t> > inner(outer.size(),
+        std::vector<std::size_t>(1000, 0));
+
+    for_each(execution::par.on(exec), boost::begin(outer), boost::end(outer),
+        [&](std::size_t i)
+        {
+            for_each(execution::par.on(exec),
+                boost::begin(inner[i]), boost::end(inner[i]),
+                [i](std::size_t& val)
+                {
+                    val += i + 1;
+                });
+        });
+
+    for (std::size_t i = 0; i != outer.size(); ++i)
+    {
+        HPX_TEST_EQ(std::size_t(std::count(boost::begin(inner[i]),
+            boost::end(inner[i]), i + 1)), inner[i].size());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_executor(executor exec)
+{
+    test_sync(exec);
+    test_async(exec);
+    test_bulk_async(exec);
+    test_bulk_sync(exec);
+    test_nested(exec);
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_executor(executor());
+    test_executor(executor(executor::help_first));
+    test_executor(executor(executor::work_first));
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,278 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the queues of pending parcels deliver every parcel
+// added by concurrent producers exactly once (and in the order each producer
+// added them) to a single consumer, and that the number of destinations with
+// pending parcels matches the queues.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/parcelset/detail/pending_parcels_queue.hpp>
+#include <hpx/runtime/parcelset/locality.hpp>
+#include <hpx/runtime/parcelset/parcel.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <iostream>
+#include <utility>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+using hpx::parcelset::locality;
+using hpx::parcelset::parcel;
+
+///////////////////////////////////////////////////////////////////////////////
+// A locality which is identified by a number only.
+class test_locality
+{
+public:
+    test_locality()
+      : id_(std::size_t(-1))
+    {}
+
+    explicit test_locality(std::size_t id)
+      : id_(id)
+    {}
+
+    static const char *type()
+    {
+        return "test";
+    }
+
+    explicit operator bool() const HPX_NOEXCEPT
+    {
+        return id_ != std::size_t(-1);
+    }
+
+    void save(hpx::serialization::output_archive& ar) const
+    {
+        ar << id_;
+    }
+
+    void load(hpx::serialization::input_archive& ar)
+    {
+        ar >> id_;
+    }
+
+private:
+    friend bool operator==(test_locality const& lhs, test_locality const& rhs)
+    {
+        return lhs.id_ == rhs.id_;
+    }
+
+    friend bool operator<(test_locality const& lhs, test_locality const& rhs)
+    {
+        return lhs.id_ < rhs.id_;
+    }
+
+    friend std::ostream& operator<<(std::ostream& os, test_locality const& l)
+    {
+        return os << l.id_;
+    }
+
+    std::size_t id_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// The handler of each parcel is the number identifying it, the parcels added
+// by producer p to destination d are numbered (p * destinations + d) * count
+// and upwards.
+typedef hpx::parcelset::detail::pending_parcels_destinations<std::size_t>
+    destinations_type;
+typedef destinations_type::queue_type queue_type;
+
+std::size_t parcel_id(std::size_t producer, std::size_t destination,
+    std::size_t num_destinations, std::size_t count, std::size_t i)
+{
+    return (producer * num_destinations + destination) * count + i;
+}
+
+// Add the parcels alternately one by one and in batches of three.
+void produce(destinations_type& destinations, std::size_t producer,
+    std::size_t num_destinations, std::size_t count)
+{
+    for (std::size_t i = 0; i < count; i += 4)
+    {
+        for (std::size_t d = 0; d != num_destinations; ++d)
+        {
+            queue_type& q = destinations.get(locality(test_locality(d)));
+
+            std::size_t const id =
+                parcel_id(producer, d, num_destinations, count, i);
+            q.push(parcel(), std::size_t(id));
+
+            std::vector<parcel> parcels;
+            std::vector<std::size_t> handlers;
+            for (std::size_t j = 1; j != 4 && i + j < count; ++j)
+            {
+                parcels.push_back(parcel());
+                handlers.push_back(id + j);
+            }
+            q.push(std::move(parcels), std::move(handlers));
+        }
+    }
+}
+
+hpx::future<void> start_producers(destinations_type& destinations,
+    std::size_t num_producers, std::size_t num_destinations,
+    std::size_t count)
+{
+    std::vector<hpx::future<void> > producers;
+    producers.reserve(num_producers);
+    for (std::size_t p = 0; p != num_producers; ++p)
+    {
+        producers.push_back(hpx::async(&produce, std::ref(destinations), p,
+            num_destinations, count));
+    }
+    return hpx::when_all(producers);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Take out all parcels which are currently waiting, check that none of them
+// was received before and that each producer's parcels arrive in order.
+std::size_t consume(destinations_type& destinations,
+    std::vector<bool>& received, std::vector<std::size_t>& next,
+    std::size_t count)
+{
+    std::vector<locality> non_empty;
+    destinations.non_empty(non_empty);
+
+    std::size_t num_received = 0;
+    for (locality const& loc : non_empty)
+    {
+        queue_type* q = destinations.find(loc);
+        HPX_TEST(q != nullptr);
+        if (q == nullptr)
+            continue;
+
+        std::vector<parcel> parcels;
+        std::vector<std::size_t> handlers;
+        if (!q->pop_all(parcels, handlers))
+            continue;
+
+        HPX_TEST_EQ(parcels.size(), handlers.size());
+        for (std::size_t id : handlers)
+        {
+            HPX_TEST(id < received.size());
+            if (id >= received.size())
+                continue;
+
+            HPX_TEST(!received[id]);
+            received[id] = true;
+
+            // parcels of the same producer and destination stay in order
+            std::size_t const sequence = id / count;
+            HPX_TEST_EQ(id, next[sequence]);
+            next[sequence] = id + 1;
+
+            ++num_received;
+        }
+    }
+    return num_received;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_pending_parcels(std::size_t num_producers,
+    std::size_t num_destinations, std::size_t count, bool concurrent)
+{
+    destinations_type destinations;
+
+    std::size_t const total = num_producers * num_destinations * count;
+    std::vector<bool> received(total, false);
+
+    std::vector<std::size_t> next(num_producers * num_destinations);
+    for (std::size_t i = 0; i != next.size(); ++i)
+        next[i] = i * count;
+
+    hpx::future<void> producers = start_producers(destinations,
+        num_producers, num_destinations, count);
+
+    if (!concurrent)
+    {
+        producers.wait();
+
+        // all destinations have parcels waiting
+        HPX_TEST_EQ(destinations.num_destinations(),
+            std::uint32_t(num_destinations));
+        HPX_TEST_EQ(destinations.size(), std::int64_t(total));
+
+        std::vector<locality> non_empty;
+        destinations.non_empty(non_empty);
+        HPX_TEST_EQ(non_empty.size(), num_destinations);
+    }
+
+    std::size_t num_received = 0;
+    while (num_received != total)
+    {
+        HPX_TEST_LTE(destinations.num_destinations(),
+            std::uint32_t(num_destinations));
+
+        std::size_t const n = consume(destinations, received, next, count);
+        if (n == 0)
+        {
+            if (producers.is_ready())
+                break;
+            hpx::this_thread::yield();
+        }
+        num_received += n;
+    }
+    num_received += consume(destinations, received, next, count);
+    producers.get();
+
+    // every parcel was received exactly once
+    HPX_TEST_EQ(num_received, total);
+    for (std::size_t i = 0; i != total; ++i)
+        HPX_TEST(received[i]);
+
+    // no destination is counted anymore
+    HPX_TEST_EQ(destinations.num_destinations(), std::uint32_t(0));
+    HPX_TEST_EQ(destinations.size(), std::int64_t(0));
+
+    std::vector<locality> non_empty;
+    destinations.non_empty(non_empty);
+    HPX_TEST(non_empty.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    std::size_t const count = vm["count"].as<std::size_t>();
+    std::size_t const producers =
+        (std::max)(std::size_t(2), std::size_t(hpx::get_os_thread_count()));
+
+    test_pending_parcels(producers, 4, count, false);
+    test_pending_parcels(producers, 4, count, true);
+    test_pending_parcels(producers, 1, count, true);
+
+    hpx::finalize();
+    return hpx::util::report_errors();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "count"
+        , value<std::size_t>()->default_value(10000)
+        , "number of parcels each producer sends to each destination")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
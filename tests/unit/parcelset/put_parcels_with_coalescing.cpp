@@ -253,6 +253,10 @@ int hpx_main(boost::program_options::variables_map& vm)
     print_counters("/coalescing{locality#0/total}/count/parcels@test2_action");
     print_counters("/coalescing{locality#0/total}/count/messages@test1_action");
     print_counters("/coalescing{locality#0/total}/count/messages@test2_action");
+    print_counters(
+        "/coalescing{locality#0/total}/count/max-parcels-per-message@test1_action");
+    print_counters(
+        "/coalescing{locality#0/total}/time/flush-interval@test1_action");
 
     return hpx::finalize();
 }
@@ -68,6 +68,8 @@ HPX_ACTION_USES_BZIP2_COMPRESSION(test1_action)
 HPX_ACTION_USES_ZLIB_COMPRESSION(test1_action)
 #elif defined(HPX_HAVE_COMPRESSION_SNAPPY)
 HPX_ACTION_USES_SNAPPY_COMPRESSION(test1_action)
+#elif defined(HPX_HAVE_COMPRESSION_LZ4)
+HPX_ACTION_USES_LZ4_COMPRESSION(test1_action)
 #endif
 
 HPX_REGISTER_ACTION(test1_action);
@@ -0,0 +1,161 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies the single-producer/single-consumer byte ring used by the
+// shared memory parcelport.
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/parcelport/shmem/segment.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+using hpx::parcelset::policies::shmem::channel;
+using hpx::parcelset::policies::shmem::channel_header;
+
+///////////////////////////////////////////////////////////////////////////////
+void init_header(channel_header& header)
+{
+    header.owner_.store(0);
+    header.head_.store(0);
+    header.tail_.store(0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_claim_release()
+{
+    channel_header header;
+    init_header(header);
+
+    std::vector<char> data(64);
+    channel c(&header, data.data(), data.size());
+
+    HPX_TEST(c);
+    HPX_TEST(!channel());
+
+    HPX_TEST_EQ(c.owner(), 0);
+    HPX_TEST(c.claim(42));
+    HPX_TEST_EQ(c.owner(), 42);
+    HPX_TEST(!c.claim(43));
+    HPX_TEST_EQ(c.owner(), 42);
+
+    c.release();
+    HPX_TEST_EQ(c.owner(), 0);
+    HPX_TEST(c.claim(43));
+    HPX_TEST_EQ(c.owner(), 43);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_wrap_around()
+{
+    channel_header header;
+    init_header(header);
+
+    std::vector<char> data(64);
+    channel c(&header, data.data(), data.size());
+
+    HPX_TEST(c.empty());
+
+    std::vector<char> in(48), out(48);
+    for (std::size_t i = 0; i != in.size(); ++i)
+        in[i] = static_cast<char>(i);
+
+    // nothing to read from an empty channel
+    HPX_TEST_EQ(c.read(out.data(), out.size()), std::size_t(0));
+
+    HPX_TEST_EQ(c.write(in.data(), in.size()), in.size());
+    HPX_TEST(!c.empty());
+
+    // only the remaining space is written to a (nearly) full channel
+    HPX_TEST_EQ(c.write(in.data(), in.size()), std::size_t(16));
+    HPX_TEST_EQ(c.write(in.data(), in.size()), std::size_t(0));
+
+    HPX_TEST_EQ(c.read(out.data(), out.size()), out.size());
+    HPX_TEST(in == out);
+
+    HPX_TEST_EQ(c.read(out.data(), out.size()), std::size_t(16));
+    for (std::size_t i = 0; i != 16; ++i)
+        HPX_TEST_EQ(out[i], in[i]);
+    HPX_TEST(c.empty());
+
+    // this write wraps around the end of the ring
+    for (std::size_t i = 0; i != in.size(); ++i)
+        in[i] = static_cast<char>(in.size() - i);
+
+    HPX_TEST_EQ(c.write(in.data(), in.size()), in.size());
+    HPX_TEST_EQ(c.read(out.data(), out.size()), out.size());
+    HPX_TEST(in == out);
+    HPX_TEST(c.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_concurrent()
+{
+    channel_header header;
+    init_header(header);
+
+    std::vector<char> data(251);
+    channel c(&header, data.data(), data.size());
+
+    std::size_t const total = 1024 * 1024;
+
+    std::thread producer(
+        [&c, total]()
+        {
+            std::vector<char> buffer(97);
+            std::size_t written = 0;
+            while (written != total)
+            {
+                std::size_t size = (std::min)(buffer.size(), total - written);
+                for (std::size_t i = 0; i != size; ++i)
+                    buffer[i] = static_cast<char>((written + i) % 127);
+
+                std::size_t offset = 0;
+                while (offset != size)
+                {
+                    offset += c.write(buffer.data() + offset, size - offset);
+                    if (offset != size)
+                        std::this_thread::yield();
+                }
+                written += size;
+            }
+        });
+
+    std::vector<char> buffer(113);
+    std::size_t read = 0;
+    std::size_t errors = 0;
+    while (read != total)
+    {
+        std::size_t count = c.read(buffer.data(), buffer.size());
+        for (std::size_t i = 0; i != count; ++i)
+        {
+            if (buffer[i] != static_cast<char>((read + i) % 127))
+                ++errors;
+        }
+        read += count;
+        if (count == 0)
+            std::this_thread::yield();
+    }
+
+    producer.join();
+
+    HPX_TEST_EQ(errors, std::size_t(0));
+    HPX_TEST_EQ(read, total);
+    HPX_TEST(c.empty());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_claim_release();
+    test_wrap_around();
+    test_concurrent();
+
+    return hpx::util::report_errors();
+}
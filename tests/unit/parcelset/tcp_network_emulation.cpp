@@ -0,0 +1,158 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies the release times computed by the network emulation of
+// the TCP parcelport: the bandwidth of the shared link, the bounds of the
+// jitter, the percentage of reordered messages, and that the same seed
+// produces the same sequence of release times.
+
+#include <hpx/config.hpp>
+#include <hpx/plugins/parcelport/tcp/network_emulation.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+using hpx::parcelset::policies::tcp::network_emulation;
+
+typedef network_emulation::time_point time_point;
+
+using std::chrono::microseconds;
+using std::chrono::nanoseconds;
+
+time_point const start = time_point() + std::chrono::seconds(1);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_bandwidth()
+{
+    // 1000 bytes per microsecond, i.e. one byte per nanosecond
+    network_emulation emulation(nanoseconds(0), nanoseconds(0), 1000.0, 0, 0);
+
+    HPX_TEST(emulation.enabled());
+
+    // messages sent at the same time are transmitted one after the other
+    HPX_TEST(emulation.release_time(1000, start) ==
+        start + nanoseconds(1000));
+    HPX_TEST(emulation.release_time(500, start) ==
+        start + nanoseconds(1500));
+
+    // a message sent while the link is still busy has to wait for it
+    HPX_TEST(emulation.release_time(1000, start + nanoseconds(1000)) ==
+        start + nanoseconds(2500));
+
+    // a message sent after the link became idle is transmitted immediately
+    time_point const later = start + microseconds(10);
+    HPX_TEST(emulation.release_time(2000, later) ==
+        later + nanoseconds(2000));
+
+    // the latency is added after the message has been transmitted
+    network_emulation delayed(microseconds(5), nanoseconds(0), 1000.0, 0, 0);
+    HPX_TEST(delayed.release_time(1000, start) ==
+        start + nanoseconds(1000) + microseconds(5));
+    HPX_TEST(delayed.release_time(1000, start) ==
+        start + nanoseconds(2000) + microseconds(5));
+
+    // a bandwidth of zero disables the limit
+    network_emulation unlimited(microseconds(5), nanoseconds(0), 0, 0, 0);
+    HPX_TEST(unlimited.release_time(1000000, start) ==
+        start + microseconds(5));
+    HPX_TEST(unlimited.release_time(1000000, start) ==
+        start + microseconds(5));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_jitter(std::size_t count)
+{
+    microseconds const latency(100);
+    microseconds const jitter(50);
+
+    network_emulation emulation(latency, jitter, 0, 0, 42);
+
+    nanoseconds min_delay = latency + jitter;
+    nanoseconds max_delay = latency;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        nanoseconds delay = emulation.release_time(100, start) - start;
+        HPX_TEST(delay >= latency);
+        HPX_TEST(delay <= latency + jitter);
+
+        if (delay < min_delay)
+            min_delay = delay;
+        if (delay > max_delay)
+            max_delay = delay;
+    }
+
+    // the jitter covers most of its range
+    HPX_TEST(max_delay - min_delay > jitter / 2);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Returns the number of messages which were held back for another latency.
+std::size_t count_reordered(std::int64_t reordering, std::size_t count)
+{
+    microseconds const latency(100);
+
+    network_emulation emulation(latency, nanoseconds(0), 0, reordering, 42);
+
+    std::size_t reordered = 0;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        nanoseconds delay = emulation.release_time(100, start) - start;
+        if (delay == 2 * latency)
+            ++reordered;
+        else
+            HPX_TEST(delay == latency);
+    }
+    return reordered;
+}
+
+void test_reordering(std::size_t count)
+{
+    HPX_TEST_EQ(count_reordered(0, count), std::size_t(0));
+    HPX_TEST_EQ(count_reordered(100, count), count);
+
+    // allow for a deviation of about ten standard deviations
+    std::size_t const expected = count / 4;
+    std::size_t const reordered = count_reordered(25, count);
+    HPX_TEST(reordered > expected - expected / 5);
+    HPX_TEST(reordered < expected + expected / 5);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<time_point> release_times(std::uint32_t seed, std::size_t count)
+{
+    network_emulation emulation(
+        microseconds(100), microseconds(50), 1000.0, 10, seed);
+
+    std::vector<time_point> times;
+    times.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        times.push_back(emulation.release_time(
+            100 * (i + 1), start + microseconds(i)));
+    }
+    return times;
+}
+
+void test_seed(std::size_t count)
+{
+    HPX_TEST(release_times(1, count) == release_times(1, count));
+    HPX_TEST(release_times(1, count) != release_times(2, count));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::size_t const count = 10000;
+
+    test_bandwidth();
+    test_jitter(count);
+    test_reordering(count);
+    test_seed(count);
+
+    return hpx::util::report_errors();
+}
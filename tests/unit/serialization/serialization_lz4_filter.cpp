@@ -0,0 +1,169 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that messages filtered by the lz4 binary filter survive
+// the round trip through the archives: messages below the compression
+// threshold, messages spanning several blocks (written to the archive while
+// being saved), and messages which do not compress and are stored as they
+// are. Truncated messages have to be rejected.
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/plugins/binary_filter/lz4_serialization_filter.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <random>
+#include <vector>
+
+using hpx::plugins::compression::lz4_serialization_filter;
+
+typedef std::vector<std::vector<char> > message_type;
+
+// size of the blocks the filter compresses the data in
+std::size_t const block_size = 64 * 1024;
+
+///////////////////////////////////////////////////////////////////////////////
+std::vector<char> compressible(std::size_t size)
+{
+    std::vector<char> data(size);
+    for (std::size_t i = 0; i != size; ++i)
+        data[i] = static_cast<char>('a' + (i / 16) % 4);
+    return data;
+}
+
+std::vector<char> incompressible(std::size_t size)
+{
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> dist(0, 255);
+
+    std::vector<char> data(size);
+    for (char& c : data)
+        c = static_cast<char>(dist(random));
+    return data;
+}
+
+std::size_t message_size(message_type const& message)
+{
+    std::size_t size = 0;
+    for (std::vector<char> const& part : message)
+        size += part.size();
+    return size;
+}
+
+// Returns the size of the serialized message.
+std::size_t round_trip(message_type const& message)
+{
+    std::vector<char> buffer;
+    std::size_t inbound_size = 0;
+    {
+        lz4_serialization_filter filter(true);
+        hpx::serialization::output_archive oarchive(
+            buffer, 0U, nullptr, &filter);
+        oarchive << message;
+        oarchive.flush();
+        inbound_size = oarchive.bytes_written();
+    }
+
+    message_type result;
+    {
+        hpx::serialization::input_archive iarchive(buffer, inbound_size);
+        iarchive >> result;
+    }
+
+    HPX_TEST(message == result);
+    return buffer.size();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_below_threshold()
+{
+    message_type message(1, compressible(500));
+
+    // the message is stored uncompressed
+    HPX_TEST_LTE(message_size(message), round_trip(message));
+}
+
+void test_several_blocks()
+{
+    // the first part is collected in a block which is completed by the
+    // second part, the second part is compressed directly from the source
+    message_type message;
+    message.push_back(compressible(1000));
+    message.push_back(compressible(3 * block_size + 1000));
+    message.push_back(compressible(10));
+
+    HPX_TEST_LT(round_trip(message), message_size(message) / 2);
+
+    // a message within a single block
+    HPX_TEST_LT(round_trip(message_type(1, compressible(block_size - 32))),
+        block_size / 2);
+}
+
+void test_incompressible()
+{
+    // every block is stored as it is
+    message_type message(1, incompressible(3 * block_size + 1000));
+    HPX_TEST_LTE(message_size(message), round_trip(message));
+
+    // the partial block at the end is stored as well
+    message = message_type(1, incompressible(2000));
+    HPX_TEST_LTE(message_size(message), round_trip(message));
+
+    // after two blocks which didn't compress the filter stops trying
+    message = message_type(1, incompressible(2 * block_size));
+    message.push_back(compressible(4 * block_size));
+    HPX_TEST_LTE(message_size(message), round_trip(message));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_truncated(message_type const& message)
+{
+    std::vector<char> buffer;
+    std::size_t inbound_size = 0;
+    {
+        lz4_serialization_filter filter(true);
+        hpx::serialization::output_archive oarchive(
+            buffer, 0U, nullptr, &filter);
+        oarchive << message;
+        oarchive.flush();
+        inbound_size = oarchive.bytes_written();
+    }
+
+    buffer.resize(buffer.size() - 100);
+
+    bool caught_exception = false;
+    try {
+        message_type result;
+        hpx::serialization::input_archive iarchive(buffer, inbound_size);
+        iarchive >> result;
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::serialization_error);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_truncated()
+{
+    test_truncated(message_type(1, compressible(3 * block_size + 1000)));
+    test_truncated(message_type(1, incompressible(3 * block_size + 1000)));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    test_below_threshold();
+    test_several_blocks();
+    test_incompressible();
+    test_truncated();
+
+    return hpx::util::report_errors();
+}
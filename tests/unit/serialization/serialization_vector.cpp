@@ -10,8 +10,10 @@
 #include <hpx/runtime/serialization/output_archive.hpp>
 
 #include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/tuple.hpp>
 
 #include <cstddef>
+#include <cstdint>
 #include <vector>
 
 template <typename T>
@@ -169,9 +171,78 @@ void test_fp(T min, T max)
     }
 }
 
+// tuples of bitwise serializable types are copied as a whole if they don't
+// contain padding, unless the byte order of the archive differs from the one
+// of this machine
+static_assert(
+    hpx::traits::is_bitwise_serializable<
+        hpx::util::tuple<std::int64_t, double>
+    >::value, "tuple without padding is bitwise serializable");
+static_assert(
+    !hpx::traits::is_bitwise_serializable<
+        hpx::util::tuple<int, double, char>
+    >::value, "tuple with padding is not bitwise serializable");
+
+template <typename Tuple>
+std::size_t tuple_archive_size(Tuple const& t)
+{
+    std::vector<char> buffer;
+    hpx::serialization::output_archive oarchive(buffer);
+
+    std::size_t start = oarchive.bytes_written();
+    oarchive << t;
+    return oarchive.bytes_written() - start;
+}
+
+void test_tuple_size()
+{
+    // no padding bytes end up in the archive
+    HPX_TEST_EQ(tuple_archive_size(
+        hpx::util::make_tuple(1, 2.0, 'c')), std::size_t(13));
+    HPX_TEST_EQ(tuple_archive_size(
+        hpx::util::make_tuple(std::int64_t(1), 2.0)), std::size_t(16));
+}
+
+void test_tuple(std::uint32_t flags)
+{
+    typedef hpx::util::tuple<int, double, char> tuple_type;
+
+    std::vector<char> buffer;
+    std::vector<hpx::serialization::serialization_chunk> chunks;
+    hpx::serialization::output_archive oarchive(buffer, flags, &chunks);
+
+    tuple_type ot(-42, 3.5, 'x');
+    std::vector<tuple_type> os;
+    for(int i = 0; i != 100; ++i)
+    {
+        os.push_back(tuple_type(i, i * 0.5, static_cast<char>('a' + i % 26)));
+    }
+    oarchive << ot << os;
+    std::size_t size = oarchive.bytes_written();
+
+    hpx::serialization::input_archive iarchive(buffer, size, &chunks);
+    tuple_type it;
+    std::vector<tuple_type> is;
+    iarchive >> it >> is;
+    HPX_TEST(ot == it);
+    HPX_TEST_EQ(os.size(), is.size());
+    for(std::size_t i = 0; i < os.size(); ++i)
+    {
+        HPX_TEST(os[i] == is[i]);
+    }
+}
+
 int main()
 {
     test_bool();
+    test_tuple_size();
+    test_tuple(0U);
+#ifdef BOOST_BIG_ENDIAN
+    test_tuple(hpx::serialization::endian_little);
+#else
+    test_tuple(hpx::serialization::endian_big);
+#endif
+
     test<char>((std::numeric_limits<char>::min)(),
         (std::numeric_limits<char>::max)());
     test<int>((std::numeric_limits<int>::min)(),
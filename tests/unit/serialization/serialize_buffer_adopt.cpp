@@ -0,0 +1,168 @@
+//  Copyright (c) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that a serialize_buffer takes over the memory of a
+// received zero-copy chunk (if the parcelport has told the archive who owns
+// it) and that it falls back to copying the data whenever this is not
+// possible.
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/serialization/input_archive.hpp>
+#include <hpx/runtime/serialization/output_archive.hpp>
+#include <hpx/runtime/serialization/serialization_chunk.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/runtime/serialization/serialize_buffer.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+typedef hpx::serialization::serialize_buffer<double> buffer_type;
+typedef std::vector<hpx::serialization::serialization_chunk> chunks_type;
+typedef std::vector<std::shared_ptr<char> > chunk_owners_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// Emulate a parcelport receiving the zero-copy chunks into memory it owns,
+// returns the owner of the last received chunk (if any).
+std::shared_ptr<char> receive_chunks(chunks_type& chunks,
+    chunk_owners_type& owners)
+{
+    std::shared_ptr<char> last;
+
+    owners.clear();
+    owners.resize(chunks.size());
+    for (std::size_t i = 0; i != chunks.size(); ++i)
+    {
+        hpx::serialization::serialization_chunk& c = chunks[i];
+        if (c.type_ != hpx::serialization::chunk_type_pointer)
+            continue;
+
+        std::shared_ptr<char> owner(new char[c.size_],
+            std::default_delete<char[]>());
+        std::memcpy(owner.get(), c.data_.cpos_, c.size_);
+
+        c = hpx::serialization::create_pointer_chunk(owner.get(), c.size_);
+        owners[i] = owner;
+        last = owner;
+    }
+    return last;
+}
+
+bool is_equal(buffer_type const& lhs, buffer_type const& rhs)
+{
+    return lhs.size() == rhs.size() &&
+        0 == std::memcmp(lhs.data(), rhs.data(), lhs.size() * sizeof(double));
+}
+
+buffer_type make_buffer(std::size_t size)
+{
+    buffer_type b(size);
+    for (std::size_t i = 0; i != size; ++i)
+        b[i] = double(i) + 0.5;
+    return b;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_adopt(std::size_t size)
+{
+    buffer_type const ob = make_buffer(size);
+
+    std::vector<char> buffer;
+    chunks_type chunks;
+    hpx::serialization::output_archive oarchive(buffer, 0U, &chunks);
+    oarchive << ob;
+    std::size_t inbound_size = oarchive.bytes_written();
+
+    chunk_owners_type owners;
+    std::shared_ptr<char> owner = receive_chunks(chunks, owners);
+    HPX_TEST(owner);
+
+    buffer_type ib;
+    {
+        hpx::serialization::input_archive iarchive(
+            buffer, inbound_size, &chunks, &owners);
+        iarchive >> ib;
+    }
+
+    HPX_TEST(is_equal(ob, ib));
+
+    // the buffer refers to the received memory and keeps it alive
+    HPX_TEST_EQ(reinterpret_cast<char*>(ib.data()), owner.get());
+
+    owners.clear();
+    std::weak_ptr<char> weak_owner(owner);
+    owner.reset();
+
+    HPX_TEST(!weak_owner.expired());
+    HPX_TEST(is_equal(ob, ib));
+
+    ib = buffer_type();
+    HPX_TEST(weak_owner.expired());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// The data has to be copied if the chunk can't be taken over.
+void test_copy(std::size_t size, std::uint32_t flags, bool with_owners)
+{
+    buffer_type const ob = make_buffer(size);
+
+    std::vector<char> buffer;
+    chunks_type chunks;
+    hpx::serialization::output_archive oarchive(buffer, flags, &chunks);
+    oarchive << ob;
+    std::size_t inbound_size = oarchive.bytes_written();
+
+    chunk_owners_type owners;
+    std::shared_ptr<char> owner = receive_chunks(chunks, owners);
+
+    buffer_type ib;
+    {
+        hpx::serialization::input_archive iarchive(buffer, inbound_size,
+            &chunks, with_owners ? &owners : nullptr);
+        iarchive >> ib;
+    }
+
+    HPX_TEST(is_equal(ob, ib));
+    HPX_TEST_NEQ(reinterpret_cast<char*>(ib.data()), owner.get());
+    HPX_TEST_NEQ(ib.data(), ob.data());
+
+    // the received memory is not referenced anymore
+    if (owner)
+        HPX_TEST_EQ(owner.use_count(), 2l);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    // large enough to be sent as a zero-copy chunk
+    std::size_t const large =
+        4 * HPX_ZERO_COPY_SERIALIZATION_THRESHOLD / sizeof(double);
+    std::size_t const small =
+        HPX_ZERO_COPY_SERIALIZATION_THRESHOLD / sizeof(double) / 4;
+
+#ifdef BOOST_BIG_ENDIAN
+    std::uint32_t const other_endianess = hpx::serialization::endian_little;
+#else
+    std::uint32_t const other_endianess = hpx::serialization::endian_big;
+#endif
+
+    test_adopt(large);
+
+    // the parcelport didn't tell who owns the chunks
+    test_copy(large, 0U, false);
+
+    // the data is not sent as a zero-copy chunk
+    test_copy(small, 0U, true);
+    test_copy(large, hpx::serialization::disable_data_chunking, true);
+
+    // the data has to be converted element by element
+    test_copy(large, hpx::serialization::disable_array_optimization, true);
+    test_copy(large, other_endianess, true);
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,122 @@
+// Copyright (C) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that the numa-priority scheduler runs all work created on
+// a single worker thread, that idle worker threads steal from it, and that
+// all steals are attributed to one of the steal domains.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/performance_counters.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define NUM_TASKS 1000
+
+///////////////////////////////////////////////////////////////////////////////
+void busy_wait(std::uint64_t nanoseconds)
+{
+    std::uint64_t start = hpx::util::high_resolution_clock::now();
+    while (hpx::util::high_resolution_clock::now() - start < nanoseconds)
+        /**/;
+}
+
+void task(std::vector<boost::atomic<std::size_t> >& executed_by,
+    hpx::lcos::local::latch& l)
+{
+    busy_wait(100000);      // 100us
+    ++executed_by[hpx::get_worker_thread_num()];
+    l.count_down(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+#if defined(HPX_HAVE_THREAD_STEALING_COUNTS)
+std::int64_t get_counter(char const* name)
+{
+    std::string const counter_name =
+        std::string("/threads{locality#0/total}/count/") + name;
+
+    hpx::performance_counters::performance_counter c(counter_name);
+    return c.get_value<std::int64_t>(hpx::launch::sync);
+}
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::size_t const this_thread = hpx::get_worker_thread_num();
+
+    std::vector<boost::atomic<std::size_t> > executed_by(num_threads);
+    for (boost::atomic<std::size_t>& count : executed_by)
+        count.store(0);
+
+    // create all tasks on the queue of this worker thread, all other worker
+    // threads have to steal them
+    {
+        hpx::lcos::local::latch l(NUM_TASKS + 1);
+        for (std::size_t i = 0; i != NUM_TASKS; ++i)
+        {
+            hpx::threads::register_thread_nullary(
+                hpx::util::bind(&task, std::ref(executed_by), std::ref(l)),
+                "numa_priority_scheduler_task", hpx::threads::pending, true,
+                hpx::threads::thread_priority_normal, this_thread);
+        }
+        l.count_down_and_wait();
+    }
+
+    std::size_t executed = 0;
+    std::size_t stolen = 0;
+    for (std::size_t i = 0; i != num_threads; ++i)
+    {
+        executed += executed_by[i];
+        if (i != this_thread)
+            stolen += executed_by[i];
+    }
+    HPX_TEST_EQ(executed, std::size_t(NUM_TASKS));
+
+    if (num_threads > 1)
+        HPX_TEST_LT(std::size_t(0), stolen);
+
+#if defined(HPX_HAVE_THREAD_STEALING_COUNTS)
+    // every steal is counted in one of the domains after it was counted as
+    // stolen, so the sum of the domains can't exceed the number of steals
+    std::int64_t const stolen_domains =
+        get_counter("stolen-local") +
+        get_counter("stolen-numa-local") +
+        get_counter("stolen-remote");
+    std::int64_t const stolen_total =
+        get_counter("stolen-to-pending") +
+        get_counter("stolen-to-staged");
+
+    HPX_TEST_LTE(std::int64_t(stolen), stolen_domains);
+    HPX_TEST_LTE(stolen_domains, stolen_total);
+#endif
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all",
+        "hpx.scheduler=numa-priority"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,144 @@
+// Copyright (C) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This test verifies that all work items handed to the scheduler at once
+// (register_work_bulk and register_work_nullary_bulk) are run exactly once.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/lightweight_test.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+// more than fit into the staging ring of a single queue
+#define NUM_THREADS (2 * HPX_THREAD_QUEUE_STAGED_RING_SIZE + 17)
+
+///////////////////////////////////////////////////////////////////////////////
+struct invocations
+{
+    explicit invocations(std::size_t count)
+      : counts_(new boost::atomic<std::size_t>[count]), size_(count),
+        latch_(static_cast<std::ptrdiff_t>(count + 1))
+    {
+        for (std::size_t i = 0; i != size_; ++i)
+            counts_[i].store(0);
+    }
+
+    void invoke(std::size_t i)
+    {
+        HPX_TEST(hpx::threads::get_self_ptr());
+        ++counts_[i];
+        latch_.count_down(1);
+    }
+
+    void wait_and_check()
+    {
+        latch_.count_down_and_wait();
+        for (std::size_t i = 0; i != size_; ++i)
+            HPX_TEST_EQ(counts_[i].load(), std::size_t(1));
+    }
+
+    std::unique_ptr<boost::atomic<std::size_t>[]> counts_;
+    std::size_t size_;
+    hpx::lcos::local::latch latch_;
+};
+
+hpx::threads::thread_result_type thread_function(invocations& inv,
+    std::size_t i, hpx::threads::thread_state_ex_enum)
+{
+    inv.invoke(i);
+    return hpx::threads::thread_result_type(hpx::threads::terminated, nullptr);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_register_work_bulk(std::size_t count,
+    hpx::threads::thread_priority priority)
+{
+    invocations inv(count);
+
+    std::vector<hpx::threads::thread_init_data> data;
+    data.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        data.emplace_back(
+            hpx::util::bind(&thread_function, std::ref(inv), i,
+                hpx::util::placeholders::_1),
+            "test_register_work_bulk", 0, priority);
+    }
+
+    hpx::threads::register_work_bulk(data);
+    inv.wait_and_check();
+}
+
+void test_register_work_nullary_bulk(std::size_t count,
+    hpx::threads::thread_stacksize stacksize)
+{
+    invocations inv(count);
+
+    std::vector<hpx::util::unique_function_nonser<void()> > funcs;
+    funcs.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        funcs.push_back(
+            hpx::util::bind(&invocations::invoke, &inv, i));
+    }
+
+    hpx::threads::register_work_nullary_bulk(std::move(funcs),
+        "test_register_work_nullary_bulk", hpx::threads::pending,
+        hpx::threads::thread_priority_normal, stacksize);
+    inv.wait_and_check();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    // nothing to do
+    {
+        std::vector<hpx::threads::thread_init_data> data;
+        hpx::threads::register_work_bulk(data);
+
+        hpx::threads::register_work_nullary_bulk(
+            std::vector<hpx::util::unique_function_nonser<void()> >());
+    }
+
+    test_register_work_bulk(1,
+        hpx::threads::thread_priority_normal);
+    test_register_work_bulk(NUM_THREADS,
+        hpx::threads::thread_priority_normal);
+    test_register_work_bulk(NUM_THREADS,
+        hpx::threads::thread_priority_critical);
+    test_register_work_bulk(NUM_THREADS,
+        hpx::threads::thread_priority_low);
+
+    test_register_work_nullary_bulk(1,
+        hpx::threads::thread_stacksize_default);
+    test_register_work_nullary_bulk(NUM_THREADS,
+        hpx::threads::thread_stacksize_default);
+    test_register_work_nullary_bulk(NUM_THREADS,
+        hpx::threads::thread_stacksize_nostack);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,89 @@
+// Copyright (C) 2017 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/threadmanager.hpp>
+#include <hpx/include/threads.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#define NUM_STACKLESS_THREADS 1000
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> count_invoked(0);
+boost::atomic<std::size_t> count_suspend_failed(0);
+
+void stackless_thread(hpx::lcos::local::latch& l)
+{
+    HPX_TEST(hpx::threads::get_self_ptr());
+    // stackless threads don't own a stack
+    HPX_TEST_EQ(hpx::threads::get_self_stacksize(), std::size_t(0));
+
+    ++count_invoked;
+    l.count_down(1);
+}
+
+void suspending_stackless_thread(hpx::lcos::local::latch& l)
+{
+    // stackless threads must run to completion
+    try {
+        hpx::this_thread::yield();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        ++count_suspend_failed;
+    }
+    l.count_down(1);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    {
+        hpx::lcos::local::latch l(NUM_STACKLESS_THREADS + 1);
+        for (std::size_t i = 0; i != NUM_STACKLESS_THREADS; ++i)
+        {
+            hpx::threads::register_thread_nullary(
+                hpx::util::bind(&stackless_thread, std::ref(l)),
+                "stackless_thread", hpx::threads::pending, true,
+                hpx::threads::thread_priority_normal, std::size_t(-1),
+                hpx::threads::thread_stacksize_nostack);
+        }
+        l.count_down_and_wait();
+
+        HPX_TEST_EQ(count_invoked.load(), std::size_t(NUM_STACKLESS_THREADS));
+    }
+
+    {
+        hpx::lcos::local::latch l(2);
+        hpx::threads::register_thread_nullary(
+            hpx::util::bind(&suspending_stackless_thread, std::ref(l)),
+            "suspending_stackless_thread", hpx::threads::pending, true,
+            hpx::threads::thread_priority_normal, std::size_t(-1),
+            hpx::threads::thread_stacksize_nostack);
+        l.count_down_and_wait();
+
+        HPX_TEST_EQ(count_suspend_failed.load(), std::size_t(1));
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=all"
+    };
+
+    HPX_TEST_EQ(hpx::init(argc, argv, cfg), 0);
+    return hpx::util::report_errors();
+}